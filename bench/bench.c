@@ -0,0 +1,498 @@
+//**************************************************************************************************
+// Host micro-benchmark of CRC, encoding and decoding kernels
+//**************************************************************************************************
+//
+// Build and run on Linux (UART driver, asserts disabled, CRC16 kernel can be selected with PKTTRANSFER_CRC16_KERNEL):
+//
+//   gcc -std=c11 -O2 -DNDEBUG -march=native -DPKTTRANSFER_OVER_UART -Iinc bench/bench.c src/drv_pkttransfer.c -o pkttransfer_bench
+//   ./pkttransfer_bench [--kernel NAME] [--profile NAME] [--min-ms N] [--repeat N] > bench.csv
+//
+// Kernels:
+//   crc16          'pkttransfer_crc16()' over payload
+//   crc32c         'pkttransfer_crc32c()' over payload
+//   encode_byte    frame sent byte-by-byte with 'tx_cb' from 'pkttransfer_task_tx()' (byte encoder)
+//   encode_frame   frame encoded at once with 'pkttransfer_encode_frame()' (block encoder)
+//   decode_byte    frame received byte-by-byte with 'rx_cb' from 'pkttransfer_task_rx()' (byte decoder)
+//   decode_block   frame received at once with 'pkttransfer_receive_bytes()' (block decoder)
+//   decode_stream  frame decoded at once with 'pkttransfer_decode_stream()'
+//
+// Escape profiles of payload:
+//   plain          no delimiters and escape symbols
+//   random         uniformly random bytes
+//   half           every other byte is delimiter or escape symbol
+//   all7e          all bytes are delimiters (worst case, frame is twice as long as payload)
+//
+// Payload sizes are 1 byte .. 64 KiB (powers of 4)
+//
+// Output is CSV, one line per kernel, profile and size:
+//   kernel,profile,payload_size,crc16_kernel,iterations,ns_per_op,bytes_per_sec,cycles_per_byte
+// Bytes are bytes of payload, cycles are time-stamp counter cycles (empty field if there is no counter)
+// Best of repeated measurements is reported, each measurement lasts at least 'min-ms' milliseconds
+//
+//**************************************************************************************************
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "drv_pkttransfer.h"
+
+#if (defined(__GNUC__)) && (defined(__x86_64__) || defined(__i386__))
+    #define RKTTRANSFER_BENCH_USE_TSC
+    #include <x86intrin.h>
+#endif
+
+#if (!defined(PKTTRANSFER_OVER_UART))
+    #error "Benchmark is built with UART driver"
+#endif
+
+//==================================================================================================
+//=========================================== MACROS ===============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Payload and buffer sizes
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_BENCH_PAYLOAD_MAX   (64 * 1024)
+#define RKTTRANSFER_BENCH_RX_BUF_SIZE   (RKTTRANSFER_BENCH_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE_MAX)
+#define RKTTRANSFER_BENCH_FRAME_MAX     (2 * (RKTTRANSFER_BENCH_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE_MAX) + 2)
+
+//-----------------------------------------------------------------------------
+// Default duration of one measurement (milliseconds) and number of measurements
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_BENCH_MIN_MS        (20)
+#define RKTTRANSFER_BENCH_REPEAT        (5)
+
+//==================================================================================================
+//========================================== TYPEDEFS ==============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Kernel - one operation over prepared payload and frame
+//-----------------------------------------------------------------------------
+typedef struct pkttransfer_bench_kernel_s {
+    const char* name;
+    void        (*op_cb)(size_t size);
+    bool        is_decoder;         // one packet is received per operation
+} pkttransfer_bench_kernel_t;
+
+//-----------------------------------------------------------------------------
+// Escape profile - fill payload of size
+//-----------------------------------------------------------------------------
+typedef struct pkttransfer_bench_profile_s {
+    const char* name;
+    void        (*fill_cb)(uint8_t* payload_p, size_t size);
+} pkttransfer_bench_profile_t;
+
+//==================================================================================================
+//================================ PRIVATE FUNCTIONS DECLARATIONS ==================================
+//==================================================================================================
+
+static void pkttransfer_bench_op_crc16(size_t size);
+static void pkttransfer_bench_op_crc32c(size_t size);
+static void pkttransfer_bench_op_encode_byte(size_t size);
+static void pkttransfer_bench_op_encode_frame(size_t size);
+static void pkttransfer_bench_op_decode_byte(size_t size);
+static void pkttransfer_bench_op_decode_block(size_t size);
+static void pkttransfer_bench_op_decode_stream(size_t size);
+
+static uint8_t pkttransfer_bench_random_byte(void);
+static void pkttransfer_bench_fill_plain(uint8_t* payload_p, size_t size);
+static void pkttransfer_bench_fill_random(uint8_t* payload_p, size_t size);
+static void pkttransfer_bench_fill_half(uint8_t* payload_p, size_t size);
+static void pkttransfer_bench_fill_all7e(uint8_t* payload_p, size_t size);
+
+static bool pkttransfer_bench_hw_tx_is_avail_cb(const void * hw_p);
+static bool pkttransfer_bench_hw_rx_is_ready_cb(const void * hw_p);
+static void pkttransfer_bench_hw_uart_tx_cb(const void * hw_p, uint8_t byte);
+static uint8_t pkttransfer_bench_hw_uart_rx_cb(const void * hw_p);
+static void pkttransfer_bench_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size);
+
+static uint64_t pkttransfer_bench_ns(void);
+static uint64_t pkttransfer_bench_cycles(void);
+static const char* pkttransfer_bench_crc16_kernel_name(void);
+static void pkttransfer_bench_run(const pkttransfer_bench_kernel_t* kernel_p, const pkttransfer_bench_profile_t* profile_p,
+                                  size_t size, uint64_t min_ns, unsigned repeat);
+
+//==================================================================================================
+//==================================== PRIVATE STATIC DATA =========================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Kernels, profiles and sizes
+//-----------------------------------------------------------------------------
+static const pkttransfer_bench_kernel_t bench_kernels[] = {
+    { "crc16",         pkttransfer_bench_op_crc16,         false },
+    { "crc32c",        pkttransfer_bench_op_crc32c,        false },
+    { "encode_byte",   pkttransfer_bench_op_encode_byte,   false },
+    { "encode_frame",  pkttransfer_bench_op_encode_frame,  false },
+    { "decode_byte",   pkttransfer_bench_op_decode_byte,   true  },
+    { "decode_block",  pkttransfer_bench_op_decode_block,  true  },
+    { "decode_stream", pkttransfer_bench_op_decode_stream, true  },
+};
+
+static const pkttransfer_bench_profile_t bench_profiles[] = {
+    { "plain",  pkttransfer_bench_fill_plain  },
+    { "random", pkttransfer_bench_fill_random },
+    { "half",   pkttransfer_bench_fill_half   },
+    { "all7e",  pkttransfer_bench_fill_all7e  },
+};
+
+static const size_t bench_sizes[] = { 1, 4, 16, 64, 256, 1024, 4096, 16384, 65536 };
+
+//-----------------------------------------------------------------------------
+// Payload, its frame and output buffers
+//-----------------------------------------------------------------------------
+static uint8_t bench_payload[RKTTRANSFER_BENCH_PAYLOAD_MAX];
+static uint8_t bench_frame[RKTTRANSFER_BENCH_FRAME_MAX];
+static size_t bench_frame_size = 0;
+static uint8_t bench_out[RKTTRANSFER_BENCH_FRAME_MAX];
+static uint32_t bench_random = 1;
+
+//-----------------------------------------------------------------------------
+// Results are accumulated, so kernels aren't optimized out
+//-----------------------------------------------------------------------------
+static volatile uint32_t bench_sink = 0;
+
+//-----------------------------------------------------------------------------
+// Driver instances - transmitter sends frame byte-by-byte into nowhere, receiver reads frame byte-by-byte
+//-----------------------------------------------------------------------------
+static pkttransfer_t bench_tx_inst;
+static pkttransfer_t bench_rx_inst;
+static uint8_t bench_tx_buf[RKTTRANSFER_BENCH_PAYLOAD_MAX];
+static uint8_t bench_rx_buf[RKTTRANSFER_BENCH_RX_BUF_SIZE];
+static uint8_t bench_rx_inst_tx_buf[RKTTRANSFER_BENCH_PAYLOAD_MAX];
+static uint8_t bench_tx_inst_rx_buf[RKTTRANSFER_BENCH_RX_BUF_SIZE];
+static size_t bench_tx_cnt = 0;
+static size_t bench_rx_idx = 0;
+static size_t bench_rx_pkts_cnt = 0;
+
+static const pkttransfer_hw_itf_t bench_hw_itf = {
+    .hw_p = NULL,
+    .tx_is_avail_cb = pkttransfer_bench_hw_tx_is_avail_cb,
+    .rx_is_ready_cb = pkttransfer_bench_hw_rx_is_ready_cb,
+    .tx_cb = pkttransfer_bench_hw_uart_tx_cb,
+    .rx_cb = pkttransfer_bench_hw_uart_rx_cb,
+};
+
+static const pkttransfer_app_itf_t bench_app_itf = {
+    .app_p = NULL,
+    .app_pkt_cb = pkttransfer_bench_app_pkt_cb,
+};
+
+//==================================================================================================
+//=============================== PRIVATE FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Kernels
+//-----------------------------------------------------------------------------
+static void pkttransfer_bench_op_crc16(size_t size)
+{
+    bench_sink ^= pkttransfer_crc16(bench_payload, size);
+}
+
+static void pkttransfer_bench_op_crc32c(size_t size)
+{
+    bench_sink ^= pkttransfer_crc32c(bench_payload, size);
+}
+
+static void pkttransfer_bench_op_encode_byte(size_t size)
+{
+    bench_tx_cnt = 0;
+    pkttransfer_err_t err = pkttransfer_send_ref(&bench_tx_inst, bench_payload, size);
+    if (err != PKTTRANSFER_ERR_OK) {
+        fprintf(stderr, "encode_byte: packet isn't accepted\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // The last call releases the packet after its last byte
+    while (bench_tx_cnt < bench_frame_size) {
+        pkttransfer_task_tx(&bench_tx_inst);
+    }
+    pkttransfer_task_tx(&bench_tx_inst);
+}
+
+static void pkttransfer_bench_op_encode_frame(size_t size)
+{
+    bench_sink ^= (uint32_t)pkttransfer_encode_frame(NULL, bench_payload, size, bench_out, sizeof(bench_out));
+}
+
+static void pkttransfer_bench_op_decode_byte(size_t size)
+{
+    (void)size;
+
+    bench_rx_idx = 0;
+    while (bench_rx_idx < bench_frame_size) {
+        pkttransfer_task_rx(&bench_rx_inst);
+    }
+}
+
+static void pkttransfer_bench_op_decode_block(size_t size)
+{
+    (void)size;
+
+    pkttransfer_receive_bytes(&bench_rx_inst, bench_frame, bench_frame_size);
+}
+
+static void pkttransfer_bench_op_decode_stream(size_t size)
+{
+    pkttransfer_frame_desc_t desc;
+    size_t descs_cnt = 0;
+
+    (void)size;
+
+    (void)pkttransfer_decode_stream(&bench_rx_inst, bench_frame, bench_frame_size, bench_out, sizeof(bench_out), &desc, 1, &descs_cnt);
+    bench_rx_pkts_cnt += descs_cnt;
+}
+
+//-----------------------------------------------------------------------------
+// Escape profiles
+//-----------------------------------------------------------------------------
+static uint8_t pkttransfer_bench_random_byte(void)
+{
+    bench_random = (bench_random * 1103515245UL) + 12345UL;
+    return (uint8_t)(bench_random >> 16);
+}
+
+static void pkttransfer_bench_fill_plain(uint8_t* payload_p, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        uint8_t byte = pkttransfer_bench_random_byte();
+        payload_p[i] = ((byte == 0x7E) || (byte == 0x7D)) ? 0x00 : byte;
+    }
+}
+
+static void pkttransfer_bench_fill_random(uint8_t* payload_p, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        payload_p[i] = pkttransfer_bench_random_byte();
+    }
+}
+
+static void pkttransfer_bench_fill_half(uint8_t* payload_p, size_t size)
+{
+    pkttransfer_bench_fill_plain(payload_p, size);
+    for (size_t i = 0; i < size; i += 2) {
+        payload_p[i] = ((i & 2) != 0) ? 0x7D : 0x7E;
+    }
+}
+
+static void pkttransfer_bench_fill_all7e(uint8_t* payload_p, size_t size)
+{
+    memset(payload_p, 0x7E, size);
+}
+
+//-----------------------------------------------------------------------------
+// Hardware callbacks - UART is always available, received bytes are taken from prepared frame
+//-----------------------------------------------------------------------------
+static bool pkttransfer_bench_hw_tx_is_avail_cb(const void * hw_p)
+{
+    (void)hw_p;
+    return true;
+}
+
+static bool pkttransfer_bench_hw_rx_is_ready_cb(const void * hw_p)
+{
+    (void)hw_p;
+    return (bench_rx_idx < bench_frame_size);
+}
+
+static void pkttransfer_bench_hw_uart_tx_cb(const void * hw_p, uint8_t byte)
+{
+    (void)hw_p;
+    bench_sink ^= byte;
+    bench_tx_cnt++;
+}
+
+static uint8_t pkttransfer_bench_hw_uart_rx_cb(const void * hw_p)
+{
+    (void)hw_p;
+    return bench_frame[bench_rx_idx++];
+}
+
+//-----------------------------------------------------------------------------
+// Application callback - count received packets
+//-----------------------------------------------------------------------------
+static void pkttransfer_bench_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size)
+{
+    (void)app_p;
+    bench_sink ^= payload_p[size - 1];
+    bench_rx_pkts_cnt++;
+}
+
+//-----------------------------------------------------------------------------
+// Monotonic time in nanoseconds
+//-----------------------------------------------------------------------------
+static uint64_t pkttransfer_bench_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------
+// Time-stamp counter (0 - there is no counter)
+//-----------------------------------------------------------------------------
+static uint64_t pkttransfer_bench_cycles(void)
+{
+#if (defined(RKTTRANSFER_BENCH_USE_TSC))
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Name of CRC16 kernel selected at build
+//-----------------------------------------------------------------------------
+static const char* pkttransfer_bench_crc16_kernel_name(void)
+{
+#if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_BITWISE)
+    return "bitwise";
+#elif (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_TABLE)
+    return "table";
+#elif (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_SLICE8)
+    return "slice8";
+#else
+    return "clmul";
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Measure kernel over payload of profile and size, print CSV line
+//
+// Number of operations is doubled until one measurement lasts 'min_ns', the best of 'repeat' measurements is reported
+//-----------------------------------------------------------------------------
+static void pkttransfer_bench_run(const pkttransfer_bench_kernel_t* kernel_p, const pkttransfer_bench_profile_t* profile_p,
+                                  size_t size, uint64_t min_ns, unsigned repeat)
+{
+    bench_random = 1;
+    profile_p->fill_cb(bench_payload, size);
+    bench_frame_size = pkttransfer_encode_frame(NULL, bench_payload, size, bench_frame, sizeof(bench_frame));
+
+    // Warm up and calibrate
+    uint64_t iterations = 1;
+    for (;;) {
+        uint64_t start_ns = pkttransfer_bench_ns();
+        for (uint64_t i = 0; i < iterations; i++) {
+            kernel_p->op_cb(size);
+        }
+        if ((pkttransfer_bench_ns() - start_ns) >= min_ns) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    uint64_t best_ns = UINT64_MAX;
+    uint64_t best_cycles = UINT64_MAX;
+    for (unsigned r = 0; r < repeat; r++) {
+        bench_rx_pkts_cnt = 0;
+        uint64_t start_cycles = pkttransfer_bench_cycles();
+        uint64_t start_ns = pkttransfer_bench_ns();
+        for (uint64_t i = 0; i < iterations; i++) {
+            kernel_p->op_cb(size);
+        }
+        uint64_t elapsed_ns = pkttransfer_bench_ns() - start_ns;
+        uint64_t elapsed_cycles = pkttransfer_bench_cycles() - start_cycles;
+
+        // Each decoding operation must produce exactly one packet
+        if ((kernel_p->is_decoder == true) && (bench_rx_pkts_cnt != iterations)) {
+            fprintf(stderr, "%s/%s/%zu: %zu packets decoded in %llu operations\n", kernel_p->name, profile_p->name, size,
+                    bench_rx_pkts_cnt, (unsigned long long)iterations);
+            exit(EXIT_FAILURE);
+        }
+
+        if (elapsed_ns < best_ns) {
+            best_ns = elapsed_ns;
+            best_cycles = elapsed_cycles;
+        }
+    }
+
+    double bytes = (double)iterations * (double)size;
+    printf("%s,%s,%zu,%s,%llu,%.1f,%.0f,", kernel_p->name, profile_p->name, size, pkttransfer_bench_crc16_kernel_name(),
+           (unsigned long long)iterations, (double)best_ns / (double)iterations, bytes * 1e9 / (double)best_ns);
+#if (defined(RKTTRANSFER_BENCH_USE_TSC))
+    printf("%.3f\n", (double)best_cycles / bytes);
+#else
+    (void)best_cycles;
+    printf("\n");
+#endif
+    fflush(stdout);
+}
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Run benchmark
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    const char* kernel_name = NULL;
+    const char* profile_name = NULL;
+    uint64_t min_ms = RKTTRANSFER_BENCH_MIN_MS;
+    unsigned repeat = RKTTRANSFER_BENCH_REPEAT;
+
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--kernel") == 0) && (i + 1 < argc)) {
+            kernel_name = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--profile") == 0) && (i + 1 < argc)) {
+            profile_name = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--min-ms") == 0) && (i + 1 < argc)) {
+            min_ms = strtoull(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "--repeat") == 0) && (i + 1 < argc)) {
+            repeat = (unsigned)strtoul(argv[++i], NULL, 10);
+        }
+        else {
+            fprintf(stderr, "usage: %s [--kernel NAME] [--profile NAME] [--min-ms N] [--repeat N]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (repeat == 0) {
+        repeat = 1;
+    }
+
+    pkttransfer_config_t tx_config = {
+        .payload_size_max = RKTTRANSFER_BENCH_PAYLOAD_MAX,
+        .buf_tx_p = bench_tx_buf,
+        .buf_rx_p = bench_tx_inst_rx_buf,
+    };
+    pkttransfer_config_t rx_config = {
+        .payload_size_max = RKTTRANSFER_BENCH_PAYLOAD_MAX,
+        .buf_tx_p = bench_rx_inst_tx_buf,
+        .buf_rx_p = bench_rx_buf,
+    };
+    pkttransfer_init(&bench_tx_inst, &bench_hw_itf, &bench_app_itf, &tx_config);
+    pkttransfer_init(&bench_rx_inst, &bench_hw_itf, &bench_app_itf, &rx_config);
+
+    printf("kernel,profile,payload_size,crc16_kernel,iterations,ns_per_op,bytes_per_sec,cycles_per_byte\n");
+
+    for (size_t k = 0; k < sizeof(bench_kernels) / sizeof(bench_kernels[0]); k++) {
+        if ((kernel_name != NULL) && (strcmp(kernel_name, bench_kernels[k].name) != 0)) {
+            continue;
+        }
+        for (size_t p = 0; p < sizeof(bench_profiles) / sizeof(bench_profiles[0]); p++) {
+            if ((profile_name != NULL) && (strcmp(profile_name, bench_profiles[p].name) != 0)) {
+                continue;
+            }
+            for (size_t s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]); s++) {
+                pkttransfer_bench_run(&bench_kernels[k], &bench_profiles[p], bench_sizes[s], min_ms * 1000000ULL, repeat);
+            }
+        }
+    }
+
+    pkttransfer_deinit(&bench_tx_inst);
+    pkttransfer_deinit(&bench_rx_inst);
+
+    return EXIT_SUCCESS;
+}
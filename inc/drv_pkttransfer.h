@@ -16,6 +16,10 @@
 //  - low level CAN sending:     send all bytes of frame within series of CAN messages (CAN ID should be passed from application)
 //  - low level CAN receiving:   receive series of CAN messages and (required CAN ID should be passed from application)
 //
+//  - alternative CAN transport: ISO-TP (ISO 15765-2) single/first/consecutive frames with length header and flow control,
+//                               without delimiters and byte-stuffing, CRC is optional
+//                               ('pkttransfer_config_t.can_transport')
+//
 //**************************************************************************************************
 //
 // Driver has two interfaces:
@@ -34,7 +38,9 @@
 //
 // Driver can be used in the multithreading environment
 //  - all functions are reenterable
-//  - driver doesn't use neither internal static data nor memory allocation
+//  - packets can be sent from several threads at once without locks while one thread calls task
+//  - driver doesn't use memory allocation, the only internal static data are CRC kernel
+//    pointers resolved once by CPU features
 //  - driver instance and all packet buffers are supposed to be stored externally
 //
 // Error handling:
@@ -49,6 +55,12 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef __cplusplus
+    #include <atomic>
+#else
+    #include <stdatomic.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -59,8 +71,14 @@ extern "C" {
 
 //-----------------------------------------------------------------------------
 // Size of payload in CAN message
+//
+// Classic CAN - 8 bytes (default), CAN FD - 8, 12, 16, 20, 24, 32, 48 or 64 bytes ('pkttransfer_config_t.can_msg_size')
+// CAN FD message shorter than 8 bytes or of valid DLC length is sent as is, otherwise it's padded up to the next
+// valid DLC length with padding bytes (padding is always after the end of frame, receiver skips it)
 //-----------------------------------------------------------------------------
-#define PKTTRANSFER_CAN_MGS_SIZE (8)
+#define PKTTRANSFER_CAN_MGS_SIZE        (8)
+#define PKTTRANSFER_CAN_FD_MGS_SIZE_MAX (64)
+#define PKTTRANSFER_CAN_FD_PADDING_BYTE (0xCC)
 
 //-----------------------------------------------------------------------------
 // Base error code for driver's errors
@@ -72,8 +90,64 @@ extern "C" {
 
 //-----------------------------------------------------------------------------
 // Frame CRC
+// Default CRC is CRC16, any CRC engine can be passed in 'pkttransfer_config_t'
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_FRAME_CRC_SIZE      (2)     // size of default CRC16
+#define PKTTRANSFER_FRAME_CRC_SIZE_MAX  (4)     // maximum size of CRC of any engine
+
+//-----------------------------------------------------------------------------
+// Maximum number of RX buffers in driver's pool of loaned buffers
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_RX_POOL_CNT_MAX (32)
+
+//-----------------------------------------------------------------------------
+// Maximum number of driver instances in one group ('pkttransfer_group_t')
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_GROUP_INST_CNT_MAX (32)
+
+//-----------------------------------------------------------------------------
+// Size of cache line - transmitting and receiving halves of driver state and fields changed by application
+// on RX release are aligned to it, so 'pkttransfer_task_tx()', 'pkttransfer_task_rx()' and consumer of received
+// packets can run on different cores without false sharing
+// Can be redefined for target (e.g. 32 for Cortex-M7), instances allocated dynamically should be aligned to it too
+//-----------------------------------------------------------------------------
+#ifndef PKTTRANSFER_CACHELINE_SIZE
+#define PKTTRANSFER_CACHELINE_SIZE (64)
+#endif
+
+//-----------------------------------------------------------------------------
+// Alignment of member for both C and C++ sources including this header
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+    #define PKTTRANSFER_ALIGNAS(size) alignas(size)
+#else
+    #define PKTTRANSFER_ALIGNAS(size) _Alignas(size)
+#endif
+
+//-----------------------------------------------------------------------------
+// Maximum number of slots in TX queue (positions of slots are counted within 32 bits)
 //-----------------------------------------------------------------------------
-#define PKTTRANSFER_FRAME_CRC_SIZE (2)
+#define PKTTRANSFER_TX_SLOTS_CNT_MAX (0x10000000UL)
+
+//-----------------------------------------------------------------------------
+// CRC16 calculation kernel (all kernels produce the same result)
+//
+//  - BITWISE - bit-by-bit calculation, no tables, slowest
+//  - TABLE   - byte-by-byte calculation with 256-entry table (512 bytes of flash)
+//  - SLICE8  - 8 bytes per iteration with 8 tables of 256 entries (4 KBytes of flash)
+//  - CLMUL   - carry-less multiplication folding (PCLMULQDQ on x86), selected in runtime
+//              if CPU supports it, otherwise SLICE8 is used
+//
+// Can be redefined from compiler's command line
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_CRC16_KERNEL_BITWISE    (0)
+#define PKTTRANSFER_CRC16_KERNEL_TABLE      (1)
+#define PKTTRANSFER_CRC16_KERNEL_SLICE8     (2)
+#define PKTTRANSFER_CRC16_KERNEL_CLMUL      (3)
+
+#ifndef PKTTRANSFER_CRC16_KERNEL
+    #define PKTTRANSFER_CRC16_KERNEL PKTTRANSFER_CRC16_KERNEL_TABLE
+#endif
 
 //-----------------------------------------------------------------------------
 // Sanitizing
@@ -86,6 +160,20 @@ extern "C" {
     #error "Error code and OK code must be different"
 #endif
 
+#if ((PKTTRANSFER_CRC16_KERNEL < PKTTRANSFER_CRC16_KERNEL_BITWISE) || (PKTTRANSFER_CRC16_KERNEL > PKTTRANSFER_CRC16_KERNEL_CLMUL))
+    #error "Unknown CRC16 kernel"
+#endif
+
+//-----------------------------------------------------------------------------
+// Atomic type of values shared with interrupts and another threads,
+// 'std::atomic' for C++ sources including this header (same size and representation as '_Atomic')
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+    #define PKTTRANSFER_ATOMIC(type) std::atomic<type>
+#else
+    #define PKTTRANSFER_ATOMIC(type) _Atomic(type)
+#endif
+
 //==================================================================================================
 //========================================== TYPEDEFS ==============================================
 //==================================================================================================
@@ -104,8 +192,22 @@ typedef enum pkttransfer_err_enum_e {
     // Block of driver's errors
     PKTTRANSFER_ERR_BASE = PKTTRANSFER_ERR_CODE_BASE,
     PKTTRANSFER_ERR_TX_OVF,     // Internal TX buffer overflow
+    PKTTRANSFER_ERR_IO,         // I/O error of host backend ('errno' is set)
 } pkttransfer_err_enum_t;
 
+//------------------------------------------------------------------------------
+// Segment of payload
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_seg_s {
+    const uint8_t* data_p;          // pointer to data of segment
+    size_t      size;               // size of segment (can be 0)
+} pkttransfer_seg_t;
+
+//------------------------------------------------------------------------------
+// Value shared between driver's task and interrupts or another threads
+//------------------------------------------------------------------------------
+typedef PKTTRANSFER_ATOMIC(uint32_t) pkttransfer_atomic_t;
+
 //------------------------------------------------------------------------------
 // Frame sending/receiving state
 // Integer is used instead of enum in order to determine size of value
@@ -118,6 +220,19 @@ typedef enum pkttransfer_frame_state_enum_e {
     PKTTRANSFER_STATE_ENCODED_BYTE,
 } pkttransfer_frame_state_enum_t;
 
+#if (defined(PKTTRANSFER_OVER_CAN))
+//------------------------------------------------------------------------------
+// Transport of packets over CAN
+// Integer is used instead of enum in order to determine size of value
+//------------------------------------------------------------------------------
+typedef int32_t pkttransfer_can_transport_t;
+
+typedef enum pkttransfer_can_transport_enum_e {
+    PKTTRANSFER_CAN_TRANSPORT_FRAMES = 0,   // frames with delimiters, byte-stuffing and CRC split into CAN messages (default)
+    PKTTRANSFER_CAN_TRANSPORT_ISOTP,        // ISO-TP (ISO 15765-2) messages with length header and flow control, optional CRC
+} pkttransfer_can_transport_enum_t;
+#endif
+
 
 //------------------------------------------------------------------------------
 // Check if it's possible to send bytes to UART/CAN (or pass them into send buffer of the UART/CAN driver)
@@ -150,6 +265,28 @@ typedef void (*pkttransfer_hw_uart_tx_cb_t)(const void * hw_p, uint8_t byte);
 //------------------------------------------------------------------------------
 typedef uint8_t (*pkttransfer_hw_uart_rx_cb_t)(const void * hw_p);
 
+//------------------------------------------------------------------------------
+// Start sending of data chunk over UART DMA (optional, for DMA mode)
+//
+// Application must call 'pkttransfer_tx_dma_complete()' when chunk is sent
+// Chunk is not changed by driver until it's sent
+//
+// 'hw_p'   - pointer to hardware driver instance, passed over 'pkttransfer_hw_itf_t' structure (can be NULL)
+// 'data_p' - pointer to data chunk to be sent
+// 'size'   - size of data chunk (guaranteed - 1 .. 'pkttransfer_config_t.tx_dma_chunk_size')
+//------------------------------------------------------------------------------
+typedef void (*pkttransfer_hw_uart_tx_dma_start_cb_t)(const void * hw_p, const uint8_t* data_p, size_t size);
+
+//------------------------------------------------------------------------------
+// Indicate that encoded bytes are added into TX ring (optional, for interrupt mode)
+//
+// Called by task after bytes are added, e.g. to enable UART TX-empty interrupt which calls 'pkttransfer_isr_tx_pull()'
+// Can be called while interrupt is already enabled
+//
+// 'hw_p'   - pointer to hardware driver instance, passed over 'pkttransfer_hw_itf_t' structure (can be NULL)
+//------------------------------------------------------------------------------
+typedef void (*pkttransfer_hw_uart_tx_kick_cb_t)(const void * hw_p);
+
 #elif (defined(PKTTRANSFER_OVER_CAN))
 
 //------------------------------------------------------------------------------
@@ -157,7 +294,7 @@ typedef uint8_t (*pkttransfer_hw_uart_rx_cb_t)(const void * hw_p);
 //
 // 'hw_p'   - pointer to hardware driver instance, passed over 'pkttransfer_hw_itf_t' structure (can be NULL)
 // 'data_p' - pointer to data to be sent
-// 'size'   - size of data (guaranteed - not more than PKTTRANSFER_CAN_MGS_SIZE)
+// 'size'   - size of data (guaranteed - not more than 'pkttransfer_config_t.can_msg_size', valid CAN FD DLC length if more than 8)
 // 'can_id' - ID to be sent in the CAN message
 //------------------------------------------------------------------------------
 typedef void (*pkttransfer_hw_can_tx_cb_t)(const void * hw_p, const uint8_t* data_p, size_t size, uint32_t can_id_tx);
@@ -169,21 +306,118 @@ typedef void (*pkttransfer_hw_can_tx_cb_t)(const void * hw_p, const uint8_t* dat
 // 'data_out_p'     - pointer to output received data
 // 'can_id'         - required ID of received CAN message
 //
-// Returns - number of bytes copied into output buffer (not more than PKTTRANSFER_CAN_MGS_SIZE)
+// Returns - number of bytes copied into output buffer (not more than 'pkttransfer_config_t.can_msg_size')
 //------------------------------------------------------------------------------
 typedef size_t (*pkttransfer_hw_can_rx_cb_t)(const void * hw_p, uint8_t* data_out_p, uint32_t can_id_rx);
 
+//------------------------------------------------------------------------------
+// Get received bytes from CAN message of any ID (to be demultiplexed into RX channels)
+//
+// 'hw_p'           - pointer to hardware driver instance, passed over 'pkttransfer_hw_itf_t' structure (can be NULL)
+// 'data_out_p'     - pointer to output received data
+// 'can_id_out_p'   - pointer to output ID of received CAN message
+//
+// Returns - number of bytes copied into output buffer (not more than 'pkttransfer_config_t.can_msg_size')
+//------------------------------------------------------------------------------
+typedef size_t (*pkttransfer_hw_can_rx_any_cb_t)(const void * hw_p, uint8_t* data_out_p, uint32_t* can_id_out_p);
+
 #endif
 
 //------------------------------------------------------------------------------
 // Pass received packet to application
 //
+// Payload is valid only within callback, except loaned RX buffers - they are owned by application
+// until 'pkttransfer_rx_release()' (driver's pool) or forever ('pkttransfer_app_itf_t.app_rx_buf_get_cb')
+//
 // 'app_p'      - pointer to application instance, passed over 'pkttransfer_app_itf_t' structure (can be NULL)
 // 'payload_p'  - pointer to received payload
-// 'size'       - size of received payload (guaranteed - 1 .. 'pkttransfer_config_t.pkt_len_max')
+// 'size'       - size of received payload (guaranteed - 1 .. 'pkttransfer_config_t.payload_size_max')
 //------------------------------------------------------------------------------
 typedef void (*pkttransfer_app_pkt_cb_t)(const void * app_p, const uint8_t* payload_p, size_t size);
 
+#if (defined(PKTTRANSFER_OVER_CAN))
+//------------------------------------------------------------------------------
+// Pass packet received over RX channel to application
+//
+// The same as 'pkttransfer_app_pkt_cb_t', but with ID of CAN messages of the channel
+//
+// 'can_id_rx'  - ID of CAN messages of RX channel
+//------------------------------------------------------------------------------
+typedef void (*pkttransfer_app_channel_pkt_cb_t)(const void * app_p, uint32_t can_id_rx, const uint8_t* payload_p, size_t size);
+#endif
+
+//------------------------------------------------------------------------------
+// Get empty buffer from application to receive the next frame into it (loaned RX buffers)
+//
+// Buffer is owned by driver until it's passed to 'pkttransfer_app_pkt_cb_t', after that it's owned by application
+//
+// 'app_p'      - pointer to application instance, passed over 'pkttransfer_app_itf_t' structure (can be NULL)
+//
+// Returns - pointer to buffer of ('pkttransfer_config_t.payload_size_max' + size of CRC) bytes, NULL if there is no free buffer
+//------------------------------------------------------------------------------
+typedef uint8_t* (*pkttransfer_app_rx_buf_get_cb_t)(const void * app_p);
+
+//------------------------------------------------------------------------------
+// Notify application that packet passed to 'pkttransfer_send_ref()' is encoded and its buffer can be reused
+//
+// 'app_p'      - pointer to application instance, passed over 'pkttransfer_app_itf_t' structure (can be NULL)
+// 'payload_p'  - pointer to payload buffer passed to 'pkttransfer_send_ref()'
+// 'size'       - size of payload
+//------------------------------------------------------------------------------
+typedef void (*pkttransfer_app_tx_done_cb_t)(const void * app_p, const uint8_t* payload_p, size_t size);
+
+//------------------------------------------------------------------------------
+// Notify application that packet passed to 'pkttransfer_sendv()' is encoded and its segments can be reused
+//
+// 'app_p'      - pointer to application instance, passed over 'pkttransfer_app_itf_t' structure (can be NULL)
+// 'segs_p'     - pointer to array of segments passed to 'pkttransfer_sendv()'
+// 'segs_cnt'   - number of segments
+//------------------------------------------------------------------------------
+typedef void (*pkttransfer_app_txv_done_cb_t)(const void * app_p, const pkttransfer_seg_t* segs_p, size_t segs_cnt);
+
+//------------------------------------------------------------------------------
+// Get initial value of CRC register
+//
+// 'crc_p'      - pointer to CRC engine instance, passed over 'pkttransfer_crc_itf_t' structure (can be NULL)
+//------------------------------------------------------------------------------
+typedef uint32_t (*pkttransfer_crc_init_cb_t)(const void * crc_p);
+
+//------------------------------------------------------------------------------
+// Update CRC register with data
+//
+// Engine must not keep the register internally - the same engine is used to send and to receive frames
+// (hardware CRC unit should be reloaded with 'crc' value before processing)
+//
+// 'crc_p'      - pointer to CRC engine instance, passed over 'pkttransfer_crc_itf_t' structure (can be NULL)
+// 'crc'        - current value of CRC register
+// 'data_p'     - pointer to data
+// 'size'       - size of data (can be 1 byte)
+//
+// Returns - updated value of CRC register
+//------------------------------------------------------------------------------
+typedef uint32_t (*pkttransfer_crc_update_cb_t)(const void * crc_p, uint32_t crc, const uint8_t* data_p, size_t size);
+
+//------------------------------------------------------------------------------
+// Get final CRC value from CRC register
+//
+// 'crc_p'      - pointer to CRC engine instance, passed over 'pkttransfer_crc_itf_t' structure (can be NULL)
+// 'crc'        - current value of CRC register
+//
+// Returns - CRC value to be sent after payload, LSB first
+//------------------------------------------------------------------------------
+typedef uint32_t (*pkttransfer_crc_final_cb_t)(const void * crc_p, uint32_t crc);
+
+//------------------------------------------------------------------------------
+// Interface to CRC engine (software or hardware CRC unit)
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_crc_itf_s {
+    void*                               crc_p;              // Pointer to CRC engine instance to be passed into callbacks (can be NULL)
+    pkttransfer_crc_init_cb_t           init_cb;            // Get initial value of CRC register
+    pkttransfer_crc_update_cb_t         update_cb;          // Update CRC register with data
+    pkttransfer_crc_final_cb_t          final_cb;           // Get final CRC value
+    size_t                              size;               // Size of CRC in frame (1 .. PKTTRANSFER_FRAME_CRC_SIZE_MAX)
+} pkttransfer_crc_itf_t;
+
 //------------------------------------------------------------------------------
 // Interface to hardware level (callbacks to hardware layer)
 //------------------------------------------------------------------------------
@@ -196,9 +430,12 @@ typedef struct pkttransfer_hw_itf_s {
 #if (defined(PKTTRANSFER_OVER_UART))
     pkttransfer_hw_uart_tx_cb_t            tx_cb;              // Start data sending
     pkttransfer_hw_uart_rx_cb_t            rx_cb;              // Read received data
+    pkttransfer_hw_uart_tx_dma_start_cb_t  tx_dma_start_cb;    // Start DMA sending (NULL - bytes are sent one-by-one with 'tx_cb')
+    pkttransfer_hw_uart_tx_kick_cb_t       tx_kick_cb;         // Bytes are added into TX ring (only for interrupt mode, can be NULL)
 #elif (defined(PKTTRANSFER_OVER_CAN))
     pkttransfer_hw_can_tx_cb_t             tx_cb;              // Start data sending
     pkttransfer_hw_can_rx_cb_t             rx_cb;              // Read received packet
+    pkttransfer_hw_can_rx_any_cb_t         rx_any_cb;          // Read received packet of any ID (only with RX channels)
 #endif
 
 } pkttransfer_hw_itf_t;
@@ -208,16 +445,104 @@ typedef struct pkttransfer_hw_itf_s {
 //------------------------------------------------------------------------------
 typedef struct pkttransfer_app_itf_s {
     void*                               app_p;               // Pointer to application instance to be passed into callbacks (can be NULL)
-    pkttransfer_app_pkt_cb_t            app_pkt_cb;          // Pass received packet to application
+    pkttransfer_app_pkt_cb_t            app_pkt_cb;          // Pass received packet to application (not used with deferred delivery)
+    pkttransfer_app_tx_done_cb_t        app_tx_done_cb;      // Release buffer of packet sent by reference (can be NULL)
+    pkttransfer_app_txv_done_cb_t       app_txv_done_cb;     // Release segments of packet sent by 'pkttransfer_sendv()' (can be NULL)
+    pkttransfer_app_rx_buf_get_cb_t     app_rx_buf_get_cb;   // Get empty RX buffer (NULL - 'buf_rx_p' or driver's pool of RX buffers is used)
+#if (defined(PKTTRANSFER_OVER_CAN))
+    pkttransfer_app_channel_pkt_cb_t    app_channel_pkt_cb;  // Pass packet received over RX channel to application (NULL - 'app_pkt_cb' is called)
+#endif
 } pkttransfer_app_itf_t;
 
+#if (defined(PKTTRANSFER_OVER_CAN))
+//------------------------------------------------------------------------------
+// RX channel - reassembly context for CAN messages of one ID
+//
+// 'can_id' and 'buf_p' are set by application, the rest is managed by driver
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_rx_channel_s {
+    uint32_t    can_id;             // ID of CAN messages of channel (unique within instance)
+    uint8_t*    buf_p;              // rx bufer for one payload (payload_size_max + size of CRC) bytes
+
+    pkttransfer_frame_state_t rx_state; // current state of receiving
+    size_t      rx_size;            // size of data in rx buffer
+    uint32_t    rx_crc;             // CRC register for received bytes
+    uint32_t    received_packets_cnt; // counter for successfully received packets
+} pkttransfer_rx_channel_t;
+#endif
+
+//------------------------------------------------------------------------------
+// Descriptor of payload decoded by 'pkttransfer_decode_stream()'
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_frame_desc_s {
+    size_t      offset;             // offset of payload in output buffer
+    size_t      size;               // size of payload
+} pkttransfer_frame_desc_t;
+
+//------------------------------------------------------------------------------
+// Descriptor of packet in TX queue
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_tx_slot_s {
+    pkttransfer_seg_t seg;          // payload - in TX pool or in application's buffer ('pkttransfer_send_ref()')
+    const pkttransfer_seg_t* segs_p; // segments of payload - 'seg' or application's segments ('pkttransfer_sendv()')
+    size_t      segs_cnt;           // number of segments
+    size_t      size;               // size of payload (all segments)
+    bool        is_ref;             // payload is in application's buffers
+#if (defined(PKTTRANSFER_OVER_CAN))
+    uint32_t    can_id_tx;          // ID of CAN messages
+#endif
+    pkttransfer_atomic_t seq;       // position of slot in TX queue: free for reserving, ready for sending or released (set by driver)
+} pkttransfer_tx_slot_t;
+
+//------------------------------------------------------------------------------
+// Descriptor of received packet in deferred delivery ring
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_rx_slot_s {
+    uint8_t*    data_p;             // payload - in delivery pool (set by driver)
+    size_t      size;               // size of payload (set by driver)
+} pkttransfer_rx_slot_t;
+
 //------------------------------------------------------------------------------
 // Driver configuration
 //------------------------------------------------------------------------------
 typedef struct pkttransfer_config_s {
     size_t      payload_size_max;   // maximum size of payload
-    uint8_t*    buf_rx_p;           // rx bufer for one payload (payload_size_max + PKTTRANSFER_FRAME_CRC_SIZE) bytes
-    uint8_t*    buf_tx_p;           // tx bufer for one payload (payload_size_max + PKTTRANSFER_FRAME_CRC_SIZE) bytes
+    uint8_t*    buf_rx_p;           // rx bufer for one payload (payload_size_max + size of CRC) bytes, not used with loaned RX buffers
+    uint8_t*    buf_tx_p;           // tx bufer for one payload (payload_size_max) bytes
+    const pkttransfer_crc_itf_t* crc_itf_p; // CRC engine (NULL - default CRC16, or 'pkttransfer_crc32c_itf', or application's engine)
+
+    pkttransfer_tx_slot_t* tx_slots_p;  // descriptors of TX queue slots (tx_slots_cnt items), NULL - only one packet in 'buf_tx_p'
+    uint8_t*    tx_pool_p;          // payloads of TX queue slots (tx_slots_cnt * payload_size_max) bytes, 'buf_tx_p' isn't used
+    size_t      tx_slots_cnt;       // number of TX queue slots
+
+    uint8_t*    rx_pool_p;          // loaned RX buffers (rx_pool_cnt * (payload_size_max + size of CRC)) bytes, NULL - not used
+    size_t      rx_pool_cnt;        // number of loaned RX buffers (1 .. PKTTRANSFER_RX_POOL_CNT_MAX)
+
+    pkttransfer_rx_slot_t* rx_slots_p;  // deferred delivery ring (rx_slots_cnt items) read with 'pkttransfer_poll_packet()', NULL - 'app_pkt_cb' is called by task
+    uint8_t*    rx_slots_pool_p;    // payloads of delivery ring (rx_slots_cnt * (payload_size_max + size of CRC)) bytes, frames are received directly into them
+    size_t      rx_slots_cnt;       // number of slots in delivery ring (power of two)
+
+#if (defined(PKTTRANSFER_OVER_UART))
+    uint8_t*    tx_dma_buf_p;       // buffer for two DMA chunks (2 * tx_dma_chunk_size) bytes, only for DMA mode
+    size_t      tx_dma_chunk_size;  // size of one DMA chunk, only for DMA mode
+    const uint8_t* rx_dma_buf_p;    // circular buffer filled by UART DMA (NULL - bytes are received one-by-one with 'rx_cb')
+    size_t      rx_dma_buf_size;    // size of circular DMA buffer
+    uint8_t*    isr_rx_ring_p;      // ring filled from interrupt with 'pkttransfer_isr_rx_push()' (NULL - bytes are received with 'rx_cb')
+    size_t      isr_rx_ring_size;   // size of RX ring (power of two)
+    uint8_t*    isr_tx_ring_p;      // ring of encoded bytes drained from interrupt with 'pkttransfer_isr_tx_pull()' (NULL - bytes are sent with 'tx_cb')
+    size_t      isr_tx_ring_size;   // size of TX ring (power of two)
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    size_t      can_msg_size;       // maximum size of CAN message: 0 - PKTTRANSFER_CAN_MGS_SIZE, or CAN FD DLC length up to PKTTRANSFER_CAN_FD_MGS_SIZE_MAX
+    size_t      can_tx_msgs_per_task; // maximum number of CAN messages sent per task call while 'tx_is_avail_cb' is true (0 - one message)
+    size_t      can_rx_msgs_per_task; // maximum number of CAN messages received per task call while 'rx_is_ready_cb' is true (0 - one message)
+    pkttransfer_rx_channel_t* rx_channels_p; // RX channels (sorted by ID by driver), NULL - messages of 'can_id_rx' are received into 'buf_rx_p'
+    size_t      rx_channels_cnt;    // number of RX channels
+
+    pkttransfer_can_transport_t can_transport; // PKTTRANSFER_CAN_TRANSPORT_FRAMES (default) or PKTTRANSFER_CAN_TRANSPORT_ISOTP
+    bool        can_isotp_crc;      // ISO-TP - CRC is appended to payload inside of ISO-TP message (CAN checks each message only)
+    uint8_t     can_isotp_block_size; // ISO-TP - number of consecutive frames between flow control frames sent by receiver (0 - no limit)
+    uint32_t    can_isotp_id_fc;    // ISO-TP - ID of flow control CAN messages sent by receiver (usually ID of packets sent by instance)
+#endif
 } pkttransfer_config_t;
 
 //------------------------------------------------------------------------------
@@ -225,24 +550,113 @@ typedef struct pkttransfer_config_s {
 //------------------------------------------------------------------------------
 typedef struct pkttransfer_state_s {
 
+    // ---- transmitting half, changed by 'pkttransfer_task_tx()' and by senders (starts on its own cache line) ----
+
     // transmitting state
+    PKTTRANSFER_ALIGNAS(PKTTRANSFER_CACHELINE_SIZE)
     pkttransfer_frame_state_t tx_state; // current state of receiving
-    size_t      tx_size;                // size of data in tx buffer
-    size_t      sent_size;              // size of already sent data from tx buffer
+    const uint8_t* tx_payload_p;        // segment of payload being sent
+    size_t      tx_seg_start;           // offset of segment being sent in payload
+    size_t      tx_seg_end;             // offset of the end of segment being sent in payload
+    size_t      tx_seg_idx;             // index of the next segment to be sent
+    size_t      tx_size;                // size of data to be sent (payload and CRC)
+    size_t      sent_size;              // size of already sent data (payload and CRC)
+    uint32_t    tx_crc;                 // CRC register for already sent payload bytes
+    uint8_t     tx_crc_buf[PKTTRANSFER_FRAME_CRC_SIZE_MAX]; // CRC to be sent after payload
+
+    // TX queue (multiple senders, task is the only consumer), positions are counted modulo 'tx_queue_wrap'
+    pkttransfer_atomic_t tx_queue_enq;  // position of the next slot to be reserved by senders
+    pkttransfer_atomic_t tx_queue_deq;  // position of slot being sent by task
+    pkttransfer_atomic_t tx_queue_hwm;  // maximum number of packets in queue (high-water mark)
+    uint32_t    tx_queue_wrap;          // range of positions (multiple of number of slots)
+    pkttransfer_tx_slot_t tx_slot_single; // slot for single packet in 'buf_tx_p' if queue isn't configured
+
+#if (defined(PKTTRANSFER_OVER_UART))
+    // DMA sending
+    pkttransfer_atomic_t tx_dma_flags;  // states of DMA chunks and index of chunk to be sent next
+    size_t      tx_dma_chunk_fill[2];   // size of data in DMA chunks
+    size_t      tx_dma_fill_idx;        // index of DMA chunk to be filled next
+
+    // Interrupt TX ring (single producer, single consumer), positions are free-running counters
+    pkttransfer_atomic_t isr_tx_head;   // position of the next byte to be prepared by task
+    pkttransfer_atomic_t isr_tx_tail;   // position of the next byte to be pulled by interrupt
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    uint32_t    can_id_tx;              // ID of CAN message to be sent
+
+    // ISO-TP sending
+    uint8_t     isotp_tx_sn;            // sequence number of the next consecutive frame to be sent
+    bool        isotp_tx_wait_fc;       // sending is paused until flow control frame is received
+    size_t      isotp_tx_block_left;    // consecutive frames to be sent until the next flow control (0 - no limit)
+    uint32_t    isotp_tx_abort_cnt;     // counter for sent packets aborted by receiver (overflow flow status)
+
+    // ISO-TP mailboxes (written by 'pkttransfer_task_rx()', taken by 'pkttransfer_task_tx()'), 0 - empty
+    pkttransfer_atomic_t isotp_fc_out;  // flow control frame to be sent before the next message
+    pkttransfer_atomic_t isotp_fc_in;   // received flow control which resumes or aborts sending
+#endif
+
+    // info
+    uint32_t    sent_packets_cnt;       // counter for successfully sent packets
+
+    // ---- receiving half, changed by 'pkttransfer_task_rx()' (starts on its own cache line) ----
 
     // receiving state
+    PKTTRANSFER_ALIGNAS(PKTTRANSFER_CACHELINE_SIZE)
     pkttransfer_frame_state_t rx_state; // current state of receiving
+    uint8_t*    rx_buf_p;               // buffer for frame being received (NULL - there is no free loaned buffer)
+    bool        rx_loan;                // received buffers are loaned to application
     size_t      rx_size;                // size of data in rx buffer
+    uint32_t    rx_crc;                 // CRC register for received bytes (except the last bytes which can be CRC)
+    struct pkttransfer_stream_s* rx_stream_p; // output of 'pkttransfer_decode_stream()' being called, NULL - payloads are passed to application callback
+
+    // Deferred delivery ring (task is producer, application is consumer), positions are free-running counters
+    pkttransfer_atomic_t rx_slots_head; // position of the next slot to be filled by task
+    uint32_t    rx_slots_hwm;           // maximum number of packets in ring (high-water mark)
+
+#if (defined(PKTTRANSFER_OVER_UART))
+    // DMA receiving
+    pkttransfer_atomic_t rx_dma_head;   // index in circular DMA buffer of the next byte to be written by DMA
+    size_t      rx_dma_tail;            // index in circular DMA buffer of the next byte to be processed
+
+    // Interrupt RX ring (single producer, single consumer), positions are free-running counters
+    pkttransfer_atomic_t isr_rx_head;   // position of the next byte to be pushed by interrupt
+    pkttransfer_atomic_t isr_rx_tail;   // position of the next byte to be processed by task
+    pkttransfer_atomic_t isr_rx_ovf_cnt; // counter for received bytes dropped because RX ring was full
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    uint32_t    can_id_rx;              // ID of CAN message to be received
+    pkttransfer_rx_channel_t* rx_channel_p; // RX channel being processed
+    uint32_t    rx_unknown_id_cnt;      // counter for received CAN messages of ID without RX channel
+
+    // ISO-TP receiving
+    size_t      isotp_rx_len;           // size of message being received (payload and CRC)
+    uint8_t     isotp_rx_sn;            // sequence number of the next consecutive frame to be received
+    size_t      isotp_rx_block_left;    // consecutive frames to be received until the next flow control (0 - no limit)
+    uint32_t    isotp_rx_err_cnt;       // counter for dropped ISO-TP messages (wrong length or sequence number, interrupted message)
+#endif
 
     // info
     uint32_t    sof_detections_cnt;     // counter for received of start-of-frame delimiters
     uint32_t    received_packets_cnt;   // counter for successfully received packets
-    uint32_t    sent_packets_cnt;       // counter for successfully sent packets
+    uint32_t    rx_no_buf_cnt;          // counter for frames dropped because there was no free loaned RX buffer (or delivery ring was full)
 
-#if (defined(PKTTRANSFER_OVER_CAN))
-    uint32_t    can_id_rx;              // ID of CAN message to be received
-    uint32_t    can_id_tx;              // ID of CAN message to be sent
-#endif
+    // ---- changed by application with 'pkttransfer_poll_packet()' and 'pkttransfer_rx_release()' (starts on its own cache line) ----
+
+    // loaned RX buffers returned by application
+    PKTTRANSFER_ALIGNAS(PKTTRANSFER_CACHELINE_SIZE)
+    pkttransfer_atomic_t rx_pool_free;  // bitmask of free buffers in driver's pool of RX buffers (taken by task)
+
+    // deferred delivery ring consumed by application
+    pkttransfer_atomic_t rx_slots_tail; // position of the next slot to be released by application
+    uint32_t    rx_slots_poll;          // position of the next slot to be polled by application (changed by application only)
+
+    // ---- set at initialization, read by both halves (starts on its own cache line) ----
+
+    // CRC
+    PKTTRANSFER_ALIGNAS(PKTTRANSFER_CACHELINE_SIZE)
+    size_t      crc_size;               // size of CRC in frame
+
+    // group
+    struct pkttransfer_group_s* group_p; // group of instance, NULL - instance isn't in group
+    uint32_t    group_bit;              // bit of instance in readiness bitmasks of group
 
 } pkttransfer_state_t;
 
@@ -256,6 +670,34 @@ typedef struct pkttransfer_s {
     pkttransfer_state_t     state;
 } pkttransfer_t;
 
+//------------------------------------------------------------------------------
+// Group of driver instances served by one task ('pkttransfer_group_task()')
+//
+// Readiness bits are set by driver (packet is sent, UART DMA is notified, ISO-TP flow control is received) and by application
+// ('pkttransfer_rx_notify()' and 'pkttransfer_tx_notify()' from interrupts), only instances with set bits are visited
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_group_s {
+    pkttransfer_t* const* insts_p;  // instances of group (initialized before group)
+    size_t      insts_cnt;          // number of instances (1 .. PKTTRANSFER_GROUP_INST_CNT_MAX)
+    size_t      budget;             // maximum number of instance tasks per group task call (0 - no limit)
+    pkttransfer_atomic_t tx_pending; // bitmask of instances with bytes to be sent
+    pkttransfer_atomic_t rx_ready;  // bitmask of instances with received bytes
+    size_t      next_idx;           // index of instance to be visited first in the next call (round-robin)
+} pkttransfer_group_t;
+
+//==================================================================================================
+//========================================= PUBLIC DATA ============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Built-in CRC engines to be passed in 'pkttransfer_config_t'
+//
+// 'pkttransfer_crc16_itf'  - CRC-16-CCITT, 2 bytes (default engine)
+// 'pkttransfer_crc32c_itf' - CRC-32C (Castagnoli), 4 bytes, uses SSE4.2 instructions if CPU supports them
+//-----------------------------------------------------------------------------
+extern const pkttransfer_crc_itf_t pkttransfer_crc16_itf;
+extern const pkttransfer_crc_itf_t pkttransfer_crc32c_itf;
+
 //==================================================================================================
 //================================ PUBLIC FUNCTIONS DECLARATIONS ===================================
 //==================================================================================================
@@ -289,11 +731,13 @@ bool pkttransfer_is_init(const pkttransfer_t * inst_p);
 //-----------------------------------------------------------------------------
 // Send packet
 //
-// Copies packet into instance's internal buffer for further serializing, encoding and sending
+// Copies packet into instance's internal buffer (or into free slot of TX queue) for further serializing, encoding and sending
+// Packets from TX queue are sent back-to-back in the order of sending
+// Can be called concurrently from several threads or interrupts, slots are reserved without locks
 //
 // 'inst_p'     - pointer to initialized driver instance
 // 'payload_p'  - pointer to payload buffer
-// 'size'       - size of payload (1 .. 'pkttransfer_config_t.pkt_len_max')
+// 'size'       - size of payload (1 .. 'pkttransfer_config_t.payload_size_max')
 // 'can_id_tx'  - ID field for CAN messages
 //
 // Returns - 0 if OK, error code otherwise
@@ -304,6 +748,61 @@ pkttransfer_err_t pkttransfer_send(pkttransfer_t* inst_p, const uint8_t* payload
 pkttransfer_err_t pkttransfer_send(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size, uint32_t can_id_tx);
 #endif
 
+//-----------------------------------------------------------------------------
+// Send packet by reference (zero-copy)
+//
+// Frames packet directly from application's buffer, CRC is calculated while sending
+// Buffer must not be changed until 'pkttransfer_app_itf_t.app_tx_done_cb' is called for it
+// Uses slot of TX queue as 'pkttransfer_send()' does, but not its payload memory
+//
+// 'inst_p'     - pointer to initialized driver instance
+// 'payload_p'  - pointer to payload buffer
+// 'size'       - size of payload (1 .. 'pkttransfer_config_t.payload_size_max')
+// 'can_id_tx'  - ID field for CAN messages
+//
+// Returns - 0 if OK, error code otherwise
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+pkttransfer_err_t pkttransfer_send_ref(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+pkttransfer_err_t pkttransfer_send_ref(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size, uint32_t can_id_tx);
+#endif
+
+//-----------------------------------------------------------------------------
+// Send packet gathered from segments (zero-copy)
+//
+// Frames segments one after another as one packet directly from application's buffers, CRC is calculated across them
+// Segments array and buffers must not be changed until 'pkttransfer_app_itf_t.app_txv_done_cb' is called for packet
+//
+// 'inst_p'     - pointer to initialized driver instance
+// 'segs_p'     - pointer to array of segments (e.g. header and payload)
+// 'segs_cnt'   - number of segments (at least 1)
+// 'can_id_tx'  - ID field for CAN messages
+//
+// Returns - 0 if OK, error code otherwise (total size exceeds 'pkttransfer_config_t.payload_size_max', is 0 without CRC or TX queue is full)
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+pkttransfer_err_t pkttransfer_sendv(pkttransfer_t* inst_p, const pkttransfer_seg_t* segs_p, size_t segs_cnt);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+pkttransfer_err_t pkttransfer_sendv(pkttransfer_t* inst_p, const pkttransfer_seg_t* segs_p, size_t segs_cnt, uint32_t can_id_tx);
+#endif
+
+//-----------------------------------------------------------------------------
+// Get number of free slots in TX queue
+//
+// 'inst_p'     - pointer to initialized driver instance
+//
+// Returns - number of packets which can be sent without overflow
+//-----------------------------------------------------------------------------
+size_t pkttransfer_get_tx_free_slots(const pkttransfer_t* inst_p);
+
+//-----------------------------------------------------------------------------
+// Get maximum number of packets in TX queue since initialization (high-water mark)
+//
+// 'inst_p'     - pointer to initialized driver instance
+//-----------------------------------------------------------------------------
+size_t pkttransfer_get_tx_queue_hwm(const pkttransfer_t* inst_p);
+
 //-----------------------------------------------------------------------------
 // Set CAN ID to filter received CAN messages
 //
@@ -314,6 +813,143 @@ pkttransfer_err_t pkttransfer_send(pkttransfer_t* inst_p, const uint8_t* payload
 void pkttransfer_set_can_id_rx(pkttransfer_t* inst_p, uint32_t can_id_rx);
 #endif
 
+//-----------------------------------------------------------------------------
+// Indicate that DMA chunk is sent (only for UART DMA mode)
+//
+// Can be called from DMA interrupt
+// Starts sending of the next chunk if it's already prepared
+//
+// 'inst_p'     - pointer to initialized driver instance
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+void pkttransfer_tx_dma_complete(pkttransfer_t* inst_p);
+#endif
+
+//-----------------------------------------------------------------------------
+// Indicate that bytes are received into circular DMA buffer (only for UART DMA mode)
+//
+// To be called from UART idle-line interrupt and DMA half-transfer/transfer-complete interrupts
+// Received bytes are processed in one pass in the next 'pkttransfer_task()' call
+// Circular buffer must be large enough to hold all bytes received between two task calls
+//
+// 'inst_p'     - pointer to initialized driver instance
+// 'head'       - index of the next byte to be written by DMA (e.g. buffer size minus DMA counter)
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+void pkttransfer_rx_dma_notify(pkttransfer_t* inst_p, size_t head);
+#endif
+
+//-----------------------------------------------------------------------------
+// Push received bytes into RX ring (only for UART interrupt mode)
+//
+// To be called from UART receive interrupt (single producer), bytes are moved out of hardware FIFO at once
+// and are decoded in the next 'pkttransfer_task()' call, lock-free - interrupts are never disabled
+// Bytes which don't fit into ring are dropped and counted
+//
+// 'inst_p'     - pointer to initialized driver instance with 'pkttransfer_config_t.isr_rx_ring_p'
+// 'data_p'     - pointer to received bytes
+// 'size'       - number of received bytes
+//
+// Returns - number of pushed bytes
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+size_t pkttransfer_isr_rx_push(pkttransfer_t* inst_p, const uint8_t* data_p, size_t size);
+#endif
+
+//-----------------------------------------------------------------------------
+// Pull encoded bytes to be sent from TX ring (only for UART interrupt mode)
+//
+// To be called from UART TX-empty interrupt (single consumer), framing and CRC are done by task beforehand
+// TX ring is filled by 'pkttransfer_task()', 'pkttransfer_hw_itf_t.tx_kick_cb' is called after filling
+//
+// 'inst_p'     - pointer to initialized driver instance with 'pkttransfer_config_t.isr_tx_ring_p'
+// 'data_out_p' - pointer to output buffer (e.g. free space of hardware FIFO)
+// 'size'       - size of output buffer
+//
+// Returns - number of pulled bytes (0 - ring is empty, TX interrupt can be disabled)
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+size_t pkttransfer_isr_tx_pull(pkttransfer_t* inst_p, uint8_t* data_out_p, size_t size);
+#endif
+
+//-----------------------------------------------------------------------------
+// Return loaned RX buffer into driver's pool
+//
+// Payload passed to 'pkttransfer_app_pkt_cb_t' is owned by application until this call
+// Can be called from another thread or interrupt
+// Buffers got from 'pkttransfer_app_itf_t.app_rx_buf_get_cb' are not returned to driver
+// Deferred delivery - packets got with 'pkttransfer_poll_packet()' are released in the same order
+//
+// 'inst_p'     - pointer to initialized driver instance with 'pkttransfer_config_t.rx_pool_p' or 'rx_slots_p'
+// 'payload_p'  - pointer to payload passed to application
+//-----------------------------------------------------------------------------
+void pkttransfer_rx_release(pkttransfer_t* inst_p, const uint8_t* payload_p);
+
+//-----------------------------------------------------------------------------
+// Get the next received packet from deferred delivery ring
+//
+// Task places packets into ring instead of calling 'pkttransfer_app_itf_t.app_pkt_cb', so slow processing
+// of packets doesn't stall receiving; frames are dropped (and counted in 'rx_no_buf_cnt') while ring is full
+// Packet is owned by application until 'pkttransfer_rx_release()', several packets can be polled before release
+// Can be called from one consumer thread concurrently with task
+//
+// 'inst_p'     - pointer to initialized driver instance with 'pkttransfer_config_t.rx_slots_p'
+// 'payload_pp' - pointer to output pointer to payload
+// 'size_p'     - pointer to output size of payload
+//
+// Returns - 'false' if there are no packets in ring
+//-----------------------------------------------------------------------------
+bool pkttransfer_poll_packet(pkttransfer_t* inst_p, const uint8_t** payload_pp, size_t* size_p);
+
+//-----------------------------------------------------------------------------
+// Get maximum number of packets in deferred delivery ring since initialization (high-water mark)
+//
+// 'inst_p'     - pointer to initialized driver instance with 'pkttransfer_config_t.rx_slots_p'
+//-----------------------------------------------------------------------------
+size_t pkttransfer_get_rx_queue_hwm(const pkttransfer_t* inst_p);
+
+//-----------------------------------------------------------------------------
+// Process received bytes passed from application
+//
+// Alternative to receiving over 'pkttransfer_hw_itf_t' callbacks - bytes which are already read from
+// the UART/CAN driver (e.g. whole receive buffer) are decoded in a bulk
+// Calls application callback to indicate received packets
+// Frame can be split between calls at any byte
+// Not to be called concurrently with 'pkttransfer_task()' for the same instance
+// Not used with ISO-TP transport over CAN (there is no byte stream)
+//
+// 'inst_p'     - pointer to initialized driver instance
+// 'data_p'     - pointer to received bytes
+// 'size'       - number of received bytes
+//-----------------------------------------------------------------------------
+void pkttransfer_receive_bytes(pkttransfer_t* inst_p, const uint8_t* data_p, size_t size);
+
+//-----------------------------------------------------------------------------
+// Decode stream of received bytes into many payloads at once
+//
+// Alternative to 'pkttransfer_receive_bytes()' for bulk reading (e.g. from serial port on host) - payloads of all
+// complete frames are copied one after another into output buffer and described with (offset, size) descriptors
+// instead of application callback calls
+// Decoder state is kept in instance, so frame can be split between calls at any byte
+// Decoding is stopped after a frame if there is no place for one more payload of maximum size or descriptor,
+// remaining bytes should be passed again in the next call
+// Not to be called concurrently with 'pkttransfer_task()' for the same instance
+// Not used with ISO-TP transport over CAN (there is no byte stream)
+//
+// 'inst_p'     - pointer to initialized driver instance
+// 'data_p'     - pointer to received bytes
+// 'size'       - number of received bytes
+// 'out_p'      - pointer to output buffer for payloads
+// 'out_cap'    - size of output buffer (at least 'pkttransfer_config_t.payload_size_max')
+// 'descs_p'    - pointer to array of descriptors of payloads
+// 'descs_cap'  - number of descriptors in array (at least 1)
+// 'descs_cnt_p'- pointer to number of decoded payloads, output
+//
+// Returns - number of processed bytes
+//-----------------------------------------------------------------------------
+size_t pkttransfer_decode_stream(pkttransfer_t* inst_p, const uint8_t* data_p, size_t size,
+                                 uint8_t* out_p, size_t out_cap, pkttransfer_frame_desc_t* descs_p, size_t descs_cap, size_t* descs_cnt_p);
+
 //-----------------------------------------------------------------------------
 // Driver task
 //
@@ -325,6 +961,112 @@ void pkttransfer_set_can_id_rx(pkttransfer_t* inst_p, uint32_t can_id_rx);
 //-----------------------------------------------------------------------------
 void pkttransfer_task(pkttransfer_t* inst_p);
 
+//-----------------------------------------------------------------------------
+// Driver task - transmitting half
+//
+// Does the same as 'pkttransfer_task()' for sending only: encodes queued packets and calls low-level callbacks to transmit them
+// Can run concurrently with 'pkttransfer_task_rx()' of the same instance in another thread or on another core
+// ISO-TP transport - flow control is passed from receiving half through atomic mailboxes, only this half applies it
+//
+// 'inst_p' - pointer to initialized driver instance
+//-----------------------------------------------------------------------------
+void pkttransfer_task_tx(pkttransfer_t* inst_p);
+
+//-----------------------------------------------------------------------------
+// Driver task - receiving half
+//
+// Does the same as 'pkttransfer_task()' for receiving only: calls low-level callbacks to receive bytes,
+// decodes frames and calls application callbacks to indicate received packets
+// Can run concurrently with 'pkttransfer_task_tx()' of the same instance in another thread or on another core
+//
+// 'inst_p' - pointer to initialized driver instance
+//-----------------------------------------------------------------------------
+void pkttransfer_task_rx(pkttransfer_t* inst_p);
+
+//-----------------------------------------------------------------------------
+// Indicate that bytes are received by low level driver
+//
+// Hint for group task - sets RX-ready bit of instance in its group, does nothing if instance isn't in group
+// To be called from UART/CAN receive interrupt or from another thread
+// UART DMA mode - 'pkttransfer_rx_dma_notify()' sets the bit itself
+//
+// 'inst_p'     - pointer to initialized driver instance
+//-----------------------------------------------------------------------------
+void pkttransfer_rx_notify(pkttransfer_t* inst_p);
+
+//-----------------------------------------------------------------------------
+// Indicate that low level driver can accept bytes to be sent
+//
+// Hint for group task - sets TX-pending bit of instance in its group, does nothing if instance isn't in group
+// To be called from UART/CAN transmit interrupt (e.g. TX FIFO or mailbox is empty) or from another thread,
+// group task doesn't poll 'tx_is_avail_cb' of instance which couldn't send after its task
+// UART DMA and interrupt modes - 'pkttransfer_tx_dma_complete()' and 'pkttransfer_isr_tx_pull()' set the bit themselves
+//
+// 'inst_p'     - pointer to initialized driver instance
+//-----------------------------------------------------------------------------
+void pkttransfer_tx_notify(pkttransfer_t* inst_p);
+
+//-----------------------------------------------------------------------------
+// Initialize group of driver instances
+//
+// All instances are marked as ready, so each of them is visited at least once
+// Instance must not be reinitialized while it's in group
+//
+// 'group_p'    - pointer to group
+// 'insts_p'    - pointer to array of pointers to initialized driver instances (array isn't copied)
+// 'insts_cnt'  - number of instances (1 .. PKTTRANSFER_GROUP_INST_CNT_MAX)
+// 'budget'     - maximum number of instance tasks per group task call (0 - no limit)
+//-----------------------------------------------------------------------------
+void pkttransfer_group_init(pkttransfer_group_t* group_p, pkttransfer_t* const* insts_p, size_t insts_cnt, size_t budget);
+
+//-----------------------------------------------------------------------------
+// Group task
+//
+// Replaces 'pkttransfer_task()' calls for all instances of group:
+//  - only instances with TX-pending or RX-ready bits are visited, idle instances cost nothing,
+//    TX half of instance is run only with its TX-pending bit and RX half only with its RX-ready bit
+//  - instances are visited in round-robin order, up to 'budget' instances per call,
+//    the rest keep their bits and are visited first in the next call
+//  - bits are kept after the task of instance only if it can continue right now: budget of messages per task is used up,
+//    or the next UART DMA chunk is free, stalled instance (busy hardware, full TX ring, ISO-TP waiting for flow control)
+//    isn't visited until its bits are set again, hardware callbacks aren't polled after the task
+//
+// 'group_p'    - pointer to initialized group
+//
+// Returns - number of visited instances (0 - all instances are idle or stalled, e.g. thread can wait for interrupt)
+//-----------------------------------------------------------------------------
+size_t pkttransfer_group_task(pkttransfer_group_t* group_p);
+
+//-----------------------------------------------------------------------------
+// Get exact size of frame encoded by 'pkttransfer_encode_frame()'
+//
+// Delimiter and escape bytes are counted word-at-a-time, CRC is calculated to count its escape bytes
+// Reentrant, doesn't need driver instance
+//
+// 'crc_itf_p'  - CRC engine (NULL - default CRC16)
+// 'payload_p'  - pointer to payload
+// 'size'       - size of payload
+//
+// Returns - size of frame with delimiters, escape sequences and CRC
+//-----------------------------------------------------------------------------
+size_t pkttransfer_encoded_size(const pkttransfer_crc_itf_t* crc_itf_p, const uint8_t* payload_p, size_t size);
+
+//-----------------------------------------------------------------------------
+// Encode frame into buffer at once (e.g. for DMA, logging or writing into socket)
+//
+// Frame is the same as the one sent by driver instance: | 0x7E |  PAYLOAD  |  CRC  | 0x7E |
+// Reentrant, doesn't need driver instance
+//
+// 'crc_itf_p'  - CRC engine (NULL - default CRC16)
+// 'payload_p'  - pointer to payload
+// 'size'       - size of payload
+// 'out_p'      - pointer to output buffer
+// 'out_cap'    - size of output buffer (enough size is got with 'pkttransfer_encoded_size()')
+//
+// Returns - size of frame, 0 if output buffer is too small
+//-----------------------------------------------------------------------------
+size_t pkttransfer_encode_frame(const pkttransfer_crc_itf_t* crc_itf_p, const uint8_t* payload_p, size_t size, uint8_t* out_p, size_t out_cap);
+
 //-----------------------------------------------------------------------------
 // Calculate CRC-16-CCITT (aka CRC-16-HDLC or CRC-16-X25) for entire buffer
 //
@@ -339,6 +1081,20 @@ void pkttransfer_task(pkttransfer_t* inst_p);
 //-----------------------------------------------------------------------------
 uint16_t pkttransfer_crc16(const uint8_t* data_p, size_t size);
 
+//-----------------------------------------------------------------------------
+// Calculate CRC-32C (aka CRC-32-Castagnoli or CRC-32-iSCSI) for entire buffer
+//
+// x^32 + x^28 + x^27 + x^26 + x^25 + x^23 + x^22 + x^20 + x^19 + x^18 + x^14 + x^13 + x^11 + x^10 + x^9 + x^8 + x^6 + 1
+// poly_normal 0x1EDC6F41; poly_reversed 0x82F63B78; init 0xFFFFFFFF; xor 0xFFFFFFFF; RefIn true; RefOut true;
+// test 0xE3069283 for "123456789"
+//
+// 'data_p' - pointer to data buffer
+// 'size'   - size of data in buffer
+//
+// Returns - CRC32 value
+//-----------------------------------------------------------------------------
+uint32_t pkttransfer_crc32c(const uint8_t* data_p, size_t size);
+
 //==================================================================================================
 //============================================ TESTS ===============================================
 //==================================================================================================
@@ -0,0 +1,249 @@
+//**************************************************************************************************
+// POSIX file descriptor backend of packets transfer driver
+//**************************************************************************************************
+//
+// Host backend which binds driver instance to any stream file descriptor (tty, pty, socket, pipe):
+//
+//  - port:     driver instance in UART DMA mode, bytes are moved with batched non-blocking 'read()' and 'write()'
+//              calls directly into circular RX buffer and from TX chunks of the port, without byte-by-byte callbacks
+//  - gateway:  epoll event loop which services many ports from a small pool of threads,
+//              each port is serviced by one thread at a time, events received meanwhile are serviced by the same thread
+//
+// Only for UART (stream) driver and Linux host (epoll, eventfd)
+//
+// Usage without gateway:
+//  - 'pkttransfer_posix_port_init()' sets fd to non-blocking mode and initializes driver instance
+//  - 'pkttransfer_posix_port_service()' is called when fd is readable or writable (poll/select) or periodically
+//
+// Usage with gateway:
+//  - 'pkttransfer_posix_gw_init()', then 'pkttransfer_posix_gw_add()' for each port
+//  - 'pkttransfer_posix_gw_start()' runs pool of threads, 'pkttransfer_posix_gw_stop()' stops and joins them
+//  - 'pkttransfer_posix_port_kick()' after 'pkttransfer_send()' wakes gateway to send the queued packets
+//  - packets are passed to application from gateway threads ('app_pkt_cb'), or are taken with 'pkttransfer_poll_packet()'
+//
+// Writing into closed pipe or socket raises SIGPIPE, application should ignore it ('EPIPE' closes the port)
+//
+//**************************************************************************************************
+#ifndef DRV_PKTTRANSFER_POSIX_H
+#define DRV_PKTTRANSFER_POSIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "drv_pkttransfer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (defined(PKTTRANSFER_OVER_UART))
+
+//==================================================================================================
+//=========================================== MACROS ===============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Size of one TX chunk written with one 'write()' call (port has two chunks)
+//-----------------------------------------------------------------------------
+#ifndef PKTTRANSFER_POSIX_TX_CHUNK_SIZE
+    #define PKTTRANSFER_POSIX_TX_CHUNK_SIZE (4096)
+#endif
+
+//-----------------------------------------------------------------------------
+// Size of circular RX buffer read with one 'read()' call (decoded after each call)
+//-----------------------------------------------------------------------------
+#ifndef PKTTRANSFER_POSIX_RX_BUF_SIZE
+    #define PKTTRANSFER_POSIX_RX_BUF_SIZE (4096)
+#endif
+
+//-----------------------------------------------------------------------------
+// Maximum number of threads in gateway pool
+//-----------------------------------------------------------------------------
+#ifndef PKTTRANSFER_POSIX_GW_THREADS_MAX
+    #define PKTTRANSFER_POSIX_GW_THREADS_MAX (16)
+#endif
+
+//-----------------------------------------------------------------------------
+// Maximum number of events taken with one 'epoll_wait()' call by gateway thread
+//-----------------------------------------------------------------------------
+#ifndef PKTTRANSFER_POSIX_GW_EVENTS_MAX
+    #define PKTTRANSFER_POSIX_GW_EVENTS_MAX (32)
+#endif
+
+//==================================================================================================
+//========================================== TYPEDEFS ==============================================
+//==================================================================================================
+
+struct pkttransfer_posix_gw_s;
+
+//------------------------------------------------------------------------------
+// Port - driver instance bound to file descriptor
+// All fields are private, except error and statistics
+// Error and statistics are written by servicing thread, other threads read them with relaxed atomic loads
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_posix_port_s {
+    pkttransfer_t*  inst_p;             // driver instance of the port
+    int             fd;                 // bound file descriptor (non-blocking)
+    int             kick_fd;            // eventfd to wake gateway for sending (-1 - port isn't added into gateway)
+    struct pkttransfer_posix_gw_s* gw_p; // gateway of the port (NULL - port isn't added into gateway)
+
+    const uint8_t*  tx_chunk_p;         // TX chunk being written (NULL - no chunk)
+    size_t          tx_chunk_size;      // size of TX chunk
+    size_t          tx_chunk_done;      // number of already written bytes of TX chunk
+    size_t          rx_head;            // index in RX buffer of the next byte to be read
+
+    pkttransfer_atomic_t sched_cnt;     // number of service requests (only one thread services port while it isn't 0)
+    PKTTRANSFER_ATOMIC(bool) is_closed; // end of file or I/O error, port isn't serviced anymore (set after 'err')
+    PKTTRANSFER_ATOMIC(int) err;        // 'errno' of I/O error (0 - end of file or no error)
+
+    // Statistics
+    PKTTRANSFER_ATOMIC(size_t) read_calls_cnt;  // number of 'read()' calls which returned data
+    PKTTRANSFER_ATOMIC(size_t) write_calls_cnt; // number of 'write()' calls which wrote data
+    PKTTRANSFER_ATOMIC(size_t) rx_bytes_cnt;    // number of read bytes
+    PKTTRANSFER_ATOMIC(size_t) tx_bytes_cnt;    // number of written bytes
+
+    uint8_t         tx_buf[2 * PKTTRANSFER_POSIX_TX_CHUNK_SIZE];
+    uint8_t         rx_buf[PKTTRANSFER_POSIX_RX_BUF_SIZE];
+} pkttransfer_posix_port_t;
+
+//------------------------------------------------------------------------------
+// Gateway - epoll event loop with pool of threads
+// All fields are private
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_posix_gw_s {
+    int             epoll_fd;           // epoll instance of all ports
+    int             stop_fd;            // eventfd to wake all threads for stopping
+    pthread_t       threads[PKTTRANSFER_POSIX_GW_THREADS_MAX];
+    size_t          threads_cnt;        // number of running threads
+} pkttransfer_posix_gw_t;
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DECLARATIONS ===================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Initialize port: set file descriptor into non-blocking mode and initialize driver instance in DMA mode
+//
+// Callbacks of hardware level and DMA buffers are provided by port, the rest of configuration is taken from application
+// ('tx_dma_*', 'rx_dma_*' and 'isr_*' fields of 'config_p' are ignored)
+// File descriptor isn't closed by port
+//
+// 'port_p'     - pointer to port
+// 'inst_p'     - pointer to driver instance to be initialized
+// 'fd'         - file descriptor of stream (tty, pty, socket, pipe)
+// 'app_itf_p'  - pointer to interface to application level
+// 'config_p'   - pointer to driver configuration
+//
+// Returns - PKTTRANSFER_ERR_OK, PKTTRANSFER_ERR_IO if fd can't be switched into non-blocking mode ('errno')
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_posix_port_init(pkttransfer_posix_port_t* port_p, pkttransfer_t* inst_p, int fd,
+                                              const pkttransfer_app_itf_t* app_itf_p, const pkttransfer_config_t* config_p);
+
+//-----------------------------------------------------------------------------
+// Deinitialize port and its driver instance (port must be removed from gateway before)
+//
+// 'port_p'     - pointer to initialized port
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_port_deinit(pkttransfer_posix_port_t* port_p);
+
+//-----------------------------------------------------------------------------
+// Service port: read all available bytes and decode them, encode queued packets and write them until fd is full
+//
+// Not to be called concurrently for one port (gateway calls it itself)
+//
+// 'port_p'     - pointer to initialized port
+//
+// Returns - true if there are unwritten bytes (wait until fd is writable), false - all bytes are written
+//-----------------------------------------------------------------------------
+bool pkttransfer_posix_port_service(pkttransfer_posix_port_t* port_p);
+
+//-----------------------------------------------------------------------------
+// Check if port is closed (end of file or I/O error, see 'pkttransfer_posix_port_t.err')
+//
+// Can be called from any thread, 'err' is visible after this function returns true
+//
+// 'port_p'     - pointer to initialized port
+//-----------------------------------------------------------------------------
+bool pkttransfer_posix_port_is_closed(const pkttransfer_posix_port_t* port_p);
+
+//-----------------------------------------------------------------------------
+// Wake gateway to send packets queued with 'pkttransfer_send()' (only for port added into gateway)
+//
+// Can be called from any thread, wakes only one thread of pool
+//
+// 'port_p'     - pointer to port added into gateway
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_port_kick(pkttransfer_posix_port_t* port_p);
+
+//-----------------------------------------------------------------------------
+// Initialize gateway
+//
+// 'gw_p'       - pointer to gateway
+//
+// Returns - PKTTRANSFER_ERR_OK, PKTTRANSFER_ERR_IO if epoll or eventfd can't be created ('errno')
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_posix_gw_init(pkttransfer_posix_gw_t* gw_p);
+
+//-----------------------------------------------------------------------------
+// Deinitialize gateway (threads must be stopped, ports must be removed before)
+//
+// 'gw_p'       - pointer to initialized gateway
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_gw_deinit(pkttransfer_posix_gw_t* gw_p);
+
+//-----------------------------------------------------------------------------
+// Add port into gateway (port is serviced by gateway threads since this call)
+//
+// 'gw_p'       - pointer to initialized gateway
+// 'port_p'     - pointer to initialized port, not added into another gateway
+//
+// Returns - PKTTRANSFER_ERR_OK, PKTTRANSFER_ERR_IO if eventfd can't be created or fd can't be added into epoll ('errno')
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_posix_gw_add(pkttransfer_posix_gw_t* gw_p, pkttransfer_posix_port_t* port_p);
+
+//-----------------------------------------------------------------------------
+// Remove port from gateway (gateway threads must be stopped)
+//
+// 'gw_p'       - pointer to initialized gateway
+// 'port_p'     - pointer to port added into the gateway
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_gw_remove(pkttransfer_posix_gw_t* gw_p, pkttransfer_posix_port_t* port_p);
+
+//-----------------------------------------------------------------------------
+// Start pool of gateway threads
+//
+// 'gw_p'       - pointer to initialized gateway with stopped threads
+// 'threads_cnt'- number of threads (1 .. PKTTRANSFER_POSIX_GW_THREADS_MAX)
+//
+// Returns - PKTTRANSFER_ERR_OK, PKTTRANSFER_ERR_IO if thread can't be created (already started threads are stopped)
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_posix_gw_start(pkttransfer_posix_gw_t* gw_p, size_t threads_cnt);
+
+//-----------------------------------------------------------------------------
+// Stop pool of gateway threads and wait for them
+//
+// 'gw_p'       - pointer to initialized gateway
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_gw_stop(pkttransfer_posix_gw_t* gw_p);
+
+//==================================================================================================
+//============================================ TESTS ===============================================
+//==================================================================================================
+
+#if (defined(PKTTRANSFER_USE_TESTS))
+//-----------------------------------------------------------------------------
+// Run tests of POSIX backend over socketpairs and pseudo-terminals
+// Stay in assert if test is failed
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_run_tests(void);
+#endif
+
+#endif // PKTTRANSFER_OVER_UART
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // DRV_PKTTRANSFER_POSIX_H
@@ -0,0 +1,239 @@
+//**************************************************************************************************
+// Shared memory rings of packets transfer driver
+//**************************************************************************************************
+//
+// Host module which passes packets between driver process and another processes through POSIX shared memory
+// ('shm_open()' file mapped by all processes), without sockets, copies into kernel and syscalls per packet:
+//
+//  - delivery ring (PKTTRANSFER_SHM_KIND_DELIVERY): driver process writes received packets into ring with
+//    'pkttransfer_shm_app_pkt_cb()' set as 'pkttransfer_app_itf_t.app_pkt_cb', any number of consumer processes
+//    read all packets in place (zero-copy), each consumer has its own read position
+//  - submit ring (PKTTRANSFER_SHM_KIND_SUBMIT): any number of producer processes put packets into ring with
+//    'pkttransfer_shm_submit()', driver process passes them to 'pkttransfer_send()' with 'pkttransfer_shm_forward()'
+//
+// Shared layout - header and array of slots, each slot has sequence number of its position in ring:
+//
+//  | header | slot 0: seq, size, payload | slot 1: seq, size, payload | ... | slot N-1 |
+//
+// Delivery ring is never blocked by consumers: writer overwrites the oldest slot, consumer which is late
+// by more than whole ring skips overwritten packets and counts them ('pkttransfer_shm_t.lost_cnt'),
+// packet overwritten while it's read in place is detected by 'pkttransfer_shm_read_done()'
+// (consumer copies or parses payload first and trusts the result only after 'pkttransfer_shm_read_done()' returns true)
+//
+// Submit ring is bounded multi-producer queue: slots are reserved with compare-and-swap,
+// 'pkttransfer_shm_submit()' returns PKTTRANSFER_ERR_TX_OVF if ring is full
+// Producer killed between reserving and filling of slot stalls the ring until it's created again
+//
+// Only for host with lock-free 32-bit and 64-bit atomics (they are shared between processes)
+//
+//**************************************************************************************************
+#ifndef DRV_PKTTRANSFER_SHM_H
+#define DRV_PKTTRANSFER_SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "drv_pkttransfer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==================================================================================================
+//=========================================== MACROS ===============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Identification of shared layout
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_SHM_MAGIC           (0x504B5452UL)  // 'PKTR'
+#define PKTTRANSFER_SHM_VERSION         (1UL)
+
+//-----------------------------------------------------------------------------
+// Kinds of rings
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_SHM_KIND_DELIVERY   (1UL)   // driver -> consumers, one writer, many readers
+#define PKTTRANSFER_SHM_KIND_SUBMIT     (2UL)   // producers -> driver, many writers, one reader
+
+//==================================================================================================
+//========================================== TYPEDEFS ==============================================
+//==================================================================================================
+
+//------------------------------------------------------------------------------
+// Position in ring and sequence number of slot, 64-bit values never wrap around
+//------------------------------------------------------------------------------
+typedef PKTTRANSFER_ATOMIC(uint64_t) pkttransfer_shm_seq_t;
+
+//------------------------------------------------------------------------------
+// Header of ring in shared memory
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_shm_hdr_s {
+    pkttransfer_atomic_t magic;         // PKTTRANSFER_SHM_MAGIC, set after the whole ring is initialized
+    uint32_t    version;                // PKTTRANSFER_SHM_VERSION
+    uint32_t    kind;                   // PKTTRANSFER_SHM_KIND_DELIVERY or PKTTRANSFER_SHM_KIND_SUBMIT
+    uint32_t    slots_cnt;              // number of slots
+    uint32_t    payload_size_max;       // maximum size of payload in slot
+    uint32_t    slot_stride;            // distance between slots in bytes
+    pkttransfer_atomic_t drop_cnt;      // delivery ring - packets larger than slot, dropped by writer
+
+    PKTTRANSFER_ALIGNAS(PKTTRANSFER_CACHELINE_SIZE)
+    pkttransfer_shm_seq_t head;         // position of the next packet to be written (reserved by producers in submit ring)
+
+    PKTTRANSFER_ALIGNAS(PKTTRANSFER_CACHELINE_SIZE)
+    pkttransfer_shm_seq_t tail;         // submit ring - position of the next packet to be forwarded to driver
+} pkttransfer_shm_hdr_t;
+
+//------------------------------------------------------------------------------
+// Slot of ring in shared memory
+//
+// Delivery ring: seq is (2 * pos + 1) while packet of position 'pos' is written, (2 * pos + 2) when it's written
+// Submit ring:   seq is 'pos' when slot is free for position 'pos', (pos + 1) when packet is ready for forwarding
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_shm_slot_s {
+    pkttransfer_shm_seq_t seq;          // sequence number
+    uint32_t    size;                   // size of payload
+    uint8_t     data[];                 // payload
+} pkttransfer_shm_slot_t;
+
+//------------------------------------------------------------------------------
+// Ring mapped by process
+// All fields are private, except 'lost_cnt'
+//------------------------------------------------------------------------------
+typedef struct pkttransfer_shm_s {
+    pkttransfer_shm_hdr_t* hdr_p;       // mapped header (NULL - ring isn't mapped)
+    uint8_t*    slots_p;                // mapped slots
+    size_t      map_size;               // size of mapping
+    uint64_t    read_pos;               // delivery ring - position of the next packet to be read by this process
+    bool        is_reading;             // delivery ring - packet of 'read_pos' is read in place
+    uint64_t    lost_cnt;               // delivery ring - packets overwritten before they were read by this process
+} pkttransfer_shm_t;
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DECLARATIONS ===================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Create ring in shared memory and map it
+//
+// Existing ring of the same name is replaced, processes which have mapped it keep the old ring
+//
+// 'shm_p'              - pointer to ring to be mapped
+// 'name'               - name of shared memory object ("/name")
+// 'kind'               - PKTTRANSFER_SHM_KIND_DELIVERY or PKTTRANSFER_SHM_KIND_SUBMIT
+// 'slots_cnt'          - number of slots
+// 'payload_size_max'   - maximum size of payload (usually 'pkttransfer_config_t.payload_size_max')
+//
+// Returns - PKTTRANSFER_ERR_OK, PKTTRANSFER_ERR_IO if shared memory can't be created or mapped ('errno')
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_shm_create(pkttransfer_shm_t* shm_p, const char* name, uint32_t kind, size_t slots_cnt, size_t payload_size_max);
+
+//-----------------------------------------------------------------------------
+// Map existing ring
+//
+// Reader of delivery ring starts with the next written packet
+//
+// 'shm_p'      - pointer to ring to be mapped
+// 'name'       - name of shared memory object
+//
+// Returns - PKTTRANSFER_ERR_OK, PKTTRANSFER_ERR_IO if ring can't be mapped ('errno', EINVAL - it isn't valid ring)
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_shm_open(pkttransfer_shm_t* shm_p, const char* name);
+
+//-----------------------------------------------------------------------------
+// Unmap ring (shared memory object exists until 'pkttransfer_shm_unlink()')
+//
+// 'shm_p'      - pointer to mapped ring
+//-----------------------------------------------------------------------------
+void pkttransfer_shm_close(pkttransfer_shm_t* shm_p);
+
+//-----------------------------------------------------------------------------
+// Remove name of shared memory object, mapped rings stay valid until they are closed
+//
+// 'name'       - name of shared memory object
+//-----------------------------------------------------------------------------
+void pkttransfer_shm_unlink(const char* name);
+
+//-----------------------------------------------------------------------------
+// Write received packet into delivery ring - to be set as 'pkttransfer_app_itf_t.app_pkt_cb'
+//
+// Only one writer at a time (driver task), packet larger than slot is dropped and counted in header
+//
+// 'app_p'      - pointer to mapped delivery ring ('pkttransfer_app_itf_t.app_p')
+// 'payload_p'  - pointer to received payload
+// 'size'       - size of received payload
+//-----------------------------------------------------------------------------
+void pkttransfer_shm_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size);
+
+//-----------------------------------------------------------------------------
+// Get the next packet of delivery ring in place (zero-copy)
+//
+// Packet must be finished with 'pkttransfer_shm_read_done()' before the next call
+// Payload can be overwritten by writer at any moment, even while it's read: copy it out of ring (or parse it)
+// and use the copy only if 'pkttransfer_shm_read_done()' returns true, size is checked the same way
+//
+// 'shm_p'      - pointer to mapped delivery ring
+// 'payload_pp' - pointer to output pointer to payload in shared memory
+// 'size_p'     - pointer to output size of payload
+//
+// Returns - true if there is packet, false - all written packets are read
+//-----------------------------------------------------------------------------
+bool pkttransfer_shm_read(pkttransfer_shm_t* shm_p, const uint8_t** payload_pp, size_t* size_p);
+
+//-----------------------------------------------------------------------------
+// Finish packet got with 'pkttransfer_shm_read()'
+//
+// 'shm_p'      - pointer to mapped delivery ring
+//
+// Returns - true if packet was valid during the whole reading, false - it has been overwritten meanwhile
+//           and read data must be discarded (it's counted in 'lost_cnt')
+//-----------------------------------------------------------------------------
+bool pkttransfer_shm_read_done(pkttransfer_shm_t* shm_p);
+
+//-----------------------------------------------------------------------------
+// Put packet into submit ring
+//
+// Can be called concurrently from several threads and processes
+//
+// 'shm_p'      - pointer to mapped submit ring
+// 'payload_p'  - pointer to payload
+// 'size'       - size of payload (1 .. 'payload_size_max' of ring)
+//
+// Returns - PKTTRANSFER_ERR_OK, PKTTRANSFER_ERR_TX_OVF if ring is full
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_shm_submit(pkttransfer_shm_t* shm_p, const uint8_t* payload_p, size_t size);
+
+//-----------------------------------------------------------------------------
+// Pass packets of submit ring to 'pkttransfer_send()' in order until ring is empty or TX queue is full
+//
+// Only one process at a time (driver process)
+//
+// 'shm_p'      - pointer to mapped submit ring
+// 'inst_p'     - pointer to initialized driver instance
+// 'can_id_tx'  - ID of CAN messages
+//
+// Returns - number of packets passed to driver
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+size_t pkttransfer_shm_forward(pkttransfer_shm_t* shm_p, pkttransfer_t* inst_p);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+size_t pkttransfer_shm_forward(pkttransfer_shm_t* shm_p, pkttransfer_t* inst_p, uint32_t can_id_tx);
+#endif
+
+//==================================================================================================
+//============================================ TESTS ===============================================
+//==================================================================================================
+
+#if (defined(PKTTRANSFER_USE_TESTS))
+//-----------------------------------------------------------------------------
+// Run tests of shared memory rings on the host
+// Stay in assert if test is failed
+//-----------------------------------------------------------------------------
+void pkttransfer_shm_run_tests(void);
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // DRV_PKTTRANSFER_SHM_H
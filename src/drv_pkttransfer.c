@@ -2,11 +2,25 @@
 // Driver for variable length packets transfer over serial interfaces
 //**************************************************************************************************
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 
 #include "drv_pkttransfer.h"
 
+#if (defined(__GNUC__)) && (defined(__x86_64__) || defined(__i386__))
+    #define PKTTRANSFER_CRC32C_USE_SSE42_X86
+    #if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_CLMUL)
+        #define PKTTRANSFER_CRC16_USE_CLMUL_X86
+    #endif
+    #include <immintrin.h>
+#endif
+
+#if (defined(__GNUC__)) && (defined(__SSE2__))
+    #define PKTTRANSFER_SCAN_USE_SSE2
+    #include <emmintrin.h>
+#endif
+
 //==================================================================================================
 //=========================================== MACROS ===============================================
 //==================================================================================================
@@ -20,26 +34,617 @@
 #define PKTTRANSFER_FRAME_ENCODED_DELIMITER_BYTE    (0x5E)
 #define PKTTRANSFER_FRAME_ENCODED_ESCAPE_BYTE       (0x5D)
 
+//-----------------------------------------------------------------------------
+// UART DMA sending - flags of two chunks and index of chunk to be sent next
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_DMA_CHUNK_FREE          (0U)    // chunk can be filled by task
+#define PKTTRANSFER_DMA_CHUNK_READY         (1U)    // chunk is filled and waits for sending
+#define PKTTRANSFER_DMA_CHUNK_BUSY          (2U)    // chunk is being sent by DMA
+#define PKTTRANSFER_DMA_CHUNK_MASK          (3U)
+#define PKTTRANSFER_DMA_CHUNK_SHIFT(idx)    (2U * (idx))
+#define PKTTRANSFER_DMA_SEND_IDX_BIT        (1U << 4)
+
+#define PKTTRANSFER_DMA_CHUNK_GET(flags, idx)       (((flags) >> PKTTRANSFER_DMA_CHUNK_SHIFT(idx)) & PKTTRANSFER_DMA_CHUNK_MASK)
+#define PKTTRANSFER_DMA_CHUNK_SET(flags, idx, st)   (((flags) & ~(PKTTRANSFER_DMA_CHUNK_MASK << PKTTRANSFER_DMA_CHUNK_SHIFT(idx))) | ((st) << PKTTRANSFER_DMA_CHUNK_SHIFT(idx)))
+
+//-----------------------------------------------------------------------------
+// TX queue - positions wrap at multiple of slots count not above this limit, so distances fit into int32_t
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_TX_QUEUE_WRAP_MAX       (0x80000000UL)
+#define PKTTRANSFER_TX_SLOT_READY_BIT       (0x80000000UL)  // set in sequence number of slot pushed by sender (above any position)
+
+//-----------------------------------------------------------------------------
+// ISO-TP (ISO 15765-2) over CAN
+//
+// Type of protocol control information (PCI) is in the high nibble of the first byte of CAN message:
+//  - single frame:        | 0x0 LEN |  DATA  |                    LEN 1..7, CAN FD: | 0x00 | LEN | DATA | for LEN up to 62
+//  - first frame:         | 0x1 LEN | LEN |  DATA  |              LEN 8..4095, longer: | 0x10 | 0x00 | LEN (32 bits, MSB first) | DATA |
+//  - consecutive frame:   | 0x2 SN  |  DATA  |                    SN - sequence number 1..15, 0, 1..
+//  - flow control:        | 0x3 FS  | BS | STmin |                FS - flow status, BS - block size, STmin - separation time
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_ISOTP_PCI_SF            (0x0U)  // single frame
+#define PKTTRANSFER_ISOTP_PCI_FF            (0x1U)  // first frame
+#define PKTTRANSFER_ISOTP_PCI_CF            (0x2U)  // consecutive frame
+#define PKTTRANSFER_ISOTP_PCI_FC            (0x3U)  // flow control
+
+#define PKTTRANSFER_ISOTP_FS_CTS            (0x0U)  // flow status - continue to send
+#define PKTTRANSFER_ISOTP_FS_WAIT           (0x1U)  // flow status - wait for the next flow control
+#define PKTTRANSFER_ISOTP_FS_OVFLW          (0x2U)  // flow status - message is too long, abort sending
+
+#define PKTTRANSFER_ISOTP_SF_LEN_MAX        (7U)    // maximum length in single frame without escape
+#define PKTTRANSFER_ISOTP_FF_LEN_MAX        (4095U) // maximum length in first frame without escape
+#define PKTTRANSFER_ISOTP_FC_SIZE           (3U)    // size of flow control frame
+#define PKTTRANSFER_ISOTP_SN_MASK           (0x0FU)
+
+//-----------------------------------------------------------------------------
+// Flow control passed from RX half to TX half in mailbox word (0 - mailbox is empty)
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_ISOTP_FC_VALID          (0x10000UL)
+#define PKTTRANSFER_ISOTP_FC_WORD(fs, bs)   ((uint32_t)(PKTTRANSFER_ISOTP_FC_VALID | ((uint32_t)(fs) << 8) | (uint32_t)(bs)))
+#define PKTTRANSFER_ISOTP_FC_FS(word)       ((uint8_t)(((word) >> 8) & 0x0FU))
+#define PKTTRANSFER_ISOTP_FC_BS(word)       ((uint8_t)((word) & 0xFFU))
+
+//-----------------------------------------------------------------------------
+// Word-at-a-time scanning for delimiter and escape bytes
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_SWAR_ONES               ((pkttransfer_swar_word_t)(~(pkttransfer_swar_word_t)0) / 0xFF)     // 0x0101...01
+#define PKTTRANSFER_SWAR_LOW7               (PKTTRANSFER_SWAR_ONES * 0x7F)                                       // 0x7F7F...7F
+#define PKTTRANSFER_SWAR_DELIMITERS         (PKTTRANSFER_SWAR_ONES * PKTTRANSFER_FRAME_DELIMITER_BYTE)
+#define PKTTRANSFER_SWAR_ESCAPES            (PKTTRANSFER_SWAR_ONES * PKTTRANSFER_FRAME_ESCAPE_BYTE)
+
+//-----------------------------------------------------------------------------
+// CRC-16-CCITT parameters
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_CRC16_POLY_REVERSED     (0x8408U)  // reversed poly (LSB-first) for 0x1021
+#define PKTTRANSFER_CRC16_INIT              (0xFFFFU)
+#define PKTTRANSFER_CRC16_XOROUT            (0xFFFFU)
+
+//-----------------------------------------------------------------------------
+// CRC-32C parameters
+//-----------------------------------------------------------------------------
+#define PKTTRANSFER_CRC32C_POLY_REVERSED    (0x82F63B78UL)  // reversed poly (LSB-first) for 0x1EDC6F41
+#define PKTTRANSFER_CRC32C_INIT             (0xFFFFFFFFUL)
+#define PKTTRANSFER_CRC32C_XOROUT           (0xFFFFFFFFUL)
+#define PKTTRANSFER_CRC32C_SIZE             (4)
+
+//-----------------------------------------------------------------------------
+// Number of CRC16 tables (256 entries each) required by selected kernel
+//-----------------------------------------------------------------------------
+#if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_TABLE)
+    #define PKTTRANSFER_CRC16_TABLES_NUM    (1)
+#elif (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_SLICE8) || (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_CLMUL)
+    #define PKTTRANSFER_CRC16_TABLES_NUM    (8)
+#endif
+
+//-----------------------------------------------------------------------------
+// Carry-less multiplication folding
+//
+// Constants are (x^N mod P) bit-reflected into the 64-bit operand, N is decreased by 1
+// to compensate the shift of bit-reflected product
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_CRC16_USE_CLMUL_X86))
+    #define PKTTRANSFER_CRC16_CLMUL_MIN_SIZE    (64)                        // less data is processed by SLICE8
+    #define PKTTRANSFER_CRC16_CLMUL_K_128_HI    (0xA95D000000000000ULL)     // x^(128+64-1) mod P
+    #define PKTTRANSFER_CRC16_CLMUL_K_128_LO    (0x7EEA000000000000ULL)     // x^(128-1) mod P
+    #define PKTTRANSFER_CRC16_CLMUL_K_512_HI    (0x9822000000000000ULL)     // x^(512+64-1) mod P
+    #define PKTTRANSFER_CRC16_CLMUL_K_512_LO    (0x7F90000000000000ULL)     // x^(512-1) mod P
+#endif
+
 //==================================================================================================
 //========================================== TYPEDEFS ==============================================
 //==================================================================================================
 
+//-----------------------------------------------------------------------------
+// Machine word for word-at-a-time scanning
+//-----------------------------------------------------------------------------
+#if (SIZE_MAX > 0xFFFFFFFFUL)
+typedef uint64_t pkttransfer_swar_word_t;
+#else
+typedef uint32_t pkttransfer_swar_word_t;
+#endif
+
+//-----------------------------------------------------------------------------
+// CRC kernels selected at runtime by CPU features
+//-----------------------------------------------------------------------------
+typedef uint16_t (*pkttransfer_crc16_kernel_t)(uint16_t crc, const uint8_t* data_p, size_t size);
+typedef uint32_t (*pkttransfer_crc32c_kernel_t)(uint32_t crc, const uint8_t* data_p, size_t size);
+
+//-----------------------------------------------------------------------------
+// Output of 'pkttransfer_decode_stream()' - decoded payloads and their descriptors
+//-----------------------------------------------------------------------------
+struct pkttransfer_stream_s {
+    uint8_t*    out_p;              // output buffer for payloads
+    size_t      out_cap;            // size of output buffer
+    size_t      out_size;           // size of payloads in output buffer
+    pkttransfer_frame_desc_t* descs_p; // descriptors of payloads
+    size_t      descs_cap;          // maximum number of descriptors
+    size_t      descs_cnt;          // number of descriptors
+    bool        is_full;            // output can't take one more payload of maximum size
+};
+
 //==================================================================================================
 //================================ PRIVATE FUNCTIONS DECLARATIONS ==================================
 //==================================================================================================
 static bool pkttransfer_bytes_for_sending(pkttransfer_t * pkttransfer_inst_p);
 static uint8_t pkttransfer_prepare_byte(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_complete_tx_bytes(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size);
+static pkttransfer_tx_slot_t* pkttransfer_tx_queue_reserve(pkttransfer_t * pkttransfer_inst_p, size_t size);
+static void pkttransfer_tx_queue_push(pkttransfer_t * pkttransfer_inst_p, pkttransfer_tx_slot_t* slot_p);
+static void pkttransfer_tx_queue_pop(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_tx_queue_load(pkttransfer_t * pkttransfer_inst_p);
+static pkttransfer_tx_slot_t* pkttransfer_tx_queue_head(pkttransfer_t * pkttransfer_inst_p);
+static uint32_t pkttransfer_tx_queue_pos_add(const pkttransfer_t * pkttransfer_inst_p, uint32_t pos, uint32_t n);
+static int32_t pkttransfer_tx_queue_pos_dist(const pkttransfer_t * pkttransfer_inst_p, uint32_t pos_from, uint32_t pos_to);
+static void pkttransfer_tx_seg_load(pkttransfer_t * pkttransfer_inst_p);
+static size_t pkttransfer_prepare_bytes(pkttransfer_t * pkttransfer_inst_p, uint8_t* out_p, size_t out_size);
+#if (defined(PKTTRANSFER_OVER_UART))
+static void pkttransfer_tx_dma_fill(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_tx_dma_try_start(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_rx_dma_process(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_isr_tx_fill(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_isr_rx_process(pkttransfer_t * pkttransfer_inst_p);
+#endif
+static size_t pkttransfer_scan_special(const uint8_t* data_p, size_t size);
+static pkttransfer_swar_word_t pkttransfer_swar_special_mask(pkttransfer_swar_word_t word);
+static size_t pkttransfer_count_special(const uint8_t* data_p, size_t size);
+static bool pkttransfer_encode_bytes(const uint8_t* data_p, size_t size, uint8_t* out_p, size_t out_cap, size_t* out_cnt_p);
+static size_t pkttransfer_crc_trailer(const pkttransfer_crc_itf_t* crc_itf_p, const uint8_t* data_p, size_t size, uint8_t* crc_buf_p);
+static void pkttransfer_store_tx_crc(pkttransfer_t * pkttransfer_inst_p);
 static void pkttransfer_process_byte(pkttransfer_t * pkttransfer_inst_p, uint8_t byte);
 static void pkttransfer_process_frame(pkttransfer_t * pkttransfer_inst_p);
+static size_t pkttransfer_process_bytes(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size);
+static void pkttransfer_store_rx_bytes(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size);
+static void pkttransfer_rx_buf_acquire(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_group_mark(pkttransfer_t * pkttransfer_inst_p, bool is_tx);
+static bool pkttransfer_task_tx_run(pkttransfer_t * pkttransfer_inst_p);
+static bool pkttransfer_task_rx_run(pkttransfer_t * pkttransfer_inst_p);
+#if (defined(PKTTRANSFER_OVER_CAN))
+static size_t pkttransfer_can_fd_dlc_size(size_t size);
+static void pkttransfer_rx_channels_sort(pkttransfer_t * pkttransfer_inst_p);
+static pkttransfer_rx_channel_t* pkttransfer_rx_channel_find(pkttransfer_t * pkttransfer_inst_p, uint32_t can_id);
+static void pkttransfer_rx_channel_process(pkttransfer_t * pkttransfer_inst_p, pkttransfer_rx_channel_t* channel_p, const uint8_t* data_p, size_t size);
+static size_t pkttransfer_isotp_prepare_msg(pkttransfer_t * pkttransfer_inst_p, uint8_t* out_p, uint32_t* can_id_tx_p);
+static void pkttransfer_isotp_copy_tx_bytes(pkttransfer_t * pkttransfer_inst_p, uint8_t* out_p, size_t size);
+static void pkttransfer_isotp_tx_end(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_isotp_take_fc(pkttransfer_t * pkttransfer_inst_p);
+static void pkttransfer_isotp_post_fc(pkttransfer_t * pkttransfer_inst_p, uint8_t fc_status);
+static void pkttransfer_isotp_process_msg(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size);
+static bool pkttransfer_isotp_rx_start(pkttransfer_t * pkttransfer_inst_p, size_t len);
+static void pkttransfer_isotp_store_rx_bytes(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size);
+#endif
+
+static uint32_t pkttransfer_crc_init(const pkttransfer_t * pkttransfer_inst_p);
+static uint32_t pkttransfer_crc_update(const pkttransfer_t * pkttransfer_inst_p, uint32_t crc, const uint8_t* data_p, size_t size);
+static uint32_t pkttransfer_crc_final(const pkttransfer_t * pkttransfer_inst_p, uint32_t crc);
+
+static uint32_t pkttransfer_crc16_init_cb(const void * crc_p);
+static uint32_t pkttransfer_crc16_update_cb(const void * crc_p, uint32_t crc, const uint8_t* data_p, size_t size);
+static uint32_t pkttransfer_crc16_final_cb(const void * crc_p, uint32_t crc);
+
+static uint32_t pkttransfer_crc32c_init_cb(const void * crc_p);
+static uint32_t pkttransfer_crc32c_update_cb(const void * crc_p, uint32_t crc, const uint8_t* data_p, size_t size);
+static uint32_t pkttransfer_crc32c_final_cb(const void * crc_p, uint32_t crc);
+
+static uint16_t pkttransfer_crc16_update(uint16_t crc, const uint8_t* data_p, size_t size);
+static uint16_t pkttransfer_crc16_update_byte(uint16_t crc, uint8_t byte);
+
+#if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_BITWISE)
+static uint16_t pkttransfer_crc16_update_bitwise(uint16_t crc, const uint8_t* data_p, size_t size);
+#endif
+#if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_TABLE)
+static uint16_t pkttransfer_crc16_update_table(uint16_t crc, const uint8_t* data_p, size_t size);
+#endif
+#if (PKTTRANSFER_CRC16_TABLES_NUM == 8)
+static uint16_t pkttransfer_crc16_update_slice8(uint16_t crc, const uint8_t* data_p, size_t size);
+#endif
+#if (defined(PKTTRANSFER_CRC16_USE_CLMUL_X86))
+static uint16_t pkttransfer_crc16_update_clmul_x86(uint16_t crc, const uint8_t* data_p, size_t size);
+static uint16_t pkttransfer_crc16_update_resolve(uint16_t crc, const uint8_t* data_p, size_t size);
+#endif
+
+static uint32_t pkttransfer_crc32c_update(uint32_t crc, const uint8_t* data_p, size_t size);
+static uint32_t pkttransfer_crc32c_update_table(uint32_t crc, const uint8_t* data_p, size_t size);
+#if (defined(PKTTRANSFER_CRC32C_USE_SSE42_X86))
+static uint32_t pkttransfer_crc32c_update_sse42_x86(uint32_t crc, const uint8_t* data_p, size_t size);
+static uint32_t pkttransfer_crc32c_update_resolve(uint32_t crc, const uint8_t* data_p, size_t size);
+#endif
 
 //==================================================================================================
 //==================================== PRIVATE STATIC DATA =========================================
 //==================================================================================================
 
+//-----------------------------------------------------------------------------
+// Block CRC kernels for large buffers
+//
+// Start as resolvers which check CPU features on first call and replace
+// themselves with selected kernel. Every thread stores the same value, so
+// relaxed accesses are enough.
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_CRC16_USE_CLMUL_X86))
+static _Atomic(pkttransfer_crc16_kernel_t) pkttransfer_crc16_block_kernel = pkttransfer_crc16_update_resolve;
+#endif
+#if (defined(PKTTRANSFER_CRC32C_USE_SSE42_X86))
+static _Atomic(pkttransfer_crc32c_kernel_t) pkttransfer_crc32c_block_kernel = pkttransfer_crc32c_update_resolve;
+#endif
+
+//-----------------------------------------------------------------------------
+// CRC16 tables (read-only)
+//
+// Table 0:     CRC of each single byte
+// Table K:     CRC of each byte followed by K zero bytes (for slicing-by-8)
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_CRC16_TABLES_NUM))
+static const uint16_t pkttransfer_crc16_table[PKTTRANSFER_CRC16_TABLES_NUM][256] = {
+    {
+        0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
+        0x8C48, 0x9DC1, 0xAF5A, 0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7,
+        0x1081, 0x0108, 0x3393, 0x221A, 0x56A5, 0x472C, 0x75B7, 0x643E,
+        0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF, 0xE876,
+        0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD,
+        0xAD4A, 0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5,
+        0x3183, 0x200A, 0x1291, 0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C,
+        0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF, 0xEA66, 0xD8FD, 0xC974,
+        0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732, 0x36BB,
+        0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3,
+        0x5285, 0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A,
+        0xDECD, 0xCF44, 0xFDDF, 0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72,
+        0x6306, 0x728F, 0x4014, 0x519D, 0x2522, 0x34AB, 0x0630, 0x17B9,
+        0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78, 0x9BF1,
+        0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738,
+        0xFFCF, 0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70,
+        0x8408, 0x9581, 0xA71A, 0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7,
+        0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64, 0x5FED, 0x6D76, 0x7CFF,
+        0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF, 0xE036,
+        0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E,
+        0xA50A, 0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5,
+        0x2942, 0x38CB, 0x0A50, 0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD,
+        0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF, 0xE226, 0xD0BD, 0xC134,
+        0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5, 0x4D7C,
+        0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3,
+        0x4A44, 0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB,
+        0xD68D, 0xC704, 0xF59F, 0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232,
+        0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1, 0x0D68, 0x3FF3, 0x2E7A,
+        0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238, 0x93B1,
+        0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9,
+        0xF78F, 0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330,
+        0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78
+    },
+#if (PKTTRANSFER_CRC16_TABLES_NUM == 8)
+    {
+        0x0000, 0x19D8, 0x33B0, 0x2A68, 0x6760, 0x7EB8, 0x54D0, 0x4D08,
+        0xCEC0, 0xD718, 0xFD70, 0xE4A8, 0xA9A0, 0xB078, 0x9A10, 0x83C8,
+        0x9591, 0x8C49, 0xA621, 0xBFF9, 0xF2F1, 0xEB29, 0xC141, 0xD899,
+        0x5B51, 0x4289, 0x68E1, 0x7139, 0x3C31, 0x25E9, 0x0F81, 0x1659,
+        0x2333, 0x3AEB, 0x1083, 0x095B, 0x4453, 0x5D8B, 0x77E3, 0x6E3B,
+        0xEDF3, 0xF42B, 0xDE43, 0xC79B, 0x8A93, 0x934B, 0xB923, 0xA0FB,
+        0xB6A2, 0xAF7A, 0x8512, 0x9CCA, 0xD1C2, 0xC81A, 0xE272, 0xFBAA,
+        0x7862, 0x61BA, 0x4BD2, 0x520A, 0x1F02, 0x06DA, 0x2CB2, 0x356A,
+        0x4666, 0x5FBE, 0x75D6, 0x6C0E, 0x2106, 0x38DE, 0x12B6, 0x0B6E,
+        0x88A6, 0x917E, 0xBB16, 0xA2CE, 0xEFC6, 0xF61E, 0xDC76, 0xC5AE,
+        0xD3F7, 0xCA2F, 0xE047, 0xF99F, 0xB497, 0xAD4F, 0x8727, 0x9EFF,
+        0x1D37, 0x04EF, 0x2E87, 0x375F, 0x7A57, 0x638F, 0x49E7, 0x503F,
+        0x6555, 0x7C8D, 0x56E5, 0x4F3D, 0x0235, 0x1BED, 0x3185, 0x285D,
+        0xAB95, 0xB24D, 0x9825, 0x81FD, 0xCCF5, 0xD52D, 0xFF45, 0xE69D,
+        0xF0C4, 0xE91C, 0xC374, 0xDAAC, 0x97A4, 0x8E7C, 0xA414, 0xBDCC,
+        0x3E04, 0x27DC, 0x0DB4, 0x146C, 0x5964, 0x40BC, 0x6AD4, 0x730C,
+        0x8CCC, 0x9514, 0xBF7C, 0xA6A4, 0xEBAC, 0xF274, 0xD81C, 0xC1C4,
+        0x420C, 0x5BD4, 0x71BC, 0x6864, 0x256C, 0x3CB4, 0x16DC, 0x0F04,
+        0x195D, 0x0085, 0x2AED, 0x3335, 0x7E3D, 0x67E5, 0x4D8D, 0x5455,
+        0xD79D, 0xCE45, 0xE42D, 0xFDF5, 0xB0FD, 0xA925, 0x834D, 0x9A95,
+        0xAFFF, 0xB627, 0x9C4F, 0x8597, 0xC89F, 0xD147, 0xFB2F, 0xE2F7,
+        0x613F, 0x78E7, 0x528F, 0x4B57, 0x065F, 0x1F87, 0x35EF, 0x2C37,
+        0x3A6E, 0x23B6, 0x09DE, 0x1006, 0x5D0E, 0x44D6, 0x6EBE, 0x7766,
+        0xF4AE, 0xED76, 0xC71E, 0xDEC6, 0x93CE, 0x8A16, 0xA07E, 0xB9A6,
+        0xCAAA, 0xD372, 0xF91A, 0xE0C2, 0xADCA, 0xB412, 0x9E7A, 0x87A2,
+        0x046A, 0x1DB2, 0x37DA, 0x2E02, 0x630A, 0x7AD2, 0x50BA, 0x4962,
+        0x5F3B, 0x46E3, 0x6C8B, 0x7553, 0x385B, 0x2183, 0x0BEB, 0x1233,
+        0x91FB, 0x8823, 0xA24B, 0xBB93, 0xF69B, 0xEF43, 0xC52B, 0xDCF3,
+        0xE999, 0xF041, 0xDA29, 0xC3F1, 0x8EF9, 0x9721, 0xBD49, 0xA491,
+        0x2759, 0x3E81, 0x14E9, 0x0D31, 0x4039, 0x59E1, 0x7389, 0x6A51,
+        0x7C08, 0x65D0, 0x4FB8, 0x5660, 0x1B68, 0x02B0, 0x28D8, 0x3100,
+        0xB2C8, 0xAB10, 0x8178, 0x98A0, 0xD5A8, 0xCC70, 0xE618, 0xFFC0
+    },
+    {
+        0x0000, 0x5ADC, 0xB5B8, 0xEF64, 0x6361, 0x39BD, 0xD6D9, 0x8C05,
+        0xC6C2, 0x9C1E, 0x737A, 0x29A6, 0xA5A3, 0xFF7F, 0x101B, 0x4AC7,
+        0x8595, 0xDF49, 0x302D, 0x6AF1, 0xE6F4, 0xBC28, 0x534C, 0x0990,
+        0x4357, 0x198B, 0xF6EF, 0xAC33, 0x2036, 0x7AEA, 0x958E, 0xCF52,
+        0x033B, 0x59E7, 0xB683, 0xEC5F, 0x605A, 0x3A86, 0xD5E2, 0x8F3E,
+        0xC5F9, 0x9F25, 0x7041, 0x2A9D, 0xA698, 0xFC44, 0x1320, 0x49FC,
+        0x86AE, 0xDC72, 0x3316, 0x69CA, 0xE5CF, 0xBF13, 0x5077, 0x0AAB,
+        0x406C, 0x1AB0, 0xF5D4, 0xAF08, 0x230D, 0x79D1, 0x96B5, 0xCC69,
+        0x0676, 0x5CAA, 0xB3CE, 0xE912, 0x6517, 0x3FCB, 0xD0AF, 0x8A73,
+        0xC0B4, 0x9A68, 0x750C, 0x2FD0, 0xA3D5, 0xF909, 0x166D, 0x4CB1,
+        0x83E3, 0xD93F, 0x365B, 0x6C87, 0xE082, 0xBA5E, 0x553A, 0x0FE6,
+        0x4521, 0x1FFD, 0xF099, 0xAA45, 0x2640, 0x7C9C, 0x93F8, 0xC924,
+        0x054D, 0x5F91, 0xB0F5, 0xEA29, 0x662C, 0x3CF0, 0xD394, 0x8948,
+        0xC38F, 0x9953, 0x7637, 0x2CEB, 0xA0EE, 0xFA32, 0x1556, 0x4F8A,
+        0x80D8, 0xDA04, 0x3560, 0x6FBC, 0xE3B9, 0xB965, 0x5601, 0x0CDD,
+        0x461A, 0x1CC6, 0xF3A2, 0xA97E, 0x257B, 0x7FA7, 0x90C3, 0xCA1F,
+        0x0CEC, 0x5630, 0xB954, 0xE388, 0x6F8D, 0x3551, 0xDA35, 0x80E9,
+        0xCA2E, 0x90F2, 0x7F96, 0x254A, 0xA94F, 0xF393, 0x1CF7, 0x462B,
+        0x8979, 0xD3A5, 0x3CC1, 0x661D, 0xEA18, 0xB0C4, 0x5FA0, 0x057C,
+        0x4FBB, 0x1567, 0xFA03, 0xA0DF, 0x2CDA, 0x7606, 0x9962, 0xC3BE,
+        0x0FD7, 0x550B, 0xBA6F, 0xE0B3, 0x6CB6, 0x366A, 0xD90E, 0x83D2,
+        0xC915, 0x93C9, 0x7CAD, 0x2671, 0xAA74, 0xF0A8, 0x1FCC, 0x4510,
+        0x8A42, 0xD09E, 0x3FFA, 0x6526, 0xE923, 0xB3FF, 0x5C9B, 0x0647,
+        0x4C80, 0x165C, 0xF938, 0xA3E4, 0x2FE1, 0x753D, 0x9A59, 0xC085,
+        0x0A9A, 0x5046, 0xBF22, 0xE5FE, 0x69FB, 0x3327, 0xDC43, 0x869F,
+        0xCC58, 0x9684, 0x79E0, 0x233C, 0xAF39, 0xF5E5, 0x1A81, 0x405D,
+        0x8F0F, 0xD5D3, 0x3AB7, 0x606B, 0xEC6E, 0xB6B2, 0x59D6, 0x030A,
+        0x49CD, 0x1311, 0xFC75, 0xA6A9, 0x2AAC, 0x7070, 0x9F14, 0xC5C8,
+        0x09A1, 0x537D, 0xBC19, 0xE6C5, 0x6AC0, 0x301C, 0xDF78, 0x85A4,
+        0xCF63, 0x95BF, 0x7ADB, 0x2007, 0xAC02, 0xF6DE, 0x19BA, 0x4366,
+        0x8C34, 0xD6E8, 0x398C, 0x6350, 0xEF55, 0xB589, 0x5AED, 0x0031,
+        0x4AF6, 0x102A, 0xFF4E, 0xA592, 0x2997, 0x734B, 0x9C2F, 0xC6F3
+    },
+    {
+        0x0000, 0x1CBB, 0x3976, 0x25CD, 0x72EC, 0x6E57, 0x4B9A, 0x5721,
+        0xE5D8, 0xF963, 0xDCAE, 0xC015, 0x9734, 0x8B8F, 0xAE42, 0xB2F9,
+        0xC3A1, 0xDF1A, 0xFAD7, 0xE66C, 0xB14D, 0xADF6, 0x883B, 0x9480,
+        0x2679, 0x3AC2, 0x1F0F, 0x03B4, 0x5495, 0x482E, 0x6DE3, 0x7158,
+        0x8F53, 0x93E8, 0xB625, 0xAA9E, 0xFDBF, 0xE104, 0xC4C9, 0xD872,
+        0x6A8B, 0x7630, 0x53FD, 0x4F46, 0x1867, 0x04DC, 0x2111, 0x3DAA,
+        0x4CF2, 0x5049, 0x7584, 0x693F, 0x3E1E, 0x22A5, 0x0768, 0x1BD3,
+        0xA92A, 0xB591, 0x905C, 0x8CE7, 0xDBC6, 0xC77D, 0xE2B0, 0xFE0B,
+        0x16B7, 0x0A0C, 0x2FC1, 0x337A, 0x645B, 0x78E0, 0x5D2D, 0x4196,
+        0xF36F, 0xEFD4, 0xCA19, 0xD6A2, 0x8183, 0x9D38, 0xB8F5, 0xA44E,
+        0xD516, 0xC9AD, 0xEC60, 0xF0DB, 0xA7FA, 0xBB41, 0x9E8C, 0x8237,
+        0x30CE, 0x2C75, 0x09B8, 0x1503, 0x4222, 0x5E99, 0x7B54, 0x67EF,
+        0x99E4, 0x855F, 0xA092, 0xBC29, 0xEB08, 0xF7B3, 0xD27E, 0xCEC5,
+        0x7C3C, 0x6087, 0x454A, 0x59F1, 0x0ED0, 0x126B, 0x37A6, 0x2B1D,
+        0x5A45, 0x46FE, 0x6333, 0x7F88, 0x28A9, 0x3412, 0x11DF, 0x0D64,
+        0xBF9D, 0xA326, 0x86EB, 0x9A50, 0xCD71, 0xD1CA, 0xF407, 0xE8BC,
+        0x2D6E, 0x31D5, 0x1418, 0x08A3, 0x5F82, 0x4339, 0x66F4, 0x7A4F,
+        0xC8B6, 0xD40D, 0xF1C0, 0xED7B, 0xBA5A, 0xA6E1, 0x832C, 0x9F97,
+        0xEECF, 0xF274, 0xD7B9, 0xCB02, 0x9C23, 0x8098, 0xA555, 0xB9EE,
+        0x0B17, 0x17AC, 0x3261, 0x2EDA, 0x79FB, 0x6540, 0x408D, 0x5C36,
+        0xA23D, 0xBE86, 0x9B4B, 0x87F0, 0xD0D1, 0xCC6A, 0xE9A7, 0xF51C,
+        0x47E5, 0x5B5E, 0x7E93, 0x6228, 0x3509, 0x29B2, 0x0C7F, 0x10C4,
+        0x619C, 0x7D27, 0x58EA, 0x4451, 0x1370, 0x0FCB, 0x2A06, 0x36BD,
+        0x8444, 0x98FF, 0xBD32, 0xA189, 0xF6A8, 0xEA13, 0xCFDE, 0xD365,
+        0x3BD9, 0x2762, 0x02AF, 0x1E14, 0x4935, 0x558E, 0x7043, 0x6CF8,
+        0xDE01, 0xC2BA, 0xE777, 0xFBCC, 0xACED, 0xB056, 0x959B, 0x8920,
+        0xF878, 0xE4C3, 0xC10E, 0xDDB5, 0x8A94, 0x962F, 0xB3E2, 0xAF59,
+        0x1DA0, 0x011B, 0x24D6, 0x386D, 0x6F4C, 0x73F7, 0x563A, 0x4A81,
+        0xB48A, 0xA831, 0x8DFC, 0x9147, 0xC666, 0xDADD, 0xFF10, 0xE3AB,
+        0x5152, 0x4DE9, 0x6824, 0x749F, 0x23BE, 0x3F05, 0x1AC8, 0x0673,
+        0x772B, 0x6B90, 0x4E5D, 0x52E6, 0x05C7, 0x197C, 0x3CB1, 0x200A,
+        0x92F3, 0x8E48, 0xAB85, 0xB73E, 0xE01F, 0xFCA4, 0xD969, 0xC5D2
+    },
+    {
+        0x0000, 0x0B44, 0x1688, 0x1DCC, 0x2D10, 0x2654, 0x3B98, 0x30DC,
+        0x5A20, 0x5164, 0x4CA8, 0x47EC, 0x7730, 0x7C74, 0x61B8, 0x6AFC,
+        0xB440, 0xBF04, 0xA2C8, 0xA98C, 0x9950, 0x9214, 0x8FD8, 0x849C,
+        0xEE60, 0xE524, 0xF8E8, 0xF3AC, 0xC370, 0xC834, 0xD5F8, 0xDEBC,
+        0x6091, 0x6BD5, 0x7619, 0x7D5D, 0x4D81, 0x46C5, 0x5B09, 0x504D,
+        0x3AB1, 0x31F5, 0x2C39, 0x277D, 0x17A1, 0x1CE5, 0x0129, 0x0A6D,
+        0xD4D1, 0xDF95, 0xC259, 0xC91D, 0xF9C1, 0xF285, 0xEF49, 0xE40D,
+        0x8EF1, 0x85B5, 0x9879, 0x933D, 0xA3E1, 0xA8A5, 0xB569, 0xBE2D,
+        0xC122, 0xCA66, 0xD7AA, 0xDCEE, 0xEC32, 0xE776, 0xFABA, 0xF1FE,
+        0x9B02, 0x9046, 0x8D8A, 0x86CE, 0xB612, 0xBD56, 0xA09A, 0xABDE,
+        0x7562, 0x7E26, 0x63EA, 0x68AE, 0x5872, 0x5336, 0x4EFA, 0x45BE,
+        0x2F42, 0x2406, 0x39CA, 0x328E, 0x0252, 0x0916, 0x14DA, 0x1F9E,
+        0xA1B3, 0xAAF7, 0xB73B, 0xBC7F, 0x8CA3, 0x87E7, 0x9A2B, 0x916F,
+        0xFB93, 0xF0D7, 0xED1B, 0xE65F, 0xD683, 0xDDC7, 0xC00B, 0xCB4F,
+        0x15F3, 0x1EB7, 0x037B, 0x083F, 0x38E3, 0x33A7, 0x2E6B, 0x252F,
+        0x4FD3, 0x4497, 0x595B, 0x521F, 0x62C3, 0x6987, 0x744B, 0x7F0F,
+        0x8A55, 0x8111, 0x9CDD, 0x9799, 0xA745, 0xAC01, 0xB1CD, 0xBA89,
+        0xD075, 0xDB31, 0xC6FD, 0xCDB9, 0xFD65, 0xF621, 0xEBED, 0xE0A9,
+        0x3E15, 0x3551, 0x289D, 0x23D9, 0x1305, 0x1841, 0x058D, 0x0EC9,
+        0x6435, 0x6F71, 0x72BD, 0x79F9, 0x4925, 0x4261, 0x5FAD, 0x54E9,
+        0xEAC4, 0xE180, 0xFC4C, 0xF708, 0xC7D4, 0xCC90, 0xD15C, 0xDA18,
+        0xB0E4, 0xBBA0, 0xA66C, 0xAD28, 0x9DF4, 0x96B0, 0x8B7C, 0x8038,
+        0x5E84, 0x55C0, 0x480C, 0x4348, 0x7394, 0x78D0, 0x651C, 0x6E58,
+        0x04A4, 0x0FE0, 0x122C, 0x1968, 0x29B4, 0x22F0, 0x3F3C, 0x3478,
+        0x4B77, 0x4033, 0x5DFF, 0x56BB, 0x6667, 0x6D23, 0x70EF, 0x7BAB,
+        0x1157, 0x1A13, 0x07DF, 0x0C9B, 0x3C47, 0x3703, 0x2ACF, 0x218B,
+        0xFF37, 0xF473, 0xE9BF, 0xE2FB, 0xD227, 0xD963, 0xC4AF, 0xCFEB,
+        0xA517, 0xAE53, 0xB39F, 0xB8DB, 0x8807, 0x8343, 0x9E8F, 0x95CB,
+        0x2BE6, 0x20A2, 0x3D6E, 0x362A, 0x06F6, 0x0DB2, 0x107E, 0x1B3A,
+        0x71C6, 0x7A82, 0x674E, 0x6C0A, 0x5CD6, 0x5792, 0x4A5E, 0x411A,
+        0x9FA6, 0x94E2, 0x892E, 0x826A, 0xB2B6, 0xB9F2, 0xA43E, 0xAF7A,
+        0xC586, 0xCEC2, 0xD30E, 0xD84A, 0xE896, 0xE3D2, 0xFE1E, 0xF55A
+    },
+    {
+        0x0000, 0x042B, 0x0856, 0x0C7D, 0x10AC, 0x1487, 0x18FA, 0x1CD1,
+        0x2158, 0x2573, 0x290E, 0x2D25, 0x31F4, 0x35DF, 0x39A2, 0x3D89,
+        0x42B0, 0x469B, 0x4AE6, 0x4ECD, 0x521C, 0x5637, 0x5A4A, 0x5E61,
+        0x63E8, 0x67C3, 0x6BBE, 0x6F95, 0x7344, 0x776F, 0x7B12, 0x7F39,
+        0x8560, 0x814B, 0x8D36, 0x891D, 0x95CC, 0x91E7, 0x9D9A, 0x99B1,
+        0xA438, 0xA013, 0xAC6E, 0xA845, 0xB494, 0xB0BF, 0xBCC2, 0xB8E9,
+        0xC7D0, 0xC3FB, 0xCF86, 0xCBAD, 0xD77C, 0xD357, 0xDF2A, 0xDB01,
+        0xE688, 0xE2A3, 0xEEDE, 0xEAF5, 0xF624, 0xF20F, 0xFE72, 0xFA59,
+        0x02D1, 0x06FA, 0x0A87, 0x0EAC, 0x127D, 0x1656, 0x1A2B, 0x1E00,
+        0x2389, 0x27A2, 0x2BDF, 0x2FF4, 0x3325, 0x370E, 0x3B73, 0x3F58,
+        0x4061, 0x444A, 0x4837, 0x4C1C, 0x50CD, 0x54E6, 0x589B, 0x5CB0,
+        0x6139, 0x6512, 0x696F, 0x6D44, 0x7195, 0x75BE, 0x79C3, 0x7DE8,
+        0x87B1, 0x839A, 0x8FE7, 0x8BCC, 0x971D, 0x9336, 0x9F4B, 0x9B60,
+        0xA6E9, 0xA2C2, 0xAEBF, 0xAA94, 0xB645, 0xB26E, 0xBE13, 0xBA38,
+        0xC501, 0xC12A, 0xCD57, 0xC97C, 0xD5AD, 0xD186, 0xDDFB, 0xD9D0,
+        0xE459, 0xE072, 0xEC0F, 0xE824, 0xF4F5, 0xF0DE, 0xFCA3, 0xF888,
+        0x05A2, 0x0189, 0x0DF4, 0x09DF, 0x150E, 0x1125, 0x1D58, 0x1973,
+        0x24FA, 0x20D1, 0x2CAC, 0x2887, 0x3456, 0x307D, 0x3C00, 0x382B,
+        0x4712, 0x4339, 0x4F44, 0x4B6F, 0x57BE, 0x5395, 0x5FE8, 0x5BC3,
+        0x664A, 0x6261, 0x6E1C, 0x6A37, 0x76E6, 0x72CD, 0x7EB0, 0x7A9B,
+        0x80C2, 0x84E9, 0x8894, 0x8CBF, 0x906E, 0x9445, 0x9838, 0x9C13,
+        0xA19A, 0xA5B1, 0xA9CC, 0xADE7, 0xB136, 0xB51D, 0xB960, 0xBD4B,
+        0xC272, 0xC659, 0xCA24, 0xCE0F, 0xD2DE, 0xD6F5, 0xDA88, 0xDEA3,
+        0xE32A, 0xE701, 0xEB7C, 0xEF57, 0xF386, 0xF7AD, 0xFBD0, 0xFFFB,
+        0x0773, 0x0358, 0x0F25, 0x0B0E, 0x17DF, 0x13F4, 0x1F89, 0x1BA2,
+        0x262B, 0x2200, 0x2E7D, 0x2A56, 0x3687, 0x32AC, 0x3ED1, 0x3AFA,
+        0x45C3, 0x41E8, 0x4D95, 0x49BE, 0x556F, 0x5144, 0x5D39, 0x5912,
+        0x649B, 0x60B0, 0x6CCD, 0x68E6, 0x7437, 0x701C, 0x7C61, 0x784A,
+        0x8213, 0x8638, 0x8A45, 0x8E6E, 0x92BF, 0x9694, 0x9AE9, 0x9EC2,
+        0xA34B, 0xA760, 0xAB1D, 0xAF36, 0xB3E7, 0xB7CC, 0xBBB1, 0xBF9A,
+        0xC0A3, 0xC488, 0xC8F5, 0xCCDE, 0xD00F, 0xD424, 0xD859, 0xDC72,
+        0xE1FB, 0xE5D0, 0xE9AD, 0xED86, 0xF157, 0xF57C, 0xF901, 0xFD2A
+    },
+    {
+        0x0000, 0x9FD5, 0x37BB, 0xA86E, 0x6F76, 0xF0A3, 0x58CD, 0xC718,
+        0xDEEC, 0x4139, 0xE957, 0x7682, 0xB19A, 0x2E4F, 0x8621, 0x19F4,
+        0xB5C9, 0x2A1C, 0x8272, 0x1DA7, 0xDABF, 0x456A, 0xED04, 0x72D1,
+        0x6B25, 0xF4F0, 0x5C9E, 0xC34B, 0x0453, 0x9B86, 0x33E8, 0xAC3D,
+        0x6383, 0xFC56, 0x5438, 0xCBED, 0x0CF5, 0x9320, 0x3B4E, 0xA49B,
+        0xBD6F, 0x22BA, 0x8AD4, 0x1501, 0xD219, 0x4DCC, 0xE5A2, 0x7A77,
+        0xD64A, 0x499F, 0xE1F1, 0x7E24, 0xB93C, 0x26E9, 0x8E87, 0x1152,
+        0x08A6, 0x9773, 0x3F1D, 0xA0C8, 0x67D0, 0xF805, 0x506B, 0xCFBE,
+        0xC706, 0x58D3, 0xF0BD, 0x6F68, 0xA870, 0x37A5, 0x9FCB, 0x001E,
+        0x19EA, 0x863F, 0x2E51, 0xB184, 0x769C, 0xE949, 0x4127, 0xDEF2,
+        0x72CF, 0xED1A, 0x4574, 0xDAA1, 0x1DB9, 0x826C, 0x2A02, 0xB5D7,
+        0xAC23, 0x33F6, 0x9B98, 0x044D, 0xC355, 0x5C80, 0xF4EE, 0x6B3B,
+        0xA485, 0x3B50, 0x933E, 0x0CEB, 0xCBF3, 0x5426, 0xFC48, 0x639D,
+        0x7A69, 0xE5BC, 0x4DD2, 0xD207, 0x151F, 0x8ACA, 0x22A4, 0xBD71,
+        0x114C, 0x8E99, 0x26F7, 0xB922, 0x7E3A, 0xE1EF, 0x4981, 0xD654,
+        0xCFA0, 0x5075, 0xF81B, 0x67CE, 0xA0D6, 0x3F03, 0x976D, 0x08B8,
+        0x861D, 0x19C8, 0xB1A6, 0x2E73, 0xE96B, 0x76BE, 0xDED0, 0x4105,
+        0x58F1, 0xC724, 0x6F4A, 0xF09F, 0x3787, 0xA852, 0x003C, 0x9FE9,
+        0x33D4, 0xAC01, 0x046F, 0x9BBA, 0x5CA2, 0xC377, 0x6B19, 0xF4CC,
+        0xED38, 0x72ED, 0xDA83, 0x4556, 0x824E, 0x1D9B, 0xB5F5, 0x2A20,
+        0xE59E, 0x7A4B, 0xD225, 0x4DF0, 0x8AE8, 0x153D, 0xBD53, 0x2286,
+        0x3B72, 0xA4A7, 0x0CC9, 0x931C, 0x5404, 0xCBD1, 0x63BF, 0xFC6A,
+        0x5057, 0xCF82, 0x67EC, 0xF839, 0x3F21, 0xA0F4, 0x089A, 0x974F,
+        0x8EBB, 0x116E, 0xB900, 0x26D5, 0xE1CD, 0x7E18, 0xD676, 0x49A3,
+        0x411B, 0xDECE, 0x76A0, 0xE975, 0x2E6D, 0xB1B8, 0x19D6, 0x8603,
+        0x9FF7, 0x0022, 0xA84C, 0x3799, 0xF081, 0x6F54, 0xC73A, 0x58EF,
+        0xF4D2, 0x6B07, 0xC369, 0x5CBC, 0x9BA4, 0x0471, 0xAC1F, 0x33CA,
+        0x2A3E, 0xB5EB, 0x1D85, 0x8250, 0x4548, 0xDA9D, 0x72F3, 0xED26,
+        0x2298, 0xBD4D, 0x1523, 0x8AF6, 0x4DEE, 0xD23B, 0x7A55, 0xE580,
+        0xFC74, 0x63A1, 0xCBCF, 0x541A, 0x9302, 0x0CD7, 0xA4B9, 0x3B6C,
+        0x9751, 0x0884, 0xA0EA, 0x3F3F, 0xF827, 0x67F2, 0xCF9C, 0x5049,
+        0x49BD, 0xD668, 0x7E06, 0xE1D3, 0x26CB, 0xB91E, 0x1170, 0x8EA5
+    },
+    {
+        0x0000, 0x81BF, 0x0B6F, 0x8AD0, 0x16DE, 0x9761, 0x1DB1, 0x9C0E,
+        0x2DBC, 0xAC03, 0x26D3, 0xA76C, 0x3B62, 0xBADD, 0x300D, 0xB1B2,
+        0x5B78, 0xDAC7, 0x5017, 0xD1A8, 0x4DA6, 0xCC19, 0x46C9, 0xC776,
+        0x76C4, 0xF77B, 0x7DAB, 0xFC14, 0x601A, 0xE1A5, 0x6B75, 0xEACA,
+        0xB6F0, 0x374F, 0xBD9F, 0x3C20, 0xA02E, 0x2191, 0xAB41, 0x2AFE,
+        0x9B4C, 0x1AF3, 0x9023, 0x119C, 0x8D92, 0x0C2D, 0x86FD, 0x0742,
+        0xED88, 0x6C37, 0xE6E7, 0x6758, 0xFB56, 0x7AE9, 0xF039, 0x7186,
+        0xC034, 0x418B, 0xCB5B, 0x4AE4, 0xD6EA, 0x5755, 0xDD85, 0x5C3A,
+        0x65F1, 0xE44E, 0x6E9E, 0xEF21, 0x732F, 0xF290, 0x7840, 0xF9FF,
+        0x484D, 0xC9F2, 0x4322, 0xC29D, 0x5E93, 0xDF2C, 0x55FC, 0xD443,
+        0x3E89, 0xBF36, 0x35E6, 0xB459, 0x2857, 0xA9E8, 0x2338, 0xA287,
+        0x1335, 0x928A, 0x185A, 0x99E5, 0x05EB, 0x8454, 0x0E84, 0x8F3B,
+        0xD301, 0x52BE, 0xD86E, 0x59D1, 0xC5DF, 0x4460, 0xCEB0, 0x4F0F,
+        0xFEBD, 0x7F02, 0xF5D2, 0x746D, 0xE863, 0x69DC, 0xE30C, 0x62B3,
+        0x8879, 0x09C6, 0x8316, 0x02A9, 0x9EA7, 0x1F18, 0x95C8, 0x1477,
+        0xA5C5, 0x247A, 0xAEAA, 0x2F15, 0xB31B, 0x32A4, 0xB874, 0x39CB,
+        0xCBE2, 0x4A5D, 0xC08D, 0x4132, 0xDD3C, 0x5C83, 0xD653, 0x57EC,
+        0xE65E, 0x67E1, 0xED31, 0x6C8E, 0xF080, 0x713F, 0xFBEF, 0x7A50,
+        0x909A, 0x1125, 0x9BF5, 0x1A4A, 0x8644, 0x07FB, 0x8D2B, 0x0C94,
+        0xBD26, 0x3C99, 0xB649, 0x37F6, 0xABF8, 0x2A47, 0xA097, 0x2128,
+        0x7D12, 0xFCAD, 0x767D, 0xF7C2, 0x6BCC, 0xEA73, 0x60A3, 0xE11C,
+        0x50AE, 0xD111, 0x5BC1, 0xDA7E, 0x4670, 0xC7CF, 0x4D1F, 0xCCA0,
+        0x266A, 0xA7D5, 0x2D05, 0xACBA, 0x30B4, 0xB10B, 0x3BDB, 0xBA64,
+        0x0BD6, 0x8A69, 0x00B9, 0x8106, 0x1D08, 0x9CB7, 0x1667, 0x97D8,
+        0xAE13, 0x2FAC, 0xA57C, 0x24C3, 0xB8CD, 0x3972, 0xB3A2, 0x321D,
+        0x83AF, 0x0210, 0x88C0, 0x097F, 0x9571, 0x14CE, 0x9E1E, 0x1FA1,
+        0xF56B, 0x74D4, 0xFE04, 0x7FBB, 0xE3B5, 0x620A, 0xE8DA, 0x6965,
+        0xD8D7, 0x5968, 0xD3B8, 0x5207, 0xCE09, 0x4FB6, 0xC566, 0x44D9,
+        0x18E3, 0x995C, 0x138C, 0x9233, 0x0E3D, 0x8F82, 0x0552, 0x84ED,
+        0x355F, 0xB4E0, 0x3E30, 0xBF8F, 0x2381, 0xA23E, 0x28EE, 0xA951,
+        0x439B, 0xC224, 0x48F4, 0xC94B, 0x5545, 0xD4FA, 0x5E2A, 0xDF95,
+        0x6E27, 0xEF98, 0x6548, 0xE4F7, 0x78F9, 0xF946, 0x7396, 0xF229
+    },
+#endif
+};
+#endif
+
+//-----------------------------------------------------------------------------
+// CRC-32C table (read-only)
+//-----------------------------------------------------------------------------
+static const uint32_t pkttransfer_crc32c_table[256] = {
+    0x00000000U, 0xF26B8303U, 0xE13B70F7U, 0x1350F3F4U,
+    0xC79A971FU, 0x35F1141CU, 0x26A1E7E8U, 0xD4CA64EBU,
+    0x8AD958CFU, 0x78B2DBCCU, 0x6BE22838U, 0x9989AB3BU,
+    0x4D43CFD0U, 0xBF284CD3U, 0xAC78BF27U, 0x5E133C24U,
+    0x105EC76FU, 0xE235446CU, 0xF165B798U, 0x030E349BU,
+    0xD7C45070U, 0x25AFD373U, 0x36FF2087U, 0xC494A384U,
+    0x9A879FA0U, 0x68EC1CA3U, 0x7BBCEF57U, 0x89D76C54U,
+    0x5D1D08BFU, 0xAF768BBCU, 0xBC267848U, 0x4E4DFB4BU,
+    0x20BD8EDEU, 0xD2D60DDDU, 0xC186FE29U, 0x33ED7D2AU,
+    0xE72719C1U, 0x154C9AC2U, 0x061C6936U, 0xF477EA35U,
+    0xAA64D611U, 0x580F5512U, 0x4B5FA6E6U, 0xB93425E5U,
+    0x6DFE410EU, 0x9F95C20DU, 0x8CC531F9U, 0x7EAEB2FAU,
+    0x30E349B1U, 0xC288CAB2U, 0xD1D83946U, 0x23B3BA45U,
+    0xF779DEAEU, 0x05125DADU, 0x1642AE59U, 0xE4292D5AU,
+    0xBA3A117EU, 0x4851927DU, 0x5B016189U, 0xA96AE28AU,
+    0x7DA08661U, 0x8FCB0562U, 0x9C9BF696U, 0x6EF07595U,
+    0x417B1DBCU, 0xB3109EBFU, 0xA0406D4BU, 0x522BEE48U,
+    0x86E18AA3U, 0x748A09A0U, 0x67DAFA54U, 0x95B17957U,
+    0xCBA24573U, 0x39C9C670U, 0x2A993584U, 0xD8F2B687U,
+    0x0C38D26CU, 0xFE53516FU, 0xED03A29BU, 0x1F682198U,
+    0x5125DAD3U, 0xA34E59D0U, 0xB01EAA24U, 0x42752927U,
+    0x96BF4DCCU, 0x64D4CECFU, 0x77843D3BU, 0x85EFBE38U,
+    0xDBFC821CU, 0x2997011FU, 0x3AC7F2EBU, 0xC8AC71E8U,
+    0x1C661503U, 0xEE0D9600U, 0xFD5D65F4U, 0x0F36E6F7U,
+    0x61C69362U, 0x93AD1061U, 0x80FDE395U, 0x72966096U,
+    0xA65C047DU, 0x5437877EU, 0x4767748AU, 0xB50CF789U,
+    0xEB1FCBADU, 0x197448AEU, 0x0A24BB5AU, 0xF84F3859U,
+    0x2C855CB2U, 0xDEEEDFB1U, 0xCDBE2C45U, 0x3FD5AF46U,
+    0x7198540DU, 0x83F3D70EU, 0x90A324FAU, 0x62C8A7F9U,
+    0xB602C312U, 0x44694011U, 0x5739B3E5U, 0xA55230E6U,
+    0xFB410CC2U, 0x092A8FC1U, 0x1A7A7C35U, 0xE811FF36U,
+    0x3CDB9BDDU, 0xCEB018DEU, 0xDDE0EB2AU, 0x2F8B6829U,
+    0x82F63B78U, 0x709DB87BU, 0x63CD4B8FU, 0x91A6C88CU,
+    0x456CAC67U, 0xB7072F64U, 0xA457DC90U, 0x563C5F93U,
+    0x082F63B7U, 0xFA44E0B4U, 0xE9141340U, 0x1B7F9043U,
+    0xCFB5F4A8U, 0x3DDE77ABU, 0x2E8E845FU, 0xDCE5075CU,
+    0x92A8FC17U, 0x60C37F14U, 0x73938CE0U, 0x81F80FE3U,
+    0x55326B08U, 0xA759E80BU, 0xB4091BFFU, 0x466298FCU,
+    0x1871A4D8U, 0xEA1A27DBU, 0xF94AD42FU, 0x0B21572CU,
+    0xDFEB33C7U, 0x2D80B0C4U, 0x3ED04330U, 0xCCBBC033U,
+    0xA24BB5A6U, 0x502036A5U, 0x4370C551U, 0xB11B4652U,
+    0x65D122B9U, 0x97BAA1BAU, 0x84EA524EU, 0x7681D14DU,
+    0x2892ED69U, 0xDAF96E6AU, 0xC9A99D9EU, 0x3BC21E9DU,
+    0xEF087A76U, 0x1D63F975U, 0x0E330A81U, 0xFC588982U,
+    0xB21572C9U, 0x407EF1CAU, 0x532E023EU, 0xA145813DU,
+    0x758FE5D6U, 0x87E466D5U, 0x94B49521U, 0x66DF1622U,
+    0x38CC2A06U, 0xCAA7A905U, 0xD9F75AF1U, 0x2B9CD9F2U,
+    0xFF56BD19U, 0x0D3D3E1AU, 0x1E6DCDEEU, 0xEC064EEDU,
+    0xC38D26C4U, 0x31E6A5C7U, 0x22B65633U, 0xD0DDD530U,
+    0x0417B1DBU, 0xF67C32D8U, 0xE52CC12CU, 0x1747422FU,
+    0x49547E0BU, 0xBB3FFD08U, 0xA86F0EFCU, 0x5A048DFFU,
+    0x8ECEE914U, 0x7CA56A17U, 0x6FF599E3U, 0x9D9E1AE0U,
+    0xD3D3E1ABU, 0x21B862A8U, 0x32E8915CU, 0xC083125FU,
+    0x144976B4U, 0xE622F5B7U, 0xF5720643U, 0x07198540U,
+    0x590AB964U, 0xAB613A67U, 0xB831C993U, 0x4A5A4A90U,
+    0x9E902E7BU, 0x6CFBAD78U, 0x7FAB5E8CU, 0x8DC0DD8FU,
+    0xE330A81AU, 0x115B2B19U, 0x020BD8EDU, 0xF0605BEEU,
+    0x24AA3F05U, 0xD6C1BC06U, 0xC5914FF2U, 0x37FACCF1U,
+    0x69E9F0D5U, 0x9B8273D6U, 0x88D28022U, 0x7AB90321U,
+    0xAE7367CAU, 0x5C18E4C9U, 0x4F48173DU, 0xBD23943EU,
+    0xF36E6F75U, 0x0105EC76U, 0x12551F82U, 0xE03E9C81U,
+    0x34F4F86AU, 0xC69F7B69U, 0xD5CF889DU, 0x27A40B9EU,
+    0x79B737BAU, 0x8BDCB4B9U, 0x988C474DU, 0x6AE7C44EU,
+    0xBE2DA0A5U, 0x4C4623A6U, 0x5F16D052U, 0xAD7D5351U,
+};
+
 //==================================================================================================
 //======================================== PUBLIC DATA =============================================
 //==================================================================================================
 
+//-----------------------------------------------------------------------------
+// Built-in CRC engines
+//-----------------------------------------------------------------------------
+const pkttransfer_crc_itf_t pkttransfer_crc16_itf = {
+    .crc_p = NULL,
+    .init_cb = pkttransfer_crc16_init_cb,
+    .update_cb = pkttransfer_crc16_update_cb,
+    .final_cb = pkttransfer_crc16_final_cb,
+    .size = PKTTRANSFER_FRAME_CRC_SIZE,
+};
+
+const pkttransfer_crc_itf_t pkttransfer_crc32c_itf = {
+    .crc_p = NULL,
+    .init_cb = pkttransfer_crc32c_init_cb,
+    .update_cb = pkttransfer_crc32c_update_cb,
+    .final_cb = pkttransfer_crc32c_final_cb,
+    .size = PKTTRANSFER_CRC32C_SIZE,
+};
+
 //==================================================================================================
 //=============================== PRIVATE FUNCTIONS DEFINITIONS ====================================
 //==================================================================================================
@@ -53,6 +658,22 @@ static bool pkttransfer_bytes_for_sending(pkttransfer_t * pkttransfer_inst_p)
 
     assert(state_p->tx_size >= state_p->sent_size);
 
+#if (defined(PKTTRANSFER_OVER_CAN))
+    // Flow control received by RX half can resume or abort packet being sent
+    pkttransfer_isotp_take_fc(pkttransfer_inst_p);
+#endif
+
+    // Packets are queued by senders, task starts the next one
+    if (state_p->tx_size == 0) {
+        pkttransfer_tx_queue_load(pkttransfer_inst_p);
+    }
+
+#if (defined(PKTTRANSFER_OVER_CAN))
+    if (atomic_load(&state_p->isotp_fc_out) != 0) {
+        return true;
+    }
+#endif
+
     return (state_p->tx_size != 0);
 }
 
@@ -72,25 +693,34 @@ static uint8_t pkttransfer_prepare_byte(pkttransfer_t * pkttransfer_inst_p)
     pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
     pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
 
-    assert((state_p->tx_size != 0) && (state_p->tx_size <= config_p->payload_size_max + PKTTRANSFER_FRAME_CRC_SIZE));
+    assert((state_p->tx_size != 0) && (state_p->tx_size <= config_p->payload_size_max + state_p->crc_size));
     assert(state_p->tx_size >= state_p->sent_size);
+    (void)config_p;
 
-    // If the last byte is already prepared
+    // If the last byte is already prepared - start the next packet from queue
     if (state_p->sent_size == state_p->tx_size) {
         state_p->sent_size = 0;
         state_p->tx_size = 0;
         state_p->tx_state = PKTTRANSFER_STATE_DELIMITER;
         state_p->sent_packets_cnt++;
+        pkttransfer_tx_queue_pop(pkttransfer_inst_p);
         return PKTTRANSFER_FRAME_DELIMITER_BYTE;
     }
 
-    // Prepare next byte
-    uint8_t next_payload_byte = config_p->buf_tx_p[state_p->sent_size];
+    // Prepare next byte - from payload or from CRC
+    size_t payload_size = state_p->tx_size - state_p->crc_size;
+    uint8_t next_payload_byte = (state_p->sent_size < payload_size) ?
+                                state_p->tx_payload_p[state_p->sent_size - state_p->tx_seg_start] :
+                                state_p->tx_crc_buf[state_p->sent_size - payload_size];
 
     switch (state_p->tx_state) {
 
         case PKTTRANSFER_STATE_DELIMITER:
             state_p->tx_state = PKTTRANSFER_STATE_BYTE;
+            state_p->tx_crc = pkttransfer_crc_init(pkttransfer_inst_p);
+            if (payload_size == 0) {
+                pkttransfer_store_tx_crc(pkttransfer_inst_p);
+            }
             return PKTTRANSFER_FRAME_DELIMITER_BYTE;
 
         case PKTTRANSFER_STATE_BYTE:
@@ -99,12 +729,12 @@ static uint8_t pkttransfer_prepare_byte(pkttransfer_t * pkttransfer_inst_p)
                 return PKTTRANSFER_FRAME_ESCAPE_BYTE;
             }
             else {
-                state_p->sent_size++;
+                pkttransfer_complete_tx_bytes(pkttransfer_inst_p, &next_payload_byte, 1);
                 return next_payload_byte;
             }
 
         case PKTTRANSFER_STATE_ENCODED_BYTE:
-            state_p->sent_size++;
+            pkttransfer_complete_tx_bytes(pkttransfer_inst_p, &next_payload_byte, 1);
             state_p->tx_state = PKTTRANSFER_STATE_BYTE;
             return (next_payload_byte == PKTTRANSFER_FRAME_DELIMITER_BYTE) ? PKTTRANSFER_FRAME_ENCODED_DELIMITER_BYTE : PKTTRANSFER_FRAME_ENCODED_ESCAPE_BYTE;
 
@@ -117,188 +747,2131 @@ static uint8_t pkttransfer_prepare_byte(pkttransfer_t * pkttransfer_inst_p)
 }
 
 //------------------------------------------------------------------------------
-// Process received byte
+// Prepare bytes to sending
 //
-// - checks frame delimiters and decodes escape sequences
-// - stores received bytes in the RX buffer of driver instance
-// - calls frame processing
+// - the same encoding as 'pkttransfer_prepare_byte()', but for series of bytes
+// - runs of bytes without delimiters and escape symbols are found word-at-a-time and copied at once,
+//   only delimiters, escape sequences and the last byte of frame are prepared byte-by-byte
+// - frames from TX queue are prepared back-to-back (CAN - only if they have the same CAN ID)
 //
-// Expected frame structure:    | 0x7E |  PAYLOAD  |  CRC16  | 0x7E |
-//                                     |<-  byte-stuffing  ->|
-//                                        0x7E is 0x7D 0x5E
-//                                        0x7D is 0x7D 0x5D
+// 'out_p'      - pointer to output buffer
+// 'out_size'   - size of output buffer
+//
+// Returns - number of prepared bytes
 //------------------------------------------------------------------------------
-static void pkttransfer_process_byte(pkttransfer_t * pkttransfer_inst_p, uint8_t byte)
+static size_t pkttransfer_prepare_bytes(pkttransfer_t * pkttransfer_inst_p, uint8_t* out_p, size_t out_size)
 {
     pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
-    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
-
-    assert(state_p->rx_size <= config_p->payload_size_max + PKTTRANSFER_FRAME_CRC_SIZE);
-
-    switch (state_p->rx_state) {
+    size_t out_cnt = 0;
 
-        case PKTTRANSFER_STATE_DELIMITER:
-            if (byte == PKTTRANSFER_FRAME_DELIMITER_BYTE) {
-                // start waiting for the first byte
-                state_p->sof_detections_cnt++;
-                state_p->rx_state = PKTTRANSFER_STATE_BYTE;
-            }
-            break;
+    while ((out_cnt < out_size) && (pkttransfer_bytes_for_sending(pkttransfer_inst_p) == true)) {
 
-        case PKTTRANSFER_STATE_BYTE:
-            if (byte == PKTTRANSFER_FRAME_ESCAPE_BYTE) {
-                // escape symbol is detected - wait encoded byte
-                state_p->rx_state = PKTTRANSFER_STATE_ENCODED_BYTE;
+        // Delimiters and escape sequences
+        if ((state_p->tx_state != PKTTRANSFER_STATE_BYTE) || (state_p->sent_size == state_p->tx_size)) {
+        #if (defined(PKTTRANSFER_OVER_CAN))
+            uint32_t can_id_tx = state_p->can_id_tx;
+            out_p[out_cnt++] = pkttransfer_prepare_byte(pkttransfer_inst_p);
+            if (state_p->can_id_tx != can_id_tx) {
                 break;
             }
-            else if (byte == PKTTRANSFER_FRAME_DELIMITER_BYTE) {
-                // end of frame is detected - process frame
-                pkttransfer_process_frame(pkttransfer_inst_p);
-                state_p->rx_size = 0;
-                state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
-            }
-            else if (state_p->rx_size >= config_p->payload_size_max) {
-                // rx buffer overflow is detected - drop frame
-                state_p->rx_size = 0;
-                state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
-            }
-            else {
-                // normal byte received - save to buffer
-                config_p->buf_rx_p[state_p->rx_size++] = byte;
-            }
-            break;
+        #else
+            out_p[out_cnt++] = pkttransfer_prepare_byte(pkttransfer_inst_p);
+        #endif
+            continue;
+        }
 
-        case PKTTRANSFER_STATE_ENCODED_BYTE:
-            if (((byte != PKTTRANSFER_FRAME_ENCODED_DELIMITER_BYTE) && (byte != PKTTRANSFER_FRAME_ENCODED_ESCAPE_BYTE)) ||
-                (state_p->rx_size >= config_p->payload_size_max)) {
-                // wrong escape sequence is detected OR rx buffer overflow is detected - drop frame
-                state_p->rx_size = 0;
-                state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
-            }
-            else {
-                // encoded byte is received - save to buffer
-                byte = (byte == PKTTRANSFER_FRAME_ENCODED_DELIMITER_BYTE) ? PKTTRANSFER_FRAME_DELIMITER_BYTE : PKTTRANSFER_FRAME_ESCAPE_BYTE;
-                config_p->buf_rx_p[state_p->rx_size++] = byte;
-                state_p->rx_state = PKTTRANSFER_STATE_BYTE;
-            }
-            break;
+        // Run of bytes - within segment of payload or within CRC
+        size_t payload_size = state_p->tx_size - state_p->crc_size;
+        const uint8_t* run_p;
+        size_t run_size;
+        if (state_p->sent_size < payload_size) {
+            run_p = &state_p->tx_payload_p[state_p->sent_size - state_p->tx_seg_start];
+            run_size = state_p->tx_seg_end - state_p->sent_size;
+        }
+        else {
+            run_p = &state_p->tx_crc_buf[state_p->sent_size - payload_size];
+            run_size = state_p->tx_size - state_p->sent_size;
+        }
 
-        default:
-            assert(false);
+        if (run_size > out_size - out_cnt) {
+            run_size = out_size - out_cnt;
+        }
+        run_size = pkttransfer_scan_special(run_p, run_size);
+
+        if (run_size == 0) {
+            out_p[out_cnt++] = pkttransfer_prepare_byte(pkttransfer_inst_p);
+            continue;
+        }
+
+        memcpy(&out_p[out_cnt], run_p, run_size);
+        pkttransfer_complete_tx_bytes(pkttransfer_inst_p, run_p, run_size);
+        out_cnt += run_size;
     }
+
+    return out_cnt;
 }
 
+#if (defined(PKTTRANSFER_OVER_UART))
 //------------------------------------------------------------------------------
-// Process received frame
-//  - frame is stored in the RX buffer of driver instance
-//  - checks CRC field
-//  - checks length of payload
-//  - calls callback to pass received frame to the application
+// Fill free DMA chunk with prepared bytes and start its sending
+//
+// Chunks are filled and sent in turn: while one chunk is sent by DMA, another one is filled by task
 //------------------------------------------------------------------------------
-static void pkttransfer_process_frame(pkttransfer_t * pkttransfer_inst_p)
+static void pkttransfer_tx_dma_fill(pkttransfer_t * pkttransfer_inst_p)
 {
-    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
     pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    size_t idx = state_p->tx_dma_fill_idx;
 
-    assert(state_p->rx_size <= config_p->payload_size_max + PKTTRANSFER_FRAME_CRC_SIZE);
-
-    // Check size
-    if (state_p->rx_size <= PKTTRANSFER_FRAME_CRC_SIZE) {
+    if ((pkttransfer_bytes_for_sending(pkttransfer_inst_p) == false) ||
+        (PKTTRANSFER_DMA_CHUNK_GET(atomic_load(&state_p->tx_dma_flags), idx) != PKTTRANSFER_DMA_CHUNK_FREE)) {
         return;
     }
 
-    // Check CRC
-    uint16_t actual_crc = (config_p->buf_rx_p[state_p->rx_size-1] << 8) | (config_p->buf_rx_p[state_p->rx_size-2]);
-    uint16_t expected_crc = pkttransfer_crc16(config_p->buf_rx_p, state_p->rx_size - PKTTRANSFER_FRAME_CRC_SIZE);
-    if (actual_crc != expected_crc) {
-        return;
+    // Fill chunk
+    uint8_t* chunk_p = &config_p->tx_dma_buf_p[idx * config_p->tx_dma_chunk_size];
+    state_p->tx_dma_chunk_fill[idx] = pkttransfer_prepare_bytes(pkttransfer_inst_p, chunk_p, config_p->tx_dma_chunk_size);
+    state_p->tx_dma_fill_idx = idx ^ 1;
+
+    // Mark chunk as ready (DMA interrupt can change state of another chunk meanwhile)
+    uint32_t flags = atomic_load(&state_p->tx_dma_flags);
+    while (!atomic_compare_exchange_weak(&state_p->tx_dma_flags, &flags, PKTTRANSFER_DMA_CHUNK_SET(flags, idx, PKTTRANSFER_DMA_CHUNK_READY))) {
     }
 
-    // Pass received frame to application
-    state_p->received_packets_cnt++;
-    pkttransfer_inst_p->app_itf.app_pkt_cb(pkttransfer_inst_p->app_itf.app_p, config_p->buf_rx_p, state_p->rx_size - PKTTRANSFER_FRAME_CRC_SIZE);
+    pkttransfer_tx_dma_try_start(pkttransfer_inst_p);
 }
 
+//------------------------------------------------------------------------------
+// Start DMA sending of the next chunk if it's ready and DMA is idle
+//
+// Can be called concurrently from task and from DMA interrupt - only one of them starts the chunk
+//------------------------------------------------------------------------------
+static void pkttransfer_tx_dma_try_start(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    pkttransfer_hw_itf_t* hw_itf_p = &(pkttransfer_inst_p->hw_itf);
+    uint32_t flags = atomic_load(&state_p->tx_dma_flags);
+    uint32_t idx;
+
+    do {
+        idx = (flags & PKTTRANSFER_DMA_SEND_IDX_BIT) ? 1 : 0;
+        if ((PKTTRANSFER_DMA_CHUNK_GET(flags, idx) != PKTTRANSFER_DMA_CHUNK_READY) ||
+            (PKTTRANSFER_DMA_CHUNK_GET(flags, idx ^ 1) == PKTTRANSFER_DMA_CHUNK_BUSY)) {
+            return;
+        }
+    } while (!atomic_compare_exchange_weak(&state_p->tx_dma_flags, &flags,
+                                           PKTTRANSFER_DMA_CHUNK_SET(flags, idx, PKTTRANSFER_DMA_CHUNK_BUSY) ^ PKTTRANSFER_DMA_SEND_IDX_BIT));
 
-//==================================================================================================
-//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
-//==================================================================================================
+    hw_itf_p->tx_dma_start_cb(hw_itf_p->hw_p, &config_p->tx_dma_buf_p[idx * config_p->tx_dma_chunk_size], state_p->tx_dma_chunk_fill[idx]);
+}
 
-//-----------------------------------------------------------------------------
-// Initialize driver instance
-//-----------------------------------------------------------------------------
-void pkttransfer_init(pkttransfer_t* inst_p, const pkttransfer_hw_itf_t* hw_itf_p, const pkttransfer_app_itf_t* app_itf_p, const pkttransfer_config_t* config_p)
+//------------------------------------------------------------------------------
+// Process all bytes received into circular DMA buffer since the previous call
+//
+// Bytes are processed in one or two spans (if DMA has wrapped around the end of buffer)
+//------------------------------------------------------------------------------
+static void pkttransfer_rx_dma_process(pkttransfer_t * pkttransfer_inst_p)
 {
-    assert((inst_p != NULL) && (hw_itf_p != NULL) && (config_p != NULL));
-    assert((config_p->payload_size_max != 0) &&
-           (config_p->buf_tx_p != NULL) && (config_p->buf_rx_p != NULL) &&
-           (hw_itf_p->rx_cb != NULL)    && (hw_itf_p->rx_is_ready_cb != NULL) &&
-           (hw_itf_p->tx_cb != NULL)    && (hw_itf_p->tx_is_avail_cb != NULL));
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    size_t head = atomic_load(&state_p->rx_dma_head);
+    size_t tail = state_p->rx_dma_tail;
 
-    memset(inst_p, 0x00, sizeof(pkttransfer_t));
-    memcpy(&(inst_p->hw_itf), hw_itf_p, sizeof(pkttransfer_hw_itf_t));
-    memcpy(&(inst_p->app_itf), app_itf_p, sizeof(pkttransfer_app_itf_t));
-    memcpy(&(inst_p->config), config_p, sizeof(pkttransfer_config_t));
+    assert(head < config_p->rx_dma_buf_size);
+
+    if (head < tail) {
+        pkttransfer_process_bytes(pkttransfer_inst_p, &config_p->rx_dma_buf_p[tail], config_p->rx_dma_buf_size - tail);
+        tail = 0;
+    }
+
+    pkttransfer_process_bytes(pkttransfer_inst_p, &config_p->rx_dma_buf_p[tail], head - tail);
+    state_p->rx_dma_tail = head;
 }
 
-//-----------------------------------------------------------------------------
-// Deinitialize driver instance
-//-----------------------------------------------------------------------------
-void pkttransfer_deinit(pkttransfer_t* inst_p)
+//------------------------------------------------------------------------------
+// Prepare bytes into free space of TX ring to be pulled by interrupt
+//
+// Task is the only producer - head is stored after bytes are written, so interrupt never reads unwritten bytes
+//------------------------------------------------------------------------------
+static void pkttransfer_isr_tx_fill(pkttransfer_t * pkttransfer_inst_p)
 {
-    assert(inst_p != NULL);
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    pkttransfer_hw_itf_t* hw_itf_p = &(pkttransfer_inst_p->hw_itf);
+    uint32_t head = atomic_load(&state_p->isr_tx_head);
+    uint32_t free_size = (uint32_t)config_p->isr_tx_ring_size - (head - atomic_load(&state_p->isr_tx_tail));
+    uint32_t prepared_size = 0;
+
+    // Free space is one or two spans (if it wraps around the end of ring)
+    while ((prepared_size < free_size) && (pkttransfer_bytes_for_sending(pkttransfer_inst_p) == true)) {
+        size_t idx = (head + prepared_size) & (config_p->isr_tx_ring_size - 1);
+        size_t span_size = config_p->isr_tx_ring_size - idx;
+        if (span_size > free_size - prepared_size) {
+            span_size = free_size - prepared_size;
+        }
+        prepared_size += (uint32_t)pkttransfer_prepare_bytes(pkttransfer_inst_p, &config_p->isr_tx_ring_p[idx], span_size);
+    }
 
-    memset(inst_p, 0x00, sizeof(pkttransfer_t));
+    if (prepared_size != 0) {
+        atomic_store(&state_p->isr_tx_head, head + prepared_size);
+        if (hw_itf_p->tx_kick_cb != NULL) {
+            hw_itf_p->tx_kick_cb(hw_itf_p->hw_p);
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
-// Check if driver instance is initialized
+// Process all bytes pushed into RX ring by interrupt since the previous call
+//
+// Task is the only consumer - tail is stored after each span is processed, so interrupt can reuse its space
 //------------------------------------------------------------------------------
-bool pkttransfer_is_init(const pkttransfer_t * inst_p)
+static void pkttransfer_isr_rx_process(pkttransfer_t * pkttransfer_inst_p)
 {
-    return ((inst_p != NULL) && (inst_p->config.payload_size_max != 0));
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    uint32_t head = atomic_load(&state_p->isr_rx_head);
+    uint32_t tail = atomic_load(&state_p->isr_rx_tail);
+
+    while (tail != head) {
+        size_t idx = tail & (config_p->isr_rx_ring_size - 1);
+        size_t span_size = config_p->isr_rx_ring_size - idx;
+        if (span_size > (uint32_t)(head - tail)) {
+            span_size = (uint32_t)(head - tail);
+        }
+        pkttransfer_process_bytes(pkttransfer_inst_p, &config_p->isr_rx_ring_p[idx], span_size);
+        tail += (uint32_t)span_size;
+        atomic_store(&state_p->isr_rx_tail, tail);
+    }
 }
-
-//-----------------------------------------------------------------------------
-// Send packet
-//-----------------------------------------------------------------------------
-#if (defined(PKTTRANSFER_OVER_UART))
-pkttransfer_err_t pkttransfer_send(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size)
-#elif (defined(PKTTRANSFER_OVER_CAN))
-pkttransfer_err_t pkttransfer_send(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size, uint32_t can_id_tx)
 #endif
+
+//------------------------------------------------------------------------------
+// Complete sending of payload or CRC bytes
+//
+// - updates CRC with payload bytes
+// - switches to the next segment of payload
+// - stores CRC to be sent after the last payload byte
+//
+// Guaranteed - bytes don't cross the boundary between segments of payload and CRC
+//------------------------------------------------------------------------------
+static void pkttransfer_complete_tx_bytes(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size)
 {
-    assert(pkttransfer_is_init(inst_p));
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    size_t payload_size = state_p->tx_size - state_p->crc_size;
 
-    pkttransfer_config_t* config_p = &(inst_p->config);
-    pkttransfer_state_t* state_p = &(inst_p->state);
+    if (state_p->sent_size < payload_size) {
+        assert(state_p->sent_size + size <= state_p->tx_seg_end);
+        state_p->tx_crc = pkttransfer_crc_update(pkttransfer_inst_p, state_p->tx_crc, data_p, size);
+        state_p->sent_size += size;
+
+        if (state_p->sent_size == payload_size) {
+            pkttransfer_store_tx_crc(pkttransfer_inst_p);
+        }
+        else {
+            pkttransfer_tx_seg_load(pkttransfer_inst_p);
+        }
+        return;
+    }
+
+    state_p->sent_size += size;
+}
+
+//------------------------------------------------------------------------------
+// Get free slot of TX queue for packet
+//
+// Can be called concurrently by several senders: each slot has sequence number equal to position of queue
+// where it's free, senders compete for this position with CAS, slot is owned by winner until it's pushed
+// Pushed slot keeps its position with ready bit, so it isn't taken as free for the next position even with one slot
+//
+// Returns - pointer to slot, NULL if packet can't be sent
+//------------------------------------------------------------------------------
+static pkttransfer_tx_slot_t* pkttransfer_tx_queue_reserve(pkttransfer_t * pkttransfer_inst_p, size_t size)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
 
     // If payload exceeds maximum packet lenght
     if (size > config_p->payload_size_max) {
-        return PKTTRANSFER_ERR_TX_OVF;
+        return NULL;
     }
 
-    // If previous packet isn't sent
-    if (state_p->tx_size != 0) {
-        return PKTTRANSFER_ERR_TX_OVF;
+    // Empty packet without CRC (ISO-TP without CRC) has nothing to be sent, its slot would never be popped
+    if ((size == 0) && (state_p->crc_size == 0)) {
+        return NULL;
     }
 
-    // Store payload in the buffer
-    memcpy(config_p->buf_tx_p, payload_p, size);
-    state_p->tx_size = size + PKTTRANSFER_FRAME_CRC_SIZE;
-    state_p->sent_size = 0;
-#if (defined(PKTTRANSFER_OVER_CAN))
-    state_p->can_id_tx = can_id_tx;
-#endif
-
-    // Add CRC
-    uint16_t crc = pkttransfer_crc16(config_p->buf_tx_p, size);
-    config_p->buf_tx_p[size] = (crc & 0xFF);
-    config_p->buf_tx_p[size + 1] = (crc >> 8);
-
+    uint32_t pos = atomic_load(&state_p->tx_queue_enq);
+    for (;;) {
+        pkttransfer_tx_slot_t* slot_p = &config_p->tx_slots_p[pos % config_p->tx_slots_cnt];
+        uint32_t seq = atomic_load(&slot_p->seq);
+        int32_t dist = pkttransfer_tx_queue_pos_dist(pkttransfer_inst_p, pos, seq & ~PKTTRANSFER_TX_SLOT_READY_BIT);
+
+        if ((dist == 0) && ((seq & PKTTRANSFER_TX_SLOT_READY_BIT) == 0)) {
+            // Slot is free - take position (on failure 'pos' is updated with position taken by another sender)
+            if (atomic_compare_exchange_weak(&state_p->tx_queue_enq, &pos, pkttransfer_tx_queue_pos_add(pkttransfer_inst_p, pos, 1))) {
+                slot_p->size = size;
+                return slot_p;
+            }
+        }
+        else if (dist < 0) {
+            // Slot isn't released since the previous lap - there are no free slots (previous packets aren't sent)
+            return NULL;
+        }
+        else {
+            // Position is already taken (and maybe pushed) by another sender
+            pos = atomic_load(&state_p->tx_queue_enq);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Mark reserved slot as ready for sending, task starts sending when the slot reaches head of TX queue
+//------------------------------------------------------------------------------
+static void pkttransfer_tx_queue_push(pkttransfer_t * pkttransfer_inst_p, pkttransfer_tx_slot_t* slot_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+
+    // Reserved slot keeps its position until it's pushed
+    uint32_t pos = atomic_load(&slot_p->seq);
+    uint32_t pos_next = pkttransfer_tx_queue_pos_add(pkttransfer_inst_p, pos, 1);
+
+    // Number of packets in queue up to this one (including packet being sent)
+    uint32_t cnt = (uint32_t)pkttransfer_tx_queue_pos_dist(pkttransfer_inst_p, atomic_load(&state_p->tx_queue_deq), pos_next);
+    uint32_t hwm = atomic_load(&state_p->tx_queue_hwm);
+    while ((cnt > hwm) && (atomic_compare_exchange_weak(&state_p->tx_queue_hwm, &hwm, cnt) == false)) {
+    }
+
+    atomic_store(&slot_p->seq, pos | PKTTRANSFER_TX_SLOT_READY_BIT);
+    pkttransfer_group_mark(pkttransfer_inst_p, true);
+}
+
+//------------------------------------------------------------------------------
+// Release slot of sent packet and start sending of the next packet from TX queue
+//
+// Payload and CRC are completely encoded at this moment, so application's buffer is released
+//------------------------------------------------------------------------------
+static void pkttransfer_tx_queue_pop(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    pkttransfer_app_itf_t* app_itf_p = &(pkttransfer_inst_p->app_itf);
+
+    uint32_t pos = atomic_load(&state_p->tx_queue_deq);
+    pkttransfer_tx_slot_t* slot_p = pkttransfer_tx_queue_head(pkttransfer_inst_p);
+    assert(atomic_load(&slot_p->seq) == (pos | PKTTRANSFER_TX_SLOT_READY_BIT));
+
+    if (slot_p->is_ref) {
+        if (slot_p->segs_p == &slot_p->seg) {
+            if (app_itf_p->app_tx_done_cb != NULL) {
+                app_itf_p->app_tx_done_cb(app_itf_p->app_p, slot_p->seg.data_p, slot_p->size);
+            }
+        } else if (app_itf_p->app_txv_done_cb != NULL) {
+            app_itf_p->app_txv_done_cb(app_itf_p->app_p, slot_p->segs_p, slot_p->segs_cnt);
+        }
+    }
+
+    // Slot is free for senders at the same index on the next lap
+    atomic_store(&state_p->tx_queue_deq, pkttransfer_tx_queue_pos_add(pkttransfer_inst_p, pos, 1));
+    atomic_store(&slot_p->seq, pkttransfer_tx_queue_pos_add(pkttransfer_inst_p, pos, (uint32_t)config_p->tx_slots_cnt));
+
+    pkttransfer_tx_queue_load(pkttransfer_inst_p);
+}
+
+//------------------------------------------------------------------------------
+// Start sending of packet from the head slot of TX queue if it's pushed by sender
+//------------------------------------------------------------------------------
+static void pkttransfer_tx_queue_load(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    const pkttransfer_tx_slot_t* slot_p = pkttransfer_tx_queue_head(pkttransfer_inst_p);
+
+    assert((state_p->tx_size == 0) && (state_p->tx_state == PKTTRANSFER_STATE_DELIMITER));
+
+    // Slot is free or is still being filled by sender
+    uint32_t pos = atomic_load(&state_p->tx_queue_deq);
+    if (atomic_load(&slot_p->seq) != (pos | PKTTRANSFER_TX_SLOT_READY_BIT)) {
+        return;
+    }
+
+    state_p->tx_size = slot_p->size + state_p->crc_size;
+    state_p->sent_size = 0;
+    state_p->tx_seg_start = 0;
+    state_p->tx_seg_end = 0;
+    state_p->tx_seg_idx = 0;
+    pkttransfer_tx_seg_load(pkttransfer_inst_p);
+#if (defined(PKTTRANSFER_OVER_CAN))
+    state_p->can_id_tx = slot_p->can_id_tx;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Get head slot of TX queue (being sent or the next one to be sent)
+//------------------------------------------------------------------------------
+static pkttransfer_tx_slot_t* pkttransfer_tx_queue_head(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+
+    return &config_p->tx_slots_p[atomic_load(&pkttransfer_inst_p->state.tx_queue_deq) % config_p->tx_slots_cnt];
+}
+
+//------------------------------------------------------------------------------
+// Advance position of TX queue by 'n' (less than 'tx_queue_wrap')
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_tx_queue_pos_add(const pkttransfer_t * pkttransfer_inst_p, uint32_t pos, uint32_t n)
+{
+    uint32_t wrap = pkttransfer_inst_p->state.tx_queue_wrap;
+
+    return (pos < wrap - n) ? (pos + n) : (pos - (wrap - n));
+}
+
+//------------------------------------------------------------------------------
+// Get signed distance between positions of TX queue
+//
+// Positions in use are within a few laps of queue, which is much less than half of 'tx_queue_wrap'
+//------------------------------------------------------------------------------
+static int32_t pkttransfer_tx_queue_pos_dist(const pkttransfer_t * pkttransfer_inst_p, uint32_t pos_from, uint32_t pos_to)
+{
+    uint32_t wrap = pkttransfer_inst_p->state.tx_queue_wrap;
+    uint32_t dist = (pos_to >= pos_from) ? (pos_to - pos_from) : (pos_to + (wrap - pos_from));
+
+    return (dist < wrap / 2) ? (int32_t)dist : -(int32_t)(wrap - dist);
+}
+
+//------------------------------------------------------------------------------
+// Switch to the next non-empty segment of payload if the current one is completely sent
+//------------------------------------------------------------------------------
+static void pkttransfer_tx_seg_load(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    const pkttransfer_tx_slot_t* slot_p = pkttransfer_tx_queue_head(pkttransfer_inst_p);
+
+    while ((state_p->sent_size == state_p->tx_seg_end) && (state_p->tx_seg_idx < slot_p->segs_cnt)) {
+        const pkttransfer_seg_t* seg_p = &slot_p->segs_p[state_p->tx_seg_idx++];
+        state_p->tx_payload_p = seg_p->data_p;
+        state_p->tx_seg_start = state_p->tx_seg_end;
+        state_p->tx_seg_end += seg_p->size;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Store final CRC to be sent after payload (LSB first)
+//------------------------------------------------------------------------------
+static void pkttransfer_store_tx_crc(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    uint32_t crc = pkttransfer_crc_final(pkttransfer_inst_p, state_p->tx_crc);
+
+    for (size_t i = 0; i < state_p->crc_size; i++) {
+        state_p->tx_crc_buf[i] = (uint8_t)(crc >> (8 * i));
+    }
+}
+
+//------------------------------------------------------------------------------
+// Process received byte
+//
+// - checks frame delimiters and decodes escape sequences
+// - stores received bytes in the RX buffer of driver instance
+// - calls frame processing
+//
+// Expected frame structure:    | 0x7E |  PAYLOAD  |  CRC16  | 0x7E |
+//                                     |<-  byte-stuffing  ->|
+//                                        0x7E is 0x7D 0x5E
+//                                        0x7D is 0x7D 0x5D
+//------------------------------------------------------------------------------
+static void pkttransfer_process_byte(pkttransfer_t * pkttransfer_inst_p, uint8_t byte)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+
+    assert(state_p->rx_size <= config_p->payload_size_max + state_p->crc_size);
+
+    switch (state_p->rx_state) {
+
+        case PKTTRANSFER_STATE_DELIMITER:
+            if (byte == PKTTRANSFER_FRAME_DELIMITER_BYTE) {
+                // start waiting for the first byte
+                state_p->sof_detections_cnt++;
+                pkttransfer_rx_buf_acquire(pkttransfer_inst_p);
+                state_p->rx_crc = pkttransfer_crc_init(pkttransfer_inst_p);
+                state_p->rx_state = PKTTRANSFER_STATE_BYTE;
+            }
+            break;
+
+        case PKTTRANSFER_STATE_BYTE:
+            if (byte == PKTTRANSFER_FRAME_ESCAPE_BYTE) {
+                // escape symbol is detected - wait encoded byte
+                state_p->rx_state = PKTTRANSFER_STATE_ENCODED_BYTE;
+                break;
+            }
+            else if (byte == PKTTRANSFER_FRAME_DELIMITER_BYTE) {
+                // end of frame is detected - process frame
+                pkttransfer_process_frame(pkttransfer_inst_p);
+                state_p->rx_size = 0;
+                state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
+            }
+            else if (state_p->rx_buf_p == NULL) {
+                // there is no free loaned buffer - skip bytes until the end of frame
+            }
+            else if (state_p->rx_size >= config_p->payload_size_max + state_p->crc_size) {
+                // rx buffer overflow is detected - drop frame
+                state_p->rx_size = 0;
+                state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
+            }
+            else {
+                // normal byte received - save to buffer
+                pkttransfer_store_rx_bytes(pkttransfer_inst_p, &byte, 1);
+            }
+            break;
+
+        case PKTTRANSFER_STATE_ENCODED_BYTE:
+            if (((byte != PKTTRANSFER_FRAME_ENCODED_DELIMITER_BYTE) && (byte != PKTTRANSFER_FRAME_ENCODED_ESCAPE_BYTE)) ||
+                (state_p->rx_size >= config_p->payload_size_max + state_p->crc_size)) {
+                // wrong escape sequence is detected OR rx buffer overflow is detected - drop frame
+                state_p->rx_size = 0;
+                state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
+            }
+            else if (state_p->rx_buf_p == NULL) {
+                // there is no free loaned buffer - skip bytes until the end of frame
+                state_p->rx_state = PKTTRANSFER_STATE_BYTE;
+            }
+            else {
+                // encoded byte is received - save to buffer
+                byte = (byte == PKTTRANSFER_FRAME_ENCODED_DELIMITER_BYTE) ? PKTTRANSFER_FRAME_DELIMITER_BYTE : PKTTRANSFER_FRAME_ESCAPE_BYTE;
+                pkttransfer_store_rx_bytes(pkttransfer_inst_p, &byte, 1);
+                state_p->rx_state = PKTTRANSFER_STATE_BYTE;
+            }
+            break;
+
+        default:
+            assert(false);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Process received bytes
+//
+// - the same decoding as 'pkttransfer_process_byte()' called for each byte, but for series of bytes
+// - bytes between frames are skipped until delimiter at once
+// - runs of bytes without delimiters and escape symbols are found word-at-a-time and stored at once,
+//   only delimiters and escape sequences are processed byte-by-byte
+// - frame can be split between calls at any byte
+// - processing is stopped after a frame if output of 'pkttransfer_decode_stream()' is full
+//
+// Returns - number of processed bytes
+//------------------------------------------------------------------------------
+static size_t pkttransfer_process_bytes(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    size_t processed_size = 0;
+
+    while ((size != 0) && ((state_p->rx_stream_p == NULL) || (state_p->rx_stream_p->is_full == false))) {
+
+        size_t run_size = 0;
+
+        if (state_p->rx_state == PKTTRANSFER_STATE_DELIMITER) {
+            // skip bytes before start-of-frame delimiter
+            const uint8_t* delimiter_p = memchr(data_p, PKTTRANSFER_FRAME_DELIMITER_BYTE, size);
+            run_size = (delimiter_p == NULL) ? size : (size_t)(delimiter_p - data_p);
+        }
+        else if (state_p->rx_buf_p == NULL) {
+            // skip normal bytes of frame if there is no free loaned buffer
+            run_size = (state_p->rx_state == PKTTRANSFER_STATE_BYTE) ? pkttransfer_scan_special(data_p, size) : 0;
+        }
+        else if (state_p->rx_state == PKTTRANSFER_STATE_BYTE) {
+            // store normal bytes until buffer is full, overflow is processed byte-by-byte
+            size_t free_size = config_p->payload_size_max + state_p->crc_size - state_p->rx_size;
+            run_size = pkttransfer_scan_special(data_p, (size < free_size) ? size : free_size);
+            pkttransfer_store_rx_bytes(pkttransfer_inst_p, data_p, run_size);
+        }
+
+        if (run_size == 0) {
+            pkttransfer_process_byte(pkttransfer_inst_p, *data_p);
+            run_size = 1;
+        }
+
+        data_p += run_size;
+        size -= run_size;
+        processed_size += run_size;
+    }
+
+    return processed_size;
+}
+
+//------------------------------------------------------------------------------
+// Store received bytes
+//
+// - stores bytes in the RX buffer of driver instance
+// - updates CRC with bytes received CRC-size bytes ago, so the last CRC-size bytes
+//   (which are CRC at the end of frame) are never included into CRC
+//------------------------------------------------------------------------------
+static void pkttransfer_store_rx_bytes(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+
+    assert((state_p->rx_buf_p != NULL) && (state_p->rx_size + size <= config_p->payload_size_max + state_p->crc_size));
+    (void)config_p;
+
+    size_t crc_begin = (state_p->rx_size > state_p->crc_size) ? (state_p->rx_size - state_p->crc_size) : 0;
+
+    if (size == 1) {
+        state_p->rx_buf_p[state_p->rx_size] = *data_p;
+    }
+    else {
+        memcpy(&state_p->rx_buf_p[state_p->rx_size], data_p, size);
+    }
+    state_p->rx_size += size;
+
+    size_t crc_end = (state_p->rx_size > state_p->crc_size) ? (state_p->rx_size - state_p->crc_size) : 0;
+
+    if (crc_end > crc_begin) {
+        state_p->rx_crc = pkttransfer_crc_update(pkttransfer_inst_p, state_p->rx_crc, &state_p->rx_buf_p[crc_begin], crc_end - crc_begin);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Process received frame
+//  - frame is stored in the RX buffer of driver instance
+//  - checks CRC field (CRC is already calculated while receiving)
+//  - checks length of payload
+//  - calls callback to pass received frame to the application
+//------------------------------------------------------------------------------
+static void pkttransfer_process_frame(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+
+    assert(state_p->rx_size <= config_p->payload_size_max + state_p->crc_size);
+    (void)config_p;
+
+    // Check size
+    if (state_p->rx_size <= state_p->crc_size) {
+        return;
+    }
+    size_t payload_size = state_p->rx_size - state_p->crc_size;
+
+    // Check CRC - CRC register already contains all payload bytes
+    uint32_t expected_crc = pkttransfer_crc_final(pkttransfer_inst_p, state_p->rx_crc);
+    for (size_t i = 0; i < state_p->crc_size; i++) {
+        if (state_p->rx_buf_p[payload_size + i] != (uint8_t)(expected_crc >> (8 * i))) {
+            return;
+        }
+    }
+
+    state_p->received_packets_cnt++;
+
+    // Store received payload into output of 'pkttransfer_decode_stream()'
+    struct pkttransfer_stream_s* stream_p = state_p->rx_stream_p;
+    if (stream_p != NULL) {
+        assert((stream_p->descs_cnt < stream_p->descs_cap) && (payload_size <= stream_p->out_cap - stream_p->out_size));
+        memcpy(&stream_p->out_p[stream_p->out_size], state_p->rx_buf_p, payload_size);
+        stream_p->descs_p[stream_p->descs_cnt].offset = stream_p->out_size;
+        stream_p->descs_p[stream_p->descs_cnt].size = payload_size;
+        stream_p->descs_cnt++;
+        stream_p->out_size += payload_size;
+        stream_p->is_full = (stream_p->descs_cnt == stream_p->descs_cap) ||
+                            (stream_p->out_cap - stream_p->out_size < config_p->payload_size_max);
+        return;
+    }
+
+#if (defined(PKTTRANSFER_OVER_CAN))
+    // Pass received frame of RX channel to application
+    pkttransfer_rx_channel_t* channel_p = state_p->rx_channel_p;
+    if (channel_p != NULL) {
+        channel_p->received_packets_cnt++;
+        if (pkttransfer_inst_p->app_itf.app_channel_pkt_cb != NULL) {
+            pkttransfer_inst_p->app_itf.app_channel_pkt_cb(pkttransfer_inst_p->app_itf.app_p, channel_p->can_id, state_p->rx_buf_p, payload_size);
+            return;
+        }
+    }
+#endif
+
+    // Place received frame into deferred delivery ring, slot is owned by application from now
+    if (config_p->rx_slots_p != NULL) {
+        uint32_t head = atomic_load(&state_p->rx_slots_head);
+        pkttransfer_rx_slot_t* slot_p = &config_p->rx_slots_p[head & (config_p->rx_slots_cnt - 1)];
+        assert(state_p->rx_buf_p == slot_p->data_p);
+        slot_p->size = payload_size;
+        atomic_store(&state_p->rx_slots_head, head + 1);
+        state_p->rx_buf_p = NULL;
+
+        uint32_t cnt = head + 1 - atomic_load(&state_p->rx_slots_tail);
+        if (cnt > state_p->rx_slots_hwm) {
+            state_p->rx_slots_hwm = cnt;
+        }
+        return;
+    }
+
+    // Pass received frame to application, loaned buffer is owned by application from now
+    pkttransfer_inst_p->app_itf.app_pkt_cb(pkttransfer_inst_p->app_itf.app_p, state_p->rx_buf_p, payload_size);
+    if (state_p->rx_loan) {
+        state_p->rx_buf_p = NULL;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Get free loaned buffer for the next frame, if there is no buffer yet
+//
+// Buffer is got from application's provider, from driver's pool of RX buffers or from the next slot of delivery ring
+//------------------------------------------------------------------------------
+static void pkttransfer_rx_buf_acquire(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    pkttransfer_app_itf_t* app_itf_p = &(pkttransfer_inst_p->app_itf);
+
+    if (state_p->rx_buf_p != NULL) {
+        return;
+    }
+
+    if (app_itf_p->app_rx_buf_get_cb != NULL) {
+        state_p->rx_buf_p = app_itf_p->app_rx_buf_get_cb(app_itf_p->app_p);
+    }
+    else if (config_p->rx_slots_p != NULL) {
+        // Only task fills slots, application releases them meanwhile
+        uint32_t head = atomic_load(&state_p->rx_slots_head);
+        if (head - atomic_load(&state_p->rx_slots_tail) < config_p->rx_slots_cnt) {
+            state_p->rx_buf_p = config_p->rx_slots_p[head & (config_p->rx_slots_cnt - 1)].data_p;
+        }
+    }
+    else {
+        // Only task takes buffers, so the chosen buffer can't be taken meanwhile
+        uint32_t free_mask = atomic_load(&state_p->rx_pool_free);
+        if (free_mask != 0) {
+            size_t idx = 0;
+            while ((free_mask & (1UL << idx)) == 0) {
+                idx++;
+            }
+            atomic_fetch_and(&state_p->rx_pool_free, ~(uint32_t)(1UL << idx));
+            state_p->rx_buf_p = &config_p->rx_pool_p[idx * (config_p->payload_size_max + state_p->crc_size)];
+        }
+    }
+
+    if (state_p->rx_buf_p == NULL) {
+        state_p->rx_no_buf_cnt++;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Set TX-pending or RX-ready bit of instance in its group (if instance is in group)
+//
+// Can be called from task, from interrupts or from another threads
+//------------------------------------------------------------------------------
+static void pkttransfer_group_mark(pkttransfer_t * pkttransfer_inst_p, bool is_tx)
+{
+    pkttransfer_group_t* group_p = pkttransfer_inst_p->state.group_p;
+
+    if (group_p != NULL) {
+        atomic_fetch_or(is_tx ? &group_p->tx_pending : &group_p->rx_ready, pkttransfer_inst_p->state.group_bit);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Transmitting half of task
+//
+// Returns - true if task can send more bytes right now (TX-pending bit of group is kept)
+//------------------------------------------------------------------------------
+static bool pkttransfer_task_tx_run(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_hw_itf_t * hw_itf_p = &(pkttransfer_inst_p->hw_itf);
+
+#if (defined(PKTTRANSFER_OVER_UART))
+    // Prepare bytes into DMA chunks in DMA mode, or into TX ring in interrupt mode
+    bool tx_dma_mode = (hw_itf_p->tx_dma_start_cb != NULL);
+    if (tx_dma_mode == true) {
+        pkttransfer_tx_dma_fill(pkttransfer_inst_p);
+    }
+    bool tx_ring_mode = (pkttransfer_inst_p->config.isr_tx_ring_p != NULL);
+    if (tx_ring_mode == true) {
+        pkttransfer_isr_tx_fill(pkttransfer_inst_p);
+    }
+    size_t tx_msgs_max = 1;
+#else
+    bool tx_dma_mode = false;
+    bool tx_ring_mode = false;
+    size_t tx_msgs_max = pkttransfer_inst_p->config.can_tx_msgs_per_task;
+#endif
+
+    // While there are bytes to be sent and low level driver is ready to send (CAN - up to several messages per call)
+    size_t tx_msgs_cnt = 0;
+    for (;
+         (tx_dma_mode == false) && (tx_ring_mode == false) && (tx_msgs_cnt < tx_msgs_max) &&
+         (pkttransfer_bytes_for_sending(pkttransfer_inst_p) == true) && (hw_itf_p->tx_is_avail_cb(hw_itf_p->hw_p) == true);
+         tx_msgs_cnt++) {
+
+        #if (defined(PKTTRANSFER_OVER_UART))
+
+            // Prepare byte
+            uint8_t transmit_byte = pkttransfer_prepare_byte(pkttransfer_inst_p);
+
+            // Send byte into low level driver
+            pkttransfer_inst_p->hw_itf.tx_cb(hw_itf_p->hw_p, transmit_byte);
+
+        #elif (defined(PKTTRANSFER_OVER_CAN))
+
+            // Prepare bytes (CAN ID of the next frame can be loaded after the end of frame)
+            uint8_t transmit_buf[PKTTRANSFER_CAN_FD_MGS_SIZE_MAX];
+            uint32_t can_id_tx = pkttransfer_inst_p->state.can_id_tx;
+            size_t transmit_buf_size;
+            if (pkttransfer_inst_p->config.can_transport == PKTTRANSFER_CAN_TRANSPORT_ISOTP) {
+                transmit_buf_size = pkttransfer_isotp_prepare_msg(pkttransfer_inst_p, transmit_buf, &can_id_tx);
+                if (transmit_buf_size == 0) {
+                    break;
+                }
+            }
+            else {
+                transmit_buf_size = pkttransfer_prepare_bytes(pkttransfer_inst_p, transmit_buf, pkttransfer_inst_p->config.can_msg_size);
+            }
+
+            // Pad CAN FD message up to valid DLC length after the end of frame
+            size_t dlc_size = pkttransfer_can_fd_dlc_size(transmit_buf_size);
+            memset(&transmit_buf[transmit_buf_size], PKTTRANSFER_CAN_FD_PADDING_BYTE, dlc_size - transmit_buf_size);
+
+            // Send bytes into low level driver
+            pkttransfer_inst_p->hw_itf.tx_cb(hw_itf_p->hw_p, transmit_buf, dlc_size, can_id_tx);
+        #endif
+    }
+
+    // Sending can continue right now only if budget of messages is used up or the next DMA chunk is free,
+    // otherwise TX-pending bit is set again by 'pkttransfer_tx_dma_complete()', 'pkttransfer_isr_tx_pull()',
+    // received flow control or 'pkttransfer_tx_notify()'
+    if (pkttransfer_bytes_for_sending(pkttransfer_inst_p) == false) {
+        return false;
+    }
+#if (defined(PKTTRANSFER_OVER_UART))
+    if (tx_dma_mode == true) {
+        pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+        return (PKTTRANSFER_DMA_CHUNK_GET(atomic_load(&state_p->tx_dma_flags), state_p->tx_dma_fill_idx) == PKTTRANSFER_DMA_CHUNK_FREE);
+    }
+    if (tx_ring_mode == true) {
+        return false;
+    }
+#endif
+
+    return (tx_msgs_cnt == tx_msgs_max);
+}
+
+//------------------------------------------------------------------------------
+// Receiving half of task
+//
+// Returns - true if low level driver can have more received bytes right now (RX-ready bit of group is kept)
+//------------------------------------------------------------------------------
+static bool pkttransfer_task_rx_run(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_hw_itf_t * hw_itf_p = &(pkttransfer_inst_p->hw_itf);
+
+#if (defined(PKTTRANSFER_OVER_UART))
+    size_t rx_msgs_max = 1;
+
+    // Process all bytes received by DMA in DMA mode, or pushed into RX ring in interrupt mode
+    bool rx_dma_mode = (pkttransfer_inst_p->config.rx_dma_buf_p != NULL);
+    if (rx_dma_mode == true) {
+        pkttransfer_rx_dma_process(pkttransfer_inst_p);
+    }
+    bool rx_ring_mode = (pkttransfer_inst_p->config.isr_rx_ring_p != NULL);
+    if (rx_ring_mode == true) {
+        pkttransfer_isr_rx_process(pkttransfer_inst_p);
+    }
+#else
+    size_t rx_msgs_max = pkttransfer_inst_p->config.can_rx_msgs_per_task;
+    bool rx_dma_mode = false;
+    bool rx_ring_mode = false;
+#endif
+
+    // While there are received bytes in the low level driver (CAN - up to several messages per call)
+    size_t rx_msgs_cnt = 0;
+    for (;
+         (rx_dma_mode == false) && (rx_ring_mode == false) && (rx_msgs_cnt < rx_msgs_max) && (hw_itf_p->rx_is_ready_cb(hw_itf_p->hw_p) == true);
+         rx_msgs_cnt++) {
+
+        #if (defined(PKTTRANSFER_OVER_UART))
+
+            // Receive byte from low level driver
+            uint8_t received_byte = pkttransfer_inst_p->hw_itf.rx_cb(hw_itf_p->hw_p);
+
+            // Process received byte, process received frame, pass payload to application
+            pkttransfer_process_byte(pkttransfer_inst_p, received_byte);
+
+        #elif (defined(PKTTRANSFER_OVER_CAN))
+
+            uint8_t received_buf[PKTTRANSFER_CAN_FD_MGS_SIZE_MAX];
+
+            if (pkttransfer_inst_p->config.rx_channels_p != NULL) {
+
+                // Receive bytes of any ID from low level driver, dispatch them into RX channel of the ID
+                uint32_t can_id_rx = 0;
+                size_t received_buf_size = hw_itf_p->rx_any_cb(hw_itf_p->hw_p, received_buf, &can_id_rx);
+                assert(received_buf_size <= pkttransfer_inst_p->config.can_msg_size);
+
+                pkttransfer_rx_channel_t* channel_p = pkttransfer_rx_channel_find(pkttransfer_inst_p, can_id_rx);
+                if (channel_p != NULL) {
+                    pkttransfer_rx_channel_process(pkttransfer_inst_p, channel_p, received_buf, received_buf_size);
+                }
+                else {
+                    pkttransfer_inst_p->state.rx_unknown_id_cnt++;
+                }
+                continue;
+            }
+
+            // Receive bytes from low level driver
+            size_t received_buf_size = hw_itf_p->rx_cb(hw_itf_p->hw_p, received_buf, pkttransfer_inst_p->state.can_id_rx);
+            assert(received_buf_size <= pkttransfer_inst_p->config.can_msg_size);
+
+            // Process received bytes, process received frame, pass payload to application
+            if (pkttransfer_inst_p->config.can_transport == PKTTRANSFER_CAN_TRANSPORT_ISOTP) {
+                pkttransfer_isotp_process_msg(pkttransfer_inst_p, received_buf, received_buf_size);
+            }
+            else {
+                pkttransfer_process_bytes(pkttransfer_inst_p, received_buf, received_buf_size);
+            }
+
+        #endif
+    }
+
+    // Bytes of DMA buffer and RX ring are all processed, new bytes set RX-ready bit themselves,
+    // low level driver may have more bytes only if budget of messages is used up (otherwise 'pkttransfer_rx_notify()')
+    return (rx_dma_mode == false) && (rx_ring_mode == false) && (rx_msgs_cnt == rx_msgs_max);
+}
+
+#if (defined(PKTTRANSFER_OVER_CAN))
+//------------------------------------------------------------------------------
+// Get size of CAN message with valid DLC length
+//
+// Returns - 'size' if it's up to 8 bytes, otherwise the nearest CAN FD DLC length not less than 'size'
+//------------------------------------------------------------------------------
+static size_t pkttransfer_can_fd_dlc_size(size_t size)
+{
+    static const uint8_t dlc_sizes[] = {8, 12, 16, 20, 24, 32, 48, 64};
+
+    if (size <= PKTTRANSFER_CAN_MGS_SIZE) {
+        return size;
+    }
+
+    size_t idx = 0;
+    while (dlc_sizes[idx] < size) {
+        idx++;
+        assert(idx < sizeof(dlc_sizes));
+    }
+
+    return dlc_sizes[idx];
+}
+
+//------------------------------------------------------------------------------
+// Sort RX channels by CAN ID for binary search and reset their decoders
+//
+// Insertion sort - table is sorted once at initialization and is usually small
+//------------------------------------------------------------------------------
+static void pkttransfer_rx_channels_sort(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_rx_channel_t* channels_p = pkttransfer_inst_p->config.rx_channels_p;
+    size_t channels_cnt = pkttransfer_inst_p->config.rx_channels_cnt;
+
+    for (size_t i = 0; i < channels_cnt; i++) {
+        assert(channels_p[i].buf_p != NULL);
+        channels_p[i].rx_state = PKTTRANSFER_STATE_DELIMITER;
+        channels_p[i].rx_size = 0;
+        channels_p[i].rx_crc = 0;
+        channels_p[i].received_packets_cnt = 0;
+    }
+
+    for (size_t i = 1; i < channels_cnt; i++) {
+        pkttransfer_rx_channel_t channel = channels_p[i];
+        size_t j = i;
+        while ((j != 0) && (channels_p[j - 1].can_id > channel.can_id)) {
+            channels_p[j] = channels_p[j - 1];
+            j--;
+        }
+        channels_p[j] = channel;
+    }
+
+    for (size_t i = 1; i < channels_cnt; i++) {
+        assert(channels_p[i - 1].can_id != channels_p[i].can_id);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Find RX channel of CAN ID (binary search in sorted table)
+//
+// Returns - NULL if there is no channel for CAN ID
+//------------------------------------------------------------------------------
+static pkttransfer_rx_channel_t* pkttransfer_rx_channel_find(pkttransfer_t * pkttransfer_inst_p, uint32_t can_id)
+{
+    pkttransfer_rx_channel_t* channels_p = pkttransfer_inst_p->config.rx_channels_p;
+    size_t low = 0;
+    size_t high = pkttransfer_inst_p->config.rx_channels_cnt;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (channels_p[mid].can_id < can_id) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+
+    return ((low < pkttransfer_inst_p->config.rx_channels_cnt) && (channels_p[low].can_id == can_id)) ? &channels_p[low] : NULL;
+}
+
+//------------------------------------------------------------------------------
+// Process bytes of CAN message received over RX channel
+//
+// Decoder state of channel is loaded into instance, bytes are processed as usual, state is stored back
+//------------------------------------------------------------------------------
+static void pkttransfer_rx_channel_process(pkttransfer_t * pkttransfer_inst_p, pkttransfer_rx_channel_t* channel_p, const uint8_t* data_p, size_t size)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+
+    state_p->rx_channel_p = channel_p;
+    state_p->rx_buf_p = channel_p->buf_p;
+    state_p->rx_state = channel_p->rx_state;
+    state_p->rx_size = channel_p->rx_size;
+    state_p->rx_crc = channel_p->rx_crc;
+
+    pkttransfer_process_bytes(pkttransfer_inst_p, data_p, size);
+
+    channel_p->rx_state = state_p->rx_state;
+    channel_p->rx_size = state_p->rx_size;
+    channel_p->rx_crc = state_p->rx_crc;
+
+    state_p->rx_channel_p = NULL;
+    state_p->rx_buf_p = NULL;
+    state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
+    state_p->rx_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Prepare ISO-TP message to sending
+//
+// - flow control frame for packet being received is prepared first
+// - packet from TX queue is sent in single frame, or in first frame and consecutive frames
+// - payload and CRC (if it's enabled) are copied as is, without delimiters and byte-stuffing
+// - sending is paused after first frame and after each block until flow control frame is received,
+//   STmin is not waited, messages are paced by 'can_tx_msgs_per_task' and 'tx_is_avail_cb'
+//
+// 'out_p'          - pointer to output buffer of 'can_msg_size' bytes
+// 'can_id_tx_p'    - pointer to ID of prepared CAN message, output
+//
+// Returns - size of prepared message, 0 if there is nothing to be sent now
+//------------------------------------------------------------------------------
+static size_t pkttransfer_isotp_prepare_msg(pkttransfer_t * pkttransfer_inst_p, uint8_t* out_p, uint32_t* can_id_tx_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+    size_t msg_size = config_p->can_msg_size;
+
+    // Flow control frame requested by RX half
+    uint32_t fc_out = atomic_exchange(&state_p->isotp_fc_out, 0);
+    if (fc_out != 0) {
+        out_p[0] = (uint8_t)((PKTTRANSFER_ISOTP_PCI_FC << 4) | PKTTRANSFER_ISOTP_FC_FS(fc_out));
+        out_p[1] = config_p->can_isotp_block_size;
+        out_p[2] = 0;
+        *can_id_tx_p = config_p->can_isotp_id_fc;
+        return PKTTRANSFER_ISOTP_FC_SIZE;
+    }
+
+    if ((state_p->tx_size == 0) || state_p->isotp_tx_wait_fc) {
+        return 0;
+    }
+    *can_id_tx_p = state_p->can_id_tx;
+
+    size_t header_size;
+    size_t len = state_p->tx_size;
+
+    if (state_p->tx_state == PKTTRANSFER_STATE_DELIMITER) {
+        state_p->tx_crc = pkttransfer_crc_init(pkttransfer_inst_p);
+        if (len == state_p->crc_size) {
+            pkttransfer_store_tx_crc(pkttransfer_inst_p);
+        }
+
+        if (len <= PKTTRANSFER_ISOTP_SF_LEN_MAX) {
+            // single frame
+            out_p[0] = (uint8_t)((PKTTRANSFER_ISOTP_PCI_SF << 4) | len);
+            header_size = 1;
+        }
+        else if ((msg_size > PKTTRANSFER_CAN_MGS_SIZE) && (len <= msg_size - 2)) {
+            // single frame with escape (CAN FD)
+            out_p[0] = (uint8_t)(PKTTRANSFER_ISOTP_PCI_SF << 4);
+            out_p[1] = (uint8_t)len;
+            header_size = 2;
+        }
+        else {
+            // first frame, the rest is sent after flow control
+            if (len <= PKTTRANSFER_ISOTP_FF_LEN_MAX) {
+                out_p[0] = (uint8_t)((PKTTRANSFER_ISOTP_PCI_FF << 4) | (len >> 8));
+                out_p[1] = (uint8_t)len;
+                header_size = 2;
+            }
+            else {
+                out_p[0] = (uint8_t)(PKTTRANSFER_ISOTP_PCI_FF << 4);
+                out_p[1] = 0;
+                for (size_t i = 0; i < 4; i++) {
+                    out_p[2 + i] = (uint8_t)((uint32_t)len >> (8 * (3 - i)));
+                }
+                header_size = 6;
+            }
+            state_p->tx_state = PKTTRANSFER_STATE_BYTE;
+            state_p->isotp_tx_sn = 1;
+            state_p->isotp_tx_wait_fc = true;
+        }
+    }
+    else {
+        // consecutive frame
+        out_p[0] = (uint8_t)((PKTTRANSFER_ISOTP_PCI_CF << 4) | state_p->isotp_tx_sn);
+        state_p->isotp_tx_sn = (state_p->isotp_tx_sn + 1) & PKTTRANSFER_ISOTP_SN_MASK;
+        header_size = 1;
+
+        if ((state_p->isotp_tx_block_left != 0) && (--state_p->isotp_tx_block_left == 0)) {
+            state_p->isotp_tx_wait_fc = true;
+        }
+    }
+
+    size_t data_size = state_p->tx_size - state_p->sent_size;
+    if (data_size > msg_size - header_size) {
+        data_size = msg_size - header_size;
+    }
+    pkttransfer_isotp_copy_tx_bytes(pkttransfer_inst_p, &out_p[header_size], data_size);
+
+    if (state_p->sent_size == state_p->tx_size) {
+        state_p->sent_packets_cnt++;
+        pkttransfer_isotp_tx_end(pkttransfer_inst_p);
+    }
+
+    return header_size + data_size;
+}
+
+//------------------------------------------------------------------------------
+// Copy bytes of payload segments and CRC into ISO-TP message
+//------------------------------------------------------------------------------
+static void pkttransfer_isotp_copy_tx_bytes(pkttransfer_t * pkttransfer_inst_p, uint8_t* out_p, size_t size)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+
+    assert(state_p->sent_size + size <= state_p->tx_size);
+
+    while (size != 0) {
+        size_t payload_size = state_p->tx_size - state_p->crc_size;
+        const uint8_t* run_p;
+        size_t run_size;
+        if (state_p->sent_size < payload_size) {
+            run_p = &state_p->tx_payload_p[state_p->sent_size - state_p->tx_seg_start];
+            run_size = state_p->tx_seg_end - state_p->sent_size;
+        }
+        else {
+            run_p = &state_p->tx_crc_buf[state_p->sent_size - payload_size];
+            run_size = state_p->tx_size - state_p->sent_size;
+        }
+
+        if (run_size > size) {
+            run_size = size;
+        }
+
+        memcpy(out_p, run_p, run_size);
+        pkttransfer_complete_tx_bytes(pkttransfer_inst_p, run_p, run_size);
+        out_p += run_size;
+        size -= run_size;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Finish sending of ISO-TP packet (sent or aborted) and start the next packet from TX queue
+//------------------------------------------------------------------------------
+static void pkttransfer_isotp_tx_end(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+
+    state_p->sent_size = 0;
+    state_p->tx_size = 0;
+    state_p->tx_state = PKTTRANSFER_STATE_DELIMITER;
+    state_p->isotp_tx_wait_fc = false;
+    state_p->isotp_tx_block_left = 0;
+    pkttransfer_tx_queue_pop(pkttransfer_inst_p);
+}
+
+//------------------------------------------------------------------------------
+// Apply flow control passed by RX half (TX half only)
+//
+// - continue to send status resumes sending for the next block of consecutive frames
+// - overflow status aborts packet being sent
+// - flow control which isn't expected is skipped
+//------------------------------------------------------------------------------
+static void pkttransfer_isotp_take_fc(pkttransfer_t * pkttransfer_inst_p)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+
+    if (atomic_load(&state_p->isotp_fc_in) == 0) {
+        return;
+    }
+    uint32_t fc_in = atomic_exchange(&state_p->isotp_fc_in, 0);
+    if (state_p->isotp_tx_wait_fc == false) {
+        return;
+    }
+
+    if (PKTTRANSFER_ISOTP_FC_FS(fc_in) == PKTTRANSFER_ISOTP_FS_CTS) {
+        state_p->isotp_tx_wait_fc = false;
+        state_p->isotp_tx_block_left = PKTTRANSFER_ISOTP_FC_BS(fc_in);
+    }
+    else if (PKTTRANSFER_ISOTP_FC_FS(fc_in) == PKTTRANSFER_ISOTP_FS_OVFLW) {
+        state_p->isotp_tx_abort_cnt++;
+        pkttransfer_isotp_tx_end(pkttransfer_inst_p);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Request TX half to send flow control frame (RX half only)
+//------------------------------------------------------------------------------
+static void pkttransfer_isotp_post_fc(pkttransfer_t * pkttransfer_inst_p, uint8_t fc_status)
+{
+    atomic_store(&pkttransfer_inst_p->state.isotp_fc_out, PKTTRANSFER_ISOTP_FC_WORD(fc_status, 0));
+    pkttransfer_group_mark(pkttransfer_inst_p, true);
+}
+
+//------------------------------------------------------------------------------
+// Process received ISO-TP message
+//
+// - single and first frames start receiving of packet into RX buffer (packet being received is dropped)
+// - consecutive frames are stored while their sequence numbers are in order, otherwise packet is dropped
+// - flow control frames are to be sent by TX half after first frame and after each block of consecutive frames
+// - received flow control frames are passed to TX half which resumes or aborts sending
+//
+// Only 'isotp_fc_out' and 'isotp_fc_in' mailboxes of TX half are written, so halves can be run by different threads
+// - received packet is processed as frame: CRC is checked (if it's enabled), payload is passed to application
+//------------------------------------------------------------------------------
+static void pkttransfer_isotp_process_msg(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+
+    if (size == 0) {
+        return;
+    }
+
+    size_t len = data_p[0] & 0x0FU;
+    size_t header_size = 1;
+
+    switch (data_p[0] >> 4) {
+
+        case PKTTRANSFER_ISOTP_PCI_SF:
+            if ((len == 0) && (size > PKTTRANSFER_CAN_MGS_SIZE)) {
+                len = data_p[1];
+                header_size = 2;
+            }
+            if ((len == 0) || (len > size - header_size)) {
+                state_p->isotp_rx_err_cnt++;
+                break;
+            }
+            if (pkttransfer_isotp_rx_start(pkttransfer_inst_p, len)) {
+                pkttransfer_isotp_store_rx_bytes(pkttransfer_inst_p, &data_p[header_size], len);
+            }
+            break;
+
+        case PKTTRANSFER_ISOTP_PCI_FF:
+            if (size < 2) {
+                state_p->isotp_rx_err_cnt++;
+                break;
+            }
+            len = (len << 8) | data_p[1];
+            header_size = 2;
+            if (len == 0) {
+                if (size < 6) {
+                    state_p->isotp_rx_err_cnt++;
+                    break;
+                }
+                len = ((size_t)data_p[2] << 24) | ((size_t)data_p[3] << 16) | ((size_t)data_p[4] << 8) | data_p[5];
+                header_size = 6;
+            }
+
+            // Receiver answers with flow control in any case, sender aborts packet if it can't be received
+            if (pkttransfer_isotp_rx_start(pkttransfer_inst_p, len) == false) {
+                pkttransfer_isotp_post_fc(pkttransfer_inst_p, PKTTRANSFER_ISOTP_FS_OVFLW);
+                break;
+            }
+            pkttransfer_isotp_post_fc(pkttransfer_inst_p, PKTTRANSFER_ISOTP_FS_CTS);
+            state_p->isotp_rx_sn = 1;
+            state_p->isotp_rx_block_left = config_p->can_isotp_block_size;
+            pkttransfer_isotp_store_rx_bytes(pkttransfer_inst_p, &data_p[header_size], size - header_size);
+            break;
+
+        case PKTTRANSFER_ISOTP_PCI_CF:
+            if (state_p->rx_state != PKTTRANSFER_STATE_BYTE) {
+                // there is no packet being received - skip message
+                break;
+            }
+            if (len != state_p->isotp_rx_sn) {
+                // consecutive frame is lost - drop packet
+                state_p->isotp_rx_err_cnt++;
+                state_p->rx_size = 0;
+                state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
+                break;
+            }
+            state_p->isotp_rx_sn = (state_p->isotp_rx_sn + 1) & PKTTRANSFER_ISOTP_SN_MASK;
+            pkttransfer_isotp_store_rx_bytes(pkttransfer_inst_p, &data_p[1], size - 1);
+
+            // The last frame of block is received - allow sender to send the next block
+            if ((state_p->rx_state == PKTTRANSFER_STATE_BYTE) && (state_p->isotp_rx_block_left != 0) && (--state_p->isotp_rx_block_left == 0)) {
+                state_p->isotp_rx_block_left = config_p->can_isotp_block_size;
+                pkttransfer_isotp_post_fc(pkttransfer_inst_p, PKTTRANSFER_ISOTP_FS_CTS);
+            }
+            break;
+
+        case PKTTRANSFER_ISOTP_PCI_FC:
+            // sending is resumed or aborted by TX half (the latest flow control is kept)
+            atomic_store(&state_p->isotp_fc_in, PKTTRANSFER_ISOTP_FC_WORD(len, (size > 1) ? data_p[1] : 0));
+            pkttransfer_group_mark(pkttransfer_inst_p, true);
+            break;
+
+        default:
+            state_p->isotp_rx_err_cnt++;
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Start receiving of ISO-TP packet
+//
+// 'len'        - size of packet (payload and CRC)
+//
+// Returns - 'false' if packet is too long or there is no free loaned buffer
+//------------------------------------------------------------------------------
+static bool pkttransfer_isotp_rx_start(pkttransfer_t * pkttransfer_inst_p, size_t len)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+    pkttransfer_config_t* config_p = &(pkttransfer_inst_p->config);
+
+    // Packet being received is interrupted by the new one
+    if (state_p->rx_state != PKTTRANSFER_STATE_DELIMITER) {
+        state_p->isotp_rx_err_cnt++;
+        state_p->rx_size = 0;
+        state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
+    }
+
+    if (len > config_p->payload_size_max + state_p->crc_size) {
+        state_p->isotp_rx_err_cnt++;
+        return false;
+    }
+
+    state_p->sof_detections_cnt++;
+    pkttransfer_rx_buf_acquire(pkttransfer_inst_p);
+    if (state_p->rx_buf_p == NULL) {
+        return false;
+    }
+
+    state_p->rx_crc = pkttransfer_crc_init(pkttransfer_inst_p);
+    state_p->isotp_rx_len = len;
+    state_p->rx_state = PKTTRANSFER_STATE_BYTE;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Store bytes of ISO-TP packet and process packet if it's completely received
+//
+// Bytes after the end of packet (padding) are skipped
+//------------------------------------------------------------------------------
+static void pkttransfer_isotp_store_rx_bytes(pkttransfer_t * pkttransfer_inst_p, const uint8_t* data_p, size_t size)
+{
+    pkttransfer_state_t* state_p = &(pkttransfer_inst_p->state);
+
+    if (size > state_p->isotp_rx_len - state_p->rx_size) {
+        size = state_p->isotp_rx_len - state_p->rx_size;
+    }
+    pkttransfer_store_rx_bytes(pkttransfer_inst_p, data_p, size);
+
+    if (state_p->rx_size == state_p->isotp_rx_len) {
+        pkttransfer_process_frame(pkttransfer_inst_p);
+        state_p->rx_size = 0;
+        state_p->rx_state = PKTTRANSFER_STATE_DELIMITER;
+    }
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Find the first delimiter or escape byte
+//
+// SSE2 is used if it's available at compile time, otherwise machine words are scanned (SWAR)
+//
+// Returns - index of the first delimiter or escape byte, 'size' if there are no such bytes
+//------------------------------------------------------------------------------
+static size_t pkttransfer_scan_special(const uint8_t* data_p, size_t size)
+{
+    size_t idx = 0;
+
+#if (defined(PKTTRANSFER_SCAN_USE_SSE2))
+    const __m128i delimiters = _mm_set1_epi8((char)PKTTRANSFER_FRAME_DELIMITER_BYTE);
+    const __m128i escapes = _mm_set1_epi8((char)PKTTRANSFER_FRAME_ESCAPE_BYTE);
+
+    while (idx + 16 <= size) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(const void*)&data_p[idx]);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, escapes)));
+        if (mask != 0) {
+            return idx + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+        idx += 16;
+    }
+#endif
+
+    while (idx + sizeof(pkttransfer_swar_word_t) <= size) {
+        pkttransfer_swar_word_t word;
+        memcpy(&word, &data_p[idx], sizeof(word));
+        if (pkttransfer_swar_special_mask(word) != 0) {
+            break;
+        }
+        idx += sizeof(word);
+    }
+
+    while ((idx < size) && (data_p[idx] != PKTTRANSFER_FRAME_DELIMITER_BYTE) && (data_p[idx] != PKTTRANSFER_FRAME_ESCAPE_BYTE)) {
+        idx++;
+    }
+
+    return idx;
+}
+
+//------------------------------------------------------------------------------
+// Find delimiter and escape bytes in machine word
+//
+// Zero byte detection without carries between bytes: ((x & 0x7F..) + 0x7F..) | x has the high bit
+// cleared only in zero bytes, so the result is exact for each byte
+//
+// Returns - word with the high bit set in each delimiter or escape byte, 0 if there are no such bytes
+//------------------------------------------------------------------------------
+static pkttransfer_swar_word_t pkttransfer_swar_special_mask(pkttransfer_swar_word_t word)
+{
+    pkttransfer_swar_word_t x_delimiters = word ^ PKTTRANSFER_SWAR_DELIMITERS;
+    pkttransfer_swar_word_t x_escapes = word ^ PKTTRANSFER_SWAR_ESCAPES;
+
+    pkttransfer_swar_word_t nonzero_delimiters = ((x_delimiters & PKTTRANSFER_SWAR_LOW7) + PKTTRANSFER_SWAR_LOW7) | x_delimiters;
+    pkttransfer_swar_word_t nonzero_escapes = ((x_escapes & PKTTRANSFER_SWAR_LOW7) + PKTTRANSFER_SWAR_LOW7) | x_escapes;
+
+    return (~(nonzero_delimiters & nonzero_escapes) & ~PKTTRANSFER_SWAR_LOW7);
+}
+
+//------------------------------------------------------------------------------
+// Count delimiter and escape bytes
+//
+// SSE2 is used if it's available at compile time, otherwise machine words are counted (SWAR):
+// high bits of special bytes are moved to the low bits and summed up by multiplication into the top byte
+//------------------------------------------------------------------------------
+static size_t pkttransfer_count_special(const uint8_t* data_p, size_t size)
+{
+    size_t idx = 0;
+    size_t cnt = 0;
+
+#if (defined(PKTTRANSFER_SCAN_USE_SSE2))
+    const __m128i delimiters = _mm_set1_epi8((char)PKTTRANSFER_FRAME_DELIMITER_BYTE);
+    const __m128i escapes = _mm_set1_epi8((char)PKTTRANSFER_FRAME_ESCAPE_BYTE);
+
+    while (idx + 16 <= size) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(const void*)&data_p[idx]);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, escapes)));
+        cnt += (size_t)__builtin_popcount((unsigned int)mask);
+        idx += 16;
+    }
+#endif
+
+    while (idx + sizeof(pkttransfer_swar_word_t) <= size) {
+        pkttransfer_swar_word_t word;
+        memcpy(&word, &data_p[idx], sizeof(word));
+        pkttransfer_swar_word_t ones = pkttransfer_swar_special_mask(word) >> 7;
+        cnt += (size_t)((pkttransfer_swar_word_t)(ones * PKTTRANSFER_SWAR_ONES) >> (8 * (sizeof(word) - 1)));
+        idx += sizeof(word);
+    }
+
+    for (; idx < size; idx++) {
+        if ((data_p[idx] == PKTTRANSFER_FRAME_DELIMITER_BYTE) || (data_p[idx] == PKTTRANSFER_FRAME_ESCAPE_BYTE)) {
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+//------------------------------------------------------------------------------
+// Encode bytes with escape sequences into output buffer
+//
+// Runs of bytes without delimiters and escape symbols are copied at once
+//
+// 'out_cnt_p'  - pointer to number of bytes already in output buffer, updated
+//
+// Returns - 'false' if output buffer is too small
+//------------------------------------------------------------------------------
+static bool pkttransfer_encode_bytes(const uint8_t* data_p, size_t size, uint8_t* out_p, size_t out_cap, size_t* out_cnt_p)
+{
+    size_t out_cnt = *out_cnt_p;
+
+    while (size != 0) {
+        size_t run_size = pkttransfer_scan_special(data_p, size);
+
+        if (run_size != 0) {
+            if (run_size > out_cap - out_cnt) {
+                return false;
+            }
+            memcpy(&out_p[out_cnt], data_p, run_size);
+            out_cnt += run_size;
+        }
+        else {
+            if (out_cap - out_cnt < 2) {
+                return false;
+            }
+            out_p[out_cnt++] = PKTTRANSFER_FRAME_ESCAPE_BYTE;
+            out_p[out_cnt++] = (*data_p == PKTTRANSFER_FRAME_DELIMITER_BYTE) ? PKTTRANSFER_FRAME_ENCODED_DELIMITER_BYTE : PKTTRANSFER_FRAME_ENCODED_ESCAPE_BYTE;
+            run_size = 1;
+        }
+
+        data_p += run_size;
+        size -= run_size;
+    }
+
+    *out_cnt_p = out_cnt;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Calculate CRC of data with CRC engine (NULL - default CRC16) and store it to be sent after payload (LSB first)
+//
+// 'crc_buf_p'  - pointer to buffer of PKTTRANSFER_FRAME_CRC_SIZE_MAX bytes
+//
+// Returns - size of CRC
+//------------------------------------------------------------------------------
+static size_t pkttransfer_crc_trailer(const pkttransfer_crc_itf_t* crc_itf_p, const uint8_t* data_p, size_t size, uint8_t* crc_buf_p)
+{
+    size_t crc_size = PKTTRANSFER_FRAME_CRC_SIZE;
+    uint32_t crc;
+
+    if (crc_itf_p == NULL) {
+        crc = pkttransfer_crc16(data_p, size);
+    }
+    else {
+        assert((crc_itf_p->size != 0) && (crc_itf_p->size <= PKTTRANSFER_FRAME_CRC_SIZE_MAX));
+        crc_size = crc_itf_p->size;
+        crc = crc_itf_p->init_cb(crc_itf_p->crc_p);
+        crc = crc_itf_p->update_cb(crc_itf_p->crc_p, crc, data_p, size);
+        crc = crc_itf_p->final_cb(crc_itf_p->crc_p, crc);
+    }
+
+    for (size_t i = 0; i < crc_size; i++) {
+        crc_buf_p[i] = (uint8_t)(crc >> (8 * i));
+    }
+
+    return crc_size;
+}
+
+//------------------------------------------------------------------------------
+// Get initial value of CRC register of instance's CRC engine
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_crc_init(const pkttransfer_t * pkttransfer_inst_p)
+{
+    const pkttransfer_crc_itf_t* crc_itf_p = pkttransfer_inst_p->config.crc_itf_p;
+
+    if (crc_itf_p == NULL) {
+        return PKTTRANSFER_CRC16_INIT;
+    }
+
+    return crc_itf_p->init_cb(crc_itf_p->crc_p);
+}
+
+//------------------------------------------------------------------------------
+// Update CRC register with instance's CRC engine (default CRC16 is called directly)
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_crc_update(const pkttransfer_t * pkttransfer_inst_p, uint32_t crc, const uint8_t* data_p, size_t size)
+{
+    const pkttransfer_crc_itf_t* crc_itf_p = pkttransfer_inst_p->config.crc_itf_p;
+
+    if (crc_itf_p == NULL) {
+        if (size == 1) {
+            return pkttransfer_crc16_update_byte((uint16_t)crc, *data_p);
+        }
+        return pkttransfer_crc16_update((uint16_t)crc, data_p, size);
+    }
+
+    return crc_itf_p->update_cb(crc_itf_p->crc_p, crc, data_p, size);
+}
+
+//------------------------------------------------------------------------------
+// Get final CRC value of instance's CRC engine
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_crc_final(const pkttransfer_t * pkttransfer_inst_p, uint32_t crc)
+{
+    const pkttransfer_crc_itf_t* crc_itf_p = pkttransfer_inst_p->config.crc_itf_p;
+
+    if (crc_itf_p == NULL) {
+        return (crc ^ PKTTRANSFER_CRC16_XOROUT);
+    }
+
+    return crc_itf_p->final_cb(crc_itf_p->crc_p, crc);
+}
+
+//------------------------------------------------------------------------------
+// Built-in CRC16 engine callbacks
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_crc16_init_cb(const void * crc_p)
+{
+    (void)crc_p;
+    return PKTTRANSFER_CRC16_INIT;
+}
+
+static uint32_t pkttransfer_crc16_update_cb(const void * crc_p, uint32_t crc, const uint8_t* data_p, size_t size)
+{
+    (void)crc_p;
+    return pkttransfer_crc16_update((uint16_t)crc, data_p, size);
+}
+
+static uint32_t pkttransfer_crc16_final_cb(const void * crc_p, uint32_t crc)
+{
+    (void)crc_p;
+    return (crc ^ PKTTRANSFER_CRC16_XOROUT);
+}
+
+//------------------------------------------------------------------------------
+// Built-in CRC-32C engine callbacks
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_crc32c_init_cb(const void * crc_p)
+{
+    (void)crc_p;
+    return PKTTRANSFER_CRC32C_INIT;
+}
+
+static uint32_t pkttransfer_crc32c_update_cb(const void * crc_p, uint32_t crc, const uint8_t* data_p, size_t size)
+{
+    (void)crc_p;
+    return pkttransfer_crc32c_update(crc, data_p, size);
+}
+
+static uint32_t pkttransfer_crc32c_final_cb(const void * crc_p, uint32_t crc)
+{
+    (void)crc_p;
+    return (crc ^ PKTTRANSFER_CRC32C_XOROUT);
+}
+
+//------------------------------------------------------------------------------
+// Update CRC16 register with data using kernel selected by PKTTRANSFER_CRC16_KERNEL
+//
+// 'crc'    - reflected CRC register (without final xor)
+//
+// Returns - updated CRC register
+//------------------------------------------------------------------------------
+static uint16_t pkttransfer_crc16_update(uint16_t crc, const uint8_t* data_p, size_t size)
+{
+#if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_BITWISE)
+    return pkttransfer_crc16_update_bitwise(crc, data_p, size);
+#elif (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_TABLE)
+    return pkttransfer_crc16_update_table(crc, data_p, size);
+#elif (defined(PKTTRANSFER_CRC16_USE_CLMUL_X86))
+    if (size >= PKTTRANSFER_CRC16_CLMUL_MIN_SIZE) {
+        return atomic_load_explicit(&pkttransfer_crc16_block_kernel, memory_order_relaxed)(crc, data_p, size);
+    }
+    return pkttransfer_crc16_update_slice8(crc, data_p, size);
+#else
+    return pkttransfer_crc16_update_slice8(crc, data_p, size);
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Update CRC16 register with one byte (for calculation while sending and receiving)
+//------------------------------------------------------------------------------
+static uint16_t pkttransfer_crc16_update_byte(uint16_t crc, uint8_t byte)
+{
+#if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_BITWISE)
+    return pkttransfer_crc16_update_bitwise(crc, &byte, 1);
+#else
+    return (crc >> 8) ^ pkttransfer_crc16_table[0][(crc ^ byte) & 0xFF];
+#endif
+}
+
+#if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_BITWISE)
+//------------------------------------------------------------------------------
+// Update CRC16 register - bit-by-bit
+//------------------------------------------------------------------------------
+static uint16_t pkttransfer_crc16_update_bitwise(uint16_t crc, const uint8_t* data_p, size_t size)
+{
+    for (size_t byte_cnt = 0; byte_cnt < size; byte_cnt++) {
+        // RefIn = true (LSB-first)
+        crc ^= ((uint16_t)(data_p[byte_cnt])) & 0x00FF;
+        for (size_t i = 0; i < 8; ++i) {
+            crc = (crc & 0x0001) ? ((crc >> 1) ^ PKTTRANSFER_CRC16_POLY_REVERSED) : (crc >> 1);
+        }
+    }
+
+    return crc;
+}
+#endif
+
+#if (PKTTRANSFER_CRC16_KERNEL == PKTTRANSFER_CRC16_KERNEL_TABLE)
+//------------------------------------------------------------------------------
+// Update CRC16 register - byte-by-byte with one table
+//------------------------------------------------------------------------------
+static uint16_t pkttransfer_crc16_update_table(uint16_t crc, const uint8_t* data_p, size_t size)
+{
+    for (size_t byte_cnt = 0; byte_cnt < size; byte_cnt++) {
+        crc = (crc >> 8) ^ pkttransfer_crc16_table[0][(crc ^ data_p[byte_cnt]) & 0xFF];
+    }
+
+    return crc;
+}
+#endif
+
+#if (PKTTRANSFER_CRC16_TABLES_NUM == 8)
+//------------------------------------------------------------------------------
+// Update CRC16 register - slicing-by-8
+//
+// Each iteration processes 8 bytes with 8 independent table lookups,
+// tail (less than 8 bytes) is processed byte-by-byte
+//------------------------------------------------------------------------------
+static uint16_t pkttransfer_crc16_update_slice8(uint16_t crc, const uint8_t* data_p, size_t size)
+{
+    while (size >= 8) {
+        crc = pkttransfer_crc16_table[7][(data_p[0] ^ crc) & 0xFF] ^
+              pkttransfer_crc16_table[6][(data_p[1] ^ (crc >> 8)) & 0xFF] ^
+              pkttransfer_crc16_table[5][data_p[2]] ^
+              pkttransfer_crc16_table[4][data_p[3]] ^
+              pkttransfer_crc16_table[3][data_p[4]] ^
+              pkttransfer_crc16_table[2][data_p[5]] ^
+              pkttransfer_crc16_table[1][data_p[6]] ^
+              pkttransfer_crc16_table[0][data_p[7]];
+        data_p += 8;
+        size -= 8;
+    }
+
+    while (size != 0) {
+        crc = (crc >> 8) ^ pkttransfer_crc16_table[0][(crc ^ *data_p) & 0xFF];
+        data_p++;
+        size--;
+    }
+
+    return crc;
+}
+#endif
+
+#if (defined(PKTTRANSFER_CRC16_USE_CLMUL_X86))
+//------------------------------------------------------------------------------
+// Update CRC16 register - carry-less multiplication folding (PCLMULQDQ)
+//
+// - CRC register is xored into the first bytes of data (reflected CRC is linear)
+// - data is folded by 4 parallel 128-bit lanes, lanes are folded into one 128-bit block
+// - folded block is congruent to processed data, so it's passed through SLICE8 with zero register
+// - tail (less than 16 bytes) is processed by SLICE8
+//
+// Guaranteed - 'size' is not less than PKTTRANSFER_CRC16_CLMUL_MIN_SIZE
+//------------------------------------------------------------------------------
+__attribute__((target("pclmul,sse2")))
+static uint16_t pkttransfer_crc16_update_clmul_x86(uint16_t crc, const uint8_t* data_p, size_t size)
+{
+    assert(size >= PKTTRANSFER_CRC16_CLMUL_MIN_SIZE);
+
+    const __m128i k_512 = _mm_set_epi64x((long long)PKTTRANSFER_CRC16_CLMUL_K_512_LO, (long long)PKTTRANSFER_CRC16_CLMUL_K_512_HI);
+    const __m128i k_128 = _mm_set_epi64x((long long)PKTTRANSFER_CRC16_CLMUL_K_128_LO, (long long)PKTTRANSFER_CRC16_CLMUL_K_128_HI);
+
+    __m128i lane0 = _mm_loadu_si128((const __m128i*)(const void*)(data_p + 0));
+    __m128i lane1 = _mm_loadu_si128((const __m128i*)(const void*)(data_p + 16));
+    __m128i lane2 = _mm_loadu_si128((const __m128i*)(const void*)(data_p + 32));
+    __m128i lane3 = _mm_loadu_si128((const __m128i*)(const void*)(data_p + 48));
+    lane0 = _mm_xor_si128(lane0, _mm_cvtsi32_si128(crc));
+    data_p += 64;
+    size -= 64;
+
+    // Fold by 512 bits
+    while (size >= 64) {
+        lane0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane0, k_512, 0x00), _mm_clmulepi64_si128(lane0, k_512, 0x11)),
+                              _mm_loadu_si128((const __m128i*)(const void*)(data_p + 0)));
+        lane1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane1, k_512, 0x00), _mm_clmulepi64_si128(lane1, k_512, 0x11)),
+                              _mm_loadu_si128((const __m128i*)(const void*)(data_p + 16)));
+        lane2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane2, k_512, 0x00), _mm_clmulepi64_si128(lane2, k_512, 0x11)),
+                              _mm_loadu_si128((const __m128i*)(const void*)(data_p + 32)));
+        lane3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane3, k_512, 0x00), _mm_clmulepi64_si128(lane3, k_512, 0x11)),
+                              _mm_loadu_si128((const __m128i*)(const void*)(data_p + 48)));
+        data_p += 64;
+        size -= 64;
+    }
+
+    // Fold lanes into one block
+    __m128i block = lane0;
+    block = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(block, k_128, 0x00), _mm_clmulepi64_si128(block, k_128, 0x11)), lane1);
+    block = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(block, k_128, 0x00), _mm_clmulepi64_si128(block, k_128, 0x11)), lane2);
+    block = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(block, k_128, 0x00), _mm_clmulepi64_si128(block, k_128, 0x11)), lane3);
+
+    // Fold by 128 bits
+    while (size >= 16) {
+        block = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(block, k_128, 0x00), _mm_clmulepi64_si128(block, k_128, 0x11)),
+                              _mm_loadu_si128((const __m128i*)(const void*)data_p));
+        data_p += 16;
+        size -= 16;
+    }
+
+    // Reduce folded block and process tail
+    uint8_t folded[16];
+    _mm_storeu_si128((__m128i*)(void*)folded, block);
+    crc = pkttransfer_crc16_update_slice8(0x0000, folded, sizeof(folded));
+
+    return pkttransfer_crc16_update_slice8(crc, data_p, size);
+}
+
+//------------------------------------------------------------------------------
+// Select CRC16 block kernel by CPU features (first call only)
+//------------------------------------------------------------------------------
+static uint16_t pkttransfer_crc16_update_resolve(uint16_t crc, const uint8_t* data_p, size_t size)
+{
+    pkttransfer_crc16_kernel_t kernel = pkttransfer_crc16_update_slice8;
+
+    if (__builtin_cpu_supports("pclmul")) {
+        kernel = pkttransfer_crc16_update_clmul_x86;
+    }
+    atomic_store_explicit(&pkttransfer_crc16_block_kernel, kernel, memory_order_relaxed);
+
+    return kernel(crc, data_p, size);
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Update CRC-32C register with data (SSE4.2 instructions are used if CPU supports them)
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_crc32c_update(uint32_t crc, const uint8_t* data_p, size_t size)
+{
+#if (defined(PKTTRANSFER_CRC32C_USE_SSE42_X86))
+    if (size >= 8) {
+        return atomic_load_explicit(&pkttransfer_crc32c_block_kernel, memory_order_relaxed)(crc, data_p, size);
+    }
+#endif
+
+    return pkttransfer_crc32c_update_table(crc, data_p, size);
+}
+
+#if (defined(PKTTRANSFER_CRC32C_USE_SSE42_X86))
+//------------------------------------------------------------------------------
+// Select CRC-32C block kernel by CPU features (first call only)
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_crc32c_update_resolve(uint32_t crc, const uint8_t* data_p, size_t size)
+{
+    pkttransfer_crc32c_kernel_t kernel = pkttransfer_crc32c_update_table;
+
+    if (__builtin_cpu_supports("sse4.2")) {
+        kernel = pkttransfer_crc32c_update_sse42_x86;
+    }
+    atomic_store_explicit(&pkttransfer_crc32c_block_kernel, kernel, memory_order_relaxed);
+
+    return kernel(crc, data_p, size);
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Update CRC-32C register - byte-by-byte with one table
+//------------------------------------------------------------------------------
+static uint32_t pkttransfer_crc32c_update_table(uint32_t crc, const uint8_t* data_p, size_t size)
+{
+    for (size_t byte_cnt = 0; byte_cnt < size; byte_cnt++) {
+        crc = (crc >> 8) ^ pkttransfer_crc32c_table[(crc ^ data_p[byte_cnt]) & 0xFF];
+    }
+
+    return crc;
+}
+
+#if (defined(PKTTRANSFER_CRC32C_USE_SSE42_X86))
+//------------------------------------------------------------------------------
+// Update CRC-32C register - SSE4.2 'crc32' instruction
+//------------------------------------------------------------------------------
+__attribute__((target("sse4.2")))
+static uint32_t pkttransfer_crc32c_update_sse42_x86(uint32_t crc, const uint8_t* data_p, size_t size)
+{
+#if (defined(__x86_64__))
+    uint64_t crc64 = crc;
+    while (size >= 8) {
+        uint64_t word;
+        memcpy(&word, data_p, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data_p += 8;
+        size -= 8;
+    }
+    crc = (uint32_t)crc64;
+#else
+    while (size >= 4) {
+        uint32_t word;
+        memcpy(&word, data_p, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data_p += 4;
+        size -= 4;
+    }
+#endif
+
+    while (size != 0) {
+        crc = _mm_crc32_u8(crc, *data_p);
+        data_p++;
+        size--;
+    }
+
+    return crc;
+}
+#endif
+
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Initialize driver instance
+//-----------------------------------------------------------------------------
+void pkttransfer_init(pkttransfer_t* inst_p, const pkttransfer_hw_itf_t* hw_itf_p, const pkttransfer_app_itf_t* app_itf_p, const pkttransfer_config_t* config_p)
+{
+    assert((inst_p != NULL) && (hw_itf_p != NULL) && (app_itf_p != NULL) && (config_p != NULL));
+    assert(config_p->payload_size_max != 0);
+
+#if (defined(PKTTRANSFER_OVER_CAN))
+    // RX channels have their own buffers, loaned buffers are not used with them
+    bool rx_channels_mode = (config_p->rx_channels_p != NULL);
+    assert((rx_channels_mode == false) ||
+           ((config_p->rx_channels_cnt != 0) && (config_p->rx_pool_p == NULL) && (app_itf_p->app_rx_buf_get_cb == NULL)));
+
+    // ISO-TP flow control is sent for one packet being received at a time
+    assert((config_p->can_transport == PKTTRANSFER_CAN_TRANSPORT_FRAMES) ||
+           ((config_p->can_transport == PKTTRANSFER_CAN_TRANSPORT_ISOTP) && (rx_channels_mode == false)));
+#else
+    bool rx_channels_mode = false;
+#endif
+    (void)rx_channels_mode;
+
+    assert(rx_channels_mode || (config_p->buf_rx_p != NULL) || (config_p->rx_pool_p != NULL) || (app_itf_p->app_rx_buf_get_cb != NULL) ||
+           (config_p->rx_slots_p != NULL));
+    assert((config_p->rx_pool_p == NULL) || ((config_p->rx_pool_cnt != 0) && (config_p->rx_pool_cnt <= PKTTRANSFER_RX_POOL_CNT_MAX)));
+
+    // Delivery ring is another source of loaned buffers, size is power of two for free-running positions
+    assert((config_p->rx_slots_p == NULL) ||
+           ((rx_channels_mode == false) && (config_p->rx_pool_p == NULL) && (app_itf_p->app_rx_buf_get_cb == NULL) &&
+            (config_p->rx_slots_pool_p != NULL) && (config_p->rx_slots_cnt != 0) && (config_p->rx_slots_cnt <= 0x80000000UL) &&
+            ((config_p->rx_slots_cnt & (config_p->rx_slots_cnt - 1)) == 0)));
+    assert((config_p->rx_slots_p != NULL) || rx_channels_mode || (app_itf_p->app_pkt_cb != NULL));
+    assert((config_p->tx_slots_p == NULL) ? (config_p->buf_tx_p != NULL) :
+           ((config_p->tx_pool_p != NULL) && (config_p->tx_slots_cnt != 0) && (config_p->tx_slots_cnt <= PKTTRANSFER_TX_SLOTS_CNT_MAX)));
+
+#if (defined(PKTTRANSFER_OVER_UART))
+    // Byte-by-byte callbacks are not used in DMA modes
+    assert((hw_itf_p->tx_dma_start_cb != NULL) || (config_p->isr_tx_ring_p != NULL) || ((hw_itf_p->tx_cb != NULL) && (hw_itf_p->tx_is_avail_cb != NULL)));
+    assert((config_p->rx_dma_buf_p != NULL) || (config_p->isr_rx_ring_p != NULL) || ((hw_itf_p->rx_cb != NULL) && (hw_itf_p->rx_is_ready_cb != NULL)));
+    assert((config_p->rx_dma_buf_p == NULL) || (config_p->rx_dma_buf_size != 0));
+
+    // Interrupt rings are not combined with DMA, size is power of two for free-running positions
+    assert((config_p->isr_tx_ring_p == NULL) ||
+           ((hw_itf_p->tx_dma_start_cb == NULL) && (config_p->isr_tx_ring_size != 0) && (config_p->isr_tx_ring_size <= 0x80000000UL) &&
+            ((config_p->isr_tx_ring_size & (config_p->isr_tx_ring_size - 1)) == 0)));
+    assert((config_p->isr_rx_ring_p == NULL) ||
+           ((config_p->rx_dma_buf_p == NULL) && (config_p->isr_rx_ring_size != 0) && (config_p->isr_rx_ring_size <= 0x80000000UL) &&
+            ((config_p->isr_rx_ring_size & (config_p->isr_rx_ring_size - 1)) == 0)));
+#else
+    assert((rx_channels_mode ? (hw_itf_p->rx_any_cb != NULL) : (hw_itf_p->rx_cb != NULL)) && (hw_itf_p->rx_is_ready_cb != NULL) &&
+           (hw_itf_p->tx_cb != NULL) && (hw_itf_p->tx_is_avail_cb != NULL));
+    assert((config_p->can_msg_size == 0) ||
+           ((config_p->can_msg_size >= PKTTRANSFER_CAN_MGS_SIZE) && (config_p->can_msg_size <= PKTTRANSFER_CAN_FD_MGS_SIZE_MAX) &&
+            (pkttransfer_can_fd_dlc_size(config_p->can_msg_size) == config_p->can_msg_size)));
+#endif
+
+    assert((config_p->crc_itf_p == NULL) ||
+           ((config_p->crc_itf_p->init_cb != NULL) && (config_p->crc_itf_p->update_cb != NULL) && (config_p->crc_itf_p->final_cb != NULL) &&
+            (config_p->crc_itf_p->size != 0) && (config_p->crc_itf_p->size <= PKTTRANSFER_FRAME_CRC_SIZE_MAX)));
+
+#if (defined(PKTTRANSFER_OVER_UART))
+    assert((hw_itf_p->tx_dma_start_cb == NULL) || ((config_p->tx_dma_buf_p != NULL) && (config_p->tx_dma_chunk_size != 0)));
+#endif
+
+    memset(inst_p, 0x00, sizeof(pkttransfer_t));
+    memcpy(&(inst_p->hw_itf), hw_itf_p, sizeof(pkttransfer_hw_itf_t));
+    memcpy(&(inst_p->app_itf), app_itf_p, sizeof(pkttransfer_app_itf_t));
+    memcpy(&(inst_p->config), config_p, sizeof(pkttransfer_config_t));
+
+    inst_p->state.crc_size = (config_p->crc_itf_p == NULL) ? PKTTRANSFER_FRAME_CRC_SIZE : config_p->crc_itf_p->size;
+#if (defined(PKTTRANSFER_OVER_CAN))
+    if ((config_p->can_transport == PKTTRANSFER_CAN_TRANSPORT_ISOTP) && (config_p->can_isotp_crc == false)) {
+        inst_p->state.crc_size = 0;
+    }
+#endif
+
+    // Single packet in 'buf_tx_p' is the queue of one slot
+    if (config_p->tx_slots_p == NULL) {
+        inst_p->config.tx_slots_p = &(inst_p->state.tx_slot_single);
+        inst_p->config.tx_pool_p = config_p->buf_tx_p;
+        inst_p->config.tx_slots_cnt = 1;
+    }
+
+    // Each slot is free at position of its index on the first lap
+    size_t tx_slots_cnt = inst_p->config.tx_slots_cnt;
+    inst_p->state.tx_queue_wrap = (uint32_t)(tx_slots_cnt * (PKTTRANSFER_TX_QUEUE_WRAP_MAX / tx_slots_cnt));
+    for (size_t i = 0; i < tx_slots_cnt; i++) {
+        atomic_init(&inst_p->config.tx_slots_p[i].seq, (uint32_t)i);
+    }
+
+#if (defined(PKTTRANSFER_OVER_CAN))
+    if (config_p->can_msg_size == 0) {
+        inst_p->config.can_msg_size = PKTTRANSFER_CAN_MGS_SIZE;
+    }
+    if (config_p->can_tx_msgs_per_task == 0) {
+        inst_p->config.can_tx_msgs_per_task = 1;
+    }
+    if (config_p->can_rx_msgs_per_task == 0) {
+        inst_p->config.can_rx_msgs_per_task = 1;
+    }
+    if (rx_channels_mode) {
+        pkttransfer_rx_channels_sort(inst_p);
+    }
+#endif
+
+    // Loaned RX buffers are got for each frame, otherwise the single buffer is used for all frames
+    inst_p->state.rx_loan = (config_p->rx_pool_p != NULL) || (app_itf_p->app_rx_buf_get_cb != NULL) || (config_p->rx_slots_p != NULL);
+    if (inst_p->state.rx_loan) {
+        atomic_init(&inst_p->state.rx_pool_free, (config_p->rx_pool_p == NULL) ? 0 : (uint32_t)((1ULL << config_p->rx_pool_cnt) - 1));
+        for (size_t i = 0; (config_p->rx_slots_p != NULL) && (i < config_p->rx_slots_cnt); i++) {
+            config_p->rx_slots_p[i].data_p = &config_p->rx_slots_pool_p[i * (config_p->payload_size_max + inst_p->state.crc_size)];
+            config_p->rx_slots_p[i].size = 0;
+        }
+    }
+    else {
+        inst_p->state.rx_buf_p = config_p->buf_rx_p;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Deinitialize driver instance
+//-----------------------------------------------------------------------------
+void pkttransfer_deinit(pkttransfer_t* inst_p)
+{
+    assert(inst_p != NULL);
+
+    memset(inst_p, 0x00, sizeof(pkttransfer_t));
+}
+
+//------------------------------------------------------------------------------
+// Check if driver instance is initialized
+//------------------------------------------------------------------------------
+bool pkttransfer_is_init(const pkttransfer_t * inst_p)
+{
+    return ((inst_p != NULL) && (inst_p->config.payload_size_max != 0));
+}
+
+//-----------------------------------------------------------------------------
+// Send packet
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+pkttransfer_err_t pkttransfer_send(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size)
+#elif (defined(PKTTRANSFER_OVER_CAN))
+pkttransfer_err_t pkttransfer_send(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size, uint32_t can_id_tx)
+#endif
+{
+    assert(pkttransfer_is_init(inst_p));
+
+    pkttransfer_tx_slot_t* slot_p = pkttransfer_tx_queue_reserve(inst_p, size);
+    if (slot_p == NULL) {
+        return PKTTRANSFER_ERR_TX_OVF;
+    }
+
+    // Store payload in the memory of free slot, CRC is calculated while sending
+    pkttransfer_config_t* config_p = &(inst_p->config);
+    uint8_t* pool_p = &config_p->tx_pool_p[(size_t)(slot_p - config_p->tx_slots_p) * config_p->payload_size_max];
+    memcpy(pool_p, payload_p, size);
+    slot_p->seg.data_p = pool_p;
+    slot_p->seg.size = size;
+    slot_p->segs_p = &slot_p->seg;
+    slot_p->segs_cnt = 1;
+    slot_p->is_ref = false;
+#if (defined(PKTTRANSFER_OVER_CAN))
+    slot_p->can_id_tx = can_id_tx;
+#endif
+
+    pkttransfer_tx_queue_push(inst_p, slot_p);
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Send packet by reference (zero-copy)
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+pkttransfer_err_t pkttransfer_send_ref(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size)
+#elif (defined(PKTTRANSFER_OVER_CAN))
+pkttransfer_err_t pkttransfer_send_ref(pkttransfer_t* inst_p, const uint8_t* payload_p, size_t size, uint32_t can_id_tx)
+#endif
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert((payload_p != NULL) || (size == 0));
+
+    pkttransfer_tx_slot_t* slot_p = pkttransfer_tx_queue_reserve(inst_p, size);
+    if (slot_p == NULL) {
+        return PKTTRANSFER_ERR_TX_OVF;
+    }
+
+    // Keep reference to application's buffer, CRC is calculated while sending
+    slot_p->seg.data_p = payload_p;
+    slot_p->seg.size = size;
+    slot_p->segs_p = &slot_p->seg;
+    slot_p->segs_cnt = 1;
+    slot_p->is_ref = true;
+#if (defined(PKTTRANSFER_OVER_CAN))
+    slot_p->can_id_tx = can_id_tx;
+#endif
+
+    pkttransfer_tx_queue_push(inst_p, slot_p);
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Send packet gathered from segments (zero-copy)
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+pkttransfer_err_t pkttransfer_sendv(pkttransfer_t* inst_p, const pkttransfer_seg_t* segs_p, size_t segs_cnt)
+#elif (defined(PKTTRANSFER_OVER_CAN))
+pkttransfer_err_t pkttransfer_sendv(pkttransfer_t* inst_p, const pkttransfer_seg_t* segs_p, size_t segs_cnt, uint32_t can_id_tx)
+#endif
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert((segs_p != NULL) && (segs_cnt != 0));
+
+    // Total size of segments (without overflow of sum)
+    size_t size = 0;
+    for (size_t i = 0; i < segs_cnt; i++) {
+        assert((segs_p[i].data_p != NULL) || (segs_p[i].size == 0));
+        if (segs_p[i].size > inst_p->config.payload_size_max - size) {
+            return PKTTRANSFER_ERR_TX_OVF;
+        }
+        size += segs_p[i].size;
+    }
+
+    pkttransfer_tx_slot_t* slot_p = pkttransfer_tx_queue_reserve(inst_p, size);
+    if (slot_p == NULL) {
+        return PKTTRANSFER_ERR_TX_OVF;
+    }
+
+    // Keep reference to application's segments, CRC is calculated across them while sending
+    slot_p->segs_p = segs_p;
+    slot_p->segs_cnt = segs_cnt;
+    slot_p->is_ref = true;
+#if (defined(PKTTRANSFER_OVER_CAN))
+    slot_p->can_id_tx = can_id_tx;
+#endif
+
+    pkttransfer_tx_queue_push(inst_p, slot_p);
+
     return PKTTRANSFER_ERR_OK;
 }
 
+//-----------------------------------------------------------------------------
+// Get number of free slots in TX queue
+//-----------------------------------------------------------------------------
+size_t pkttransfer_get_tx_free_slots(const pkttransfer_t* inst_p)
+{
+    assert(pkttransfer_is_init(inst_p));
+
+    const pkttransfer_state_t* state_p = &(inst_p->state);
+    int32_t cnt = pkttransfer_tx_queue_pos_dist(inst_p, atomic_load(&state_p->tx_queue_deq), atomic_load(&state_p->tx_queue_enq));
+
+    return (inst_p->config.tx_slots_cnt - (size_t)cnt);
+}
+
+//-----------------------------------------------------------------------------
+// Get maximum number of packets in TX queue since initialization
+//-----------------------------------------------------------------------------
+size_t pkttransfer_get_tx_queue_hwm(const pkttransfer_t* inst_p)
+{
+    assert(pkttransfer_is_init(inst_p));
+
+    return atomic_load(&inst_p->state.tx_queue_hwm);
+}
+
 //-----------------------------------------------------------------------------
 // Set CAN ID to filter incoming CAN messages
 //-----------------------------------------------------------------------------
@@ -311,74 +2884,404 @@ void pkttransfer_set_can_id_rx(pkttransfer_t* inst_p, uint32_t can_id_rx)
 }
 #endif
 
+//-----------------------------------------------------------------------------
+// Indicate that DMA chunk is sent
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+void pkttransfer_tx_dma_complete(pkttransfer_t* inst_p)
+{
+    assert(pkttransfer_is_init(inst_p));
+
+    pkttransfer_state_t* state_p = &(inst_p->state);
+    uint32_t flags = atomic_load(&state_p->tx_dma_flags);
+    uint32_t new_flags;
+
+    // Release the busy chunk
+    do {
+        if (PKTTRANSFER_DMA_CHUNK_GET(flags, 0) == PKTTRANSFER_DMA_CHUNK_BUSY) {
+            new_flags = PKTTRANSFER_DMA_CHUNK_SET(flags, 0, PKTTRANSFER_DMA_CHUNK_FREE);
+        }
+        else if (PKTTRANSFER_DMA_CHUNK_GET(flags, 1) == PKTTRANSFER_DMA_CHUNK_BUSY) {
+            new_flags = PKTTRANSFER_DMA_CHUNK_SET(flags, 1, PKTTRANSFER_DMA_CHUNK_FREE);
+        }
+        else {
+            assert(false);
+            return;
+        }
+    } while (!atomic_compare_exchange_weak(&state_p->tx_dma_flags, &flags, new_flags));
+
+    // Send the next chunk back-to-back, the free chunk is to be filled by task
+    pkttransfer_tx_dma_try_start(inst_p);
+    pkttransfer_group_mark(inst_p, true);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Indicate that bytes are received into circular DMA buffer
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+void pkttransfer_rx_dma_notify(pkttransfer_t* inst_p, size_t head)
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert((inst_p->config.rx_dma_buf_p != NULL) && (head <= inst_p->config.rx_dma_buf_size));
+
+    // Position at the end of buffer is the same as at the beginning (transfer-complete)
+    if (head == inst_p->config.rx_dma_buf_size) {
+        head = 0;
+    }
+
+    atomic_store(&inst_p->state.rx_dma_head, (uint32_t)head);
+    pkttransfer_group_mark(inst_p, false);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Push received bytes into RX ring
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+size_t pkttransfer_isr_rx_push(pkttransfer_t* inst_p, const uint8_t* data_p, size_t size)
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert(inst_p->config.isr_rx_ring_p != NULL);
+    assert((data_p != NULL) || (size == 0));
+
+    pkttransfer_state_t* state_p = &(inst_p->state);
+    pkttransfer_config_t* config_p = &(inst_p->config);
+    uint32_t head = atomic_load(&state_p->isr_rx_head);
+    uint32_t free_size = (uint32_t)config_p->isr_rx_ring_size - (head - atomic_load(&state_p->isr_rx_tail));
+
+    // Bytes which don't fit are dropped, frame with them is dropped by CRC check
+    if (size > free_size) {
+        atomic_fetch_add(&state_p->isr_rx_ovf_cnt, (uint32_t)(size - free_size));
+        size = free_size;
+    }
+    if (size == 0) {
+        return 0;
+    }
+
+    // Free space is one or two spans (if it wraps around the end of ring)
+    size_t idx = head & (config_p->isr_rx_ring_size - 1);
+    size_t span_size = config_p->isr_rx_ring_size - idx;
+    if (span_size > size) {
+        span_size = size;
+    }
+    memcpy(&config_p->isr_rx_ring_p[idx], data_p, span_size);
+    memcpy(config_p->isr_rx_ring_p, &data_p[span_size], size - span_size);
+
+    atomic_store(&state_p->isr_rx_head, head + (uint32_t)size);
+    pkttransfer_group_mark(inst_p, false);
+
+    return size;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Pull encoded bytes to be sent from TX ring
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+size_t pkttransfer_isr_tx_pull(pkttransfer_t* inst_p, uint8_t* data_out_p, size_t size)
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert(inst_p->config.isr_tx_ring_p != NULL);
+    assert((data_out_p != NULL) || (size == 0));
+
+    pkttransfer_state_t* state_p = &(inst_p->state);
+    pkttransfer_config_t* config_p = &(inst_p->config);
+    uint32_t tail = atomic_load(&state_p->isr_tx_tail);
+    uint32_t used_size = atomic_load(&state_p->isr_tx_head) - tail;
+
+    if (size > used_size) {
+        size = used_size;
+    }
+    if (size == 0) {
+        return 0;
+    }
+
+    // Bytes are one or two spans (if they wrap around the end of ring)
+    size_t idx = tail & (config_p->isr_tx_ring_size - 1);
+    size_t span_size = config_p->isr_tx_ring_size - idx;
+    if (span_size > size) {
+        span_size = size;
+    }
+    memcpy(data_out_p, &config_p->isr_tx_ring_p[idx], span_size);
+    memcpy(&data_out_p[span_size], config_p->isr_tx_ring_p, size - span_size);
+
+    atomic_store(&state_p->isr_tx_tail, tail + (uint32_t)size);
+    pkttransfer_group_mark(inst_p, true);
+
+    return size;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Return loaned RX buffer into driver's pool
+//-----------------------------------------------------------------------------
+void pkttransfer_rx_release(pkttransfer_t* inst_p, const uint8_t* payload_p)
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert((inst_p->config.rx_pool_p != NULL) || (inst_p->config.rx_slots_p != NULL));
+
+    pkttransfer_config_t* config_p = &(inst_p->config);
+
+    // Delivery ring - the oldest polled packet is released
+    if (config_p->rx_slots_p != NULL) {
+        uint32_t tail = atomic_load(&inst_p->state.rx_slots_tail);
+        assert(tail != inst_p->state.rx_slots_poll);
+        assert(payload_p == config_p->rx_slots_p[tail & (config_p->rx_slots_cnt - 1)].data_p);
+        (void)payload_p;
+        atomic_store(&inst_p->state.rx_slots_tail, tail + 1);
+        return;
+    }
+    size_t buf_size = config_p->payload_size_max + inst_p->state.crc_size;
+
+    assert((payload_p >= config_p->rx_pool_p) && (payload_p < &config_p->rx_pool_p[config_p->rx_pool_cnt * buf_size]));
+    size_t idx = (size_t)(payload_p - config_p->rx_pool_p) / buf_size;
+    assert(payload_p == &config_p->rx_pool_p[idx * buf_size]);
+
+    uint32_t prev_mask = atomic_fetch_or(&inst_p->state.rx_pool_free, (uint32_t)(1UL << idx));
+    assert((prev_mask & (1UL << idx)) == 0);
+    (void)prev_mask;
+}
+
+//-----------------------------------------------------------------------------
+// Get the next received packet from deferred delivery ring
+//-----------------------------------------------------------------------------
+bool pkttransfer_poll_packet(pkttransfer_t* inst_p, const uint8_t** payload_pp, size_t* size_p)
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert(inst_p->config.rx_slots_p != NULL);
+    assert((payload_pp != NULL) && (size_p != NULL));
+
+    pkttransfer_config_t* config_p = &(inst_p->config);
+    pkttransfer_state_t* state_p = &(inst_p->state);
+
+    uint32_t poll = state_p->rx_slots_poll;
+    if (poll == atomic_load(&state_p->rx_slots_head)) {
+        return false;
+    }
+
+    const pkttransfer_rx_slot_t* slot_p = &config_p->rx_slots_p[poll & (config_p->rx_slots_cnt - 1)];
+    *payload_pp = slot_p->data_p;
+    *size_p = slot_p->size;
+    state_p->rx_slots_poll = poll + 1;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Get maximum number of packets in deferred delivery ring since initialization
+//-----------------------------------------------------------------------------
+size_t pkttransfer_get_rx_queue_hwm(const pkttransfer_t* inst_p)
+{
+    assert(pkttransfer_is_init(inst_p));
+
+    return inst_p->state.rx_slots_hwm;
+}
+
+//-----------------------------------------------------------------------------
+// Process received bytes passed from application
+//-----------------------------------------------------------------------------
+void pkttransfer_receive_bytes(pkttransfer_t* inst_p, const uint8_t* data_p, size_t size)
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert((data_p != NULL) || (size == 0));
+#if (defined(PKTTRANSFER_OVER_CAN))
+    assert(inst_p->config.can_transport == PKTTRANSFER_CAN_TRANSPORT_FRAMES);
+#endif
+
+    pkttransfer_process_bytes(inst_p, data_p, size);
+}
+
+//-----------------------------------------------------------------------------
+// Decode stream of received bytes into many payloads at once
+//-----------------------------------------------------------------------------
+size_t pkttransfer_decode_stream(pkttransfer_t* inst_p, const uint8_t* data_p, size_t size,
+                                 uint8_t* out_p, size_t out_cap, pkttransfer_frame_desc_t* descs_p, size_t descs_cap, size_t* descs_cnt_p)
+{
+    assert(pkttransfer_is_init(inst_p));
+    assert((data_p != NULL) || (size == 0));
+    assert((out_p != NULL) && (out_cap >= inst_p->config.payload_size_max));
+    assert((descs_p != NULL) && (descs_cap != 0) && (descs_cnt_p != NULL));
+#if (defined(PKTTRANSFER_OVER_CAN))
+    assert(inst_p->config.can_transport == PKTTRANSFER_CAN_TRANSPORT_FRAMES);
+#endif
+
+    struct pkttransfer_stream_s stream = {
+        .out_p = out_p,
+        .out_cap = out_cap,
+        .descs_p = descs_p,
+        .descs_cap = descs_cap,
+    };
+
+    inst_p->state.rx_stream_p = &stream;
+    size_t processed_size = pkttransfer_process_bytes(inst_p, data_p, size);
+    inst_p->state.rx_stream_p = NULL;
+
+    *descs_cnt_p = stream.descs_cnt;
+    return processed_size;
+}
+
 //-----------------------------------------------------------------------------
 // Driver task
 //-----------------------------------------------------------------------------
 void pkttransfer_task(pkttransfer_t* inst_p)
+{
+    pkttransfer_task_tx(inst_p);
+    pkttransfer_task_rx(inst_p);
+}
+
+//-----------------------------------------------------------------------------
+// Driver task - transmitting half
+//-----------------------------------------------------------------------------
+void pkttransfer_task_tx(pkttransfer_t* inst_p)
 {
     assert(pkttransfer_is_init(inst_p));
 
-    pkttransfer_hw_itf_t * hw_itf_p = &(inst_p->hw_itf);
+    (void)pkttransfer_task_tx_run(inst_p);
+}
+
+//-----------------------------------------------------------------------------
+// Driver task - receiving half
+//-----------------------------------------------------------------------------
+void pkttransfer_task_rx(pkttransfer_t* inst_p)
+{
+    assert(pkttransfer_is_init(inst_p));
 
-    // If there are bytes to be sent into the low level driver
-    if (pkttransfer_bytes_for_sending(inst_p) == true) {
+    (void)pkttransfer_task_rx_run(inst_p);
+}
 
-        // If low level driver is ready to send
-        if (hw_itf_p->tx_is_avail_cb(hw_itf_p->hw_p) == true) {
+//-----------------------------------------------------------------------------
+// Indicate that bytes are received by low level driver
+//-----------------------------------------------------------------------------
+void pkttransfer_rx_notify(pkttransfer_t* inst_p)
+{
+    assert(pkttransfer_is_init(inst_p));
 
-            #if (defined(PKTTRANSFER_OVER_UART))
+    pkttransfer_group_mark(inst_p, false);
+}
 
-                // Prepare byte
-                uint8_t transmit_byte = pkttransfer_prepare_byte(inst_p);
+//-----------------------------------------------------------------------------
+// Indicate that low level driver can accept bytes to be sent
+//-----------------------------------------------------------------------------
+void pkttransfer_tx_notify(pkttransfer_t* inst_p)
+{
+    assert(pkttransfer_is_init(inst_p));
 
-                // Send byte into low level driver
-                inst_p->hw_itf.tx_cb(hw_itf_p->hw_p, transmit_byte);
+    pkttransfer_group_mark(inst_p, true);
+}
 
-            #elif (defined(PKTTRANSFER_OVER_CAN))
+//-----------------------------------------------------------------------------
+// Initialize group of driver instances
+//-----------------------------------------------------------------------------
+void pkttransfer_group_init(pkttransfer_group_t* group_p, pkttransfer_t* const* insts_p, size_t insts_cnt, size_t budget)
+{
+    assert((group_p != NULL) && (insts_p != NULL));
+    assert((insts_cnt != 0) && (insts_cnt <= PKTTRANSFER_GROUP_INST_CNT_MAX));
+
+    memset(group_p, 0x00, sizeof(pkttransfer_group_t));
+    group_p->insts_p = insts_p;
+    group_p->insts_cnt = insts_cnt;
+    group_p->budget = budget;
+
+    for (size_t i = 0; i < insts_cnt; i++) {
+        assert(pkttransfer_is_init(insts_p[i]));
+        insts_p[i]->state.group_p = group_p;
+        insts_p[i]->state.group_bit = (uint32_t)(1UL << i);
+    }
 
-                // Prepare bytes
-                uint8_t transmit_buf[PKTTRANSFER_CAN_MGS_SIZE];
-                size_t transmit_buf_size = 0;
+    uint32_t all_mask = (uint32_t)((1ULL << insts_cnt) - 1);
+    atomic_init(&group_p->tx_pending, all_mask);
+    atomic_init(&group_p->rx_ready, all_mask);
+}
 
-                for (size_t i = 0; i < sizeof(transmit_buf); i++) {
-                    transmit_buf[i] = pkttransfer_prepare_byte(inst_p);
-                    transmit_buf_size++;
-                    if(pkttransfer_bytes_for_sending(inst_p) == false) {
-                        break;
-                    }
-                }
+//-----------------------------------------------------------------------------
+// Group task
+//-----------------------------------------------------------------------------
+size_t pkttransfer_group_task(pkttransfer_group_t* group_p)
+{
+    assert((group_p != NULL) && (group_p->insts_cnt != 0));
+
+    // Take readiness bits, bits set by interrupts meanwhile are left for the next call
+    uint32_t tx_mask = atomic_exchange(&group_p->tx_pending, 0);
+    uint32_t rx_mask = atomic_exchange(&group_p->rx_ready, 0);
+    uint32_t ready_mask = tx_mask | rx_mask;
+    size_t visited_cnt = 0;
+    size_t idx = group_p->next_idx;
+
+    // Visit ready instances in round-robin order within budget
+    for (size_t i = 0; (i < group_p->insts_cnt) && (ready_mask != 0); i++, idx = (idx + 1) % group_p->insts_cnt) {
+        uint32_t bit = (uint32_t)(1UL << idx);
+        if ((ready_mask & bit) == 0) {
+            continue;
+        }
+        if ((group_p->budget != 0) && (visited_cnt == group_p->budget)) {
+            break;
+        }
 
-                // Send bytes into low level driver
-                inst_p->hw_itf.tx_cb(hw_itf_p->hw_p, transmit_buf, transmit_buf_size, inst_p->state.can_id_tx);
-            #endif
+        // Only halves with their own bits set are run
+        pkttransfer_t* inst_p = group_p->insts_p[idx];
+        bool is_tx_pending = ((tx_mask & bit) != 0) && pkttransfer_task_tx_run(inst_p);
+        bool is_rx_ready = ((rx_mask & bit) != 0) && pkttransfer_task_rx_run(inst_p);
+        ready_mask &= ~bit;
+        visited_cnt++;
+        group_p->next_idx = (idx + 1) % group_p->insts_cnt;
+
+        // Instance can continue right now - keep it ready, stalled instance waits for its bits to be set again
+        if (is_tx_pending) {
+            atomic_fetch_or(&group_p->tx_pending, bit);
+        }
+        if (is_rx_ready) {
+            atomic_fetch_or(&group_p->rx_ready, bit);
         }
     }
 
+    // Instances which are out of budget keep their bits
+    if (ready_mask != 0) {
+        atomic_fetch_or(&group_p->tx_pending, tx_mask & ready_mask);
+        atomic_fetch_or(&group_p->rx_ready, rx_mask & ready_mask);
+    }
 
-    // If there are received bytes in the low level driver
-    if (hw_itf_p->rx_is_ready_cb(hw_itf_p->hw_p) == true) {
+    return visited_cnt;
+}
 
-        #if (defined(PKTTRANSFER_OVER_UART))
+//-----------------------------------------------------------------------------
+// Get exact size of encoded frame
+//-----------------------------------------------------------------------------
+size_t pkttransfer_encoded_size(const pkttransfer_crc_itf_t* crc_itf_p, const uint8_t* payload_p, size_t size)
+{
+    assert((payload_p != NULL) || (size == 0));
 
-            // Receive byte from low level driver
-            uint8_t received_byte = inst_p->hw_itf.rx_cb(hw_itf_p->hw_p);
+    uint8_t crc_buf[PKTTRANSFER_FRAME_CRC_SIZE_MAX];
+    size_t crc_size = pkttransfer_crc_trailer(crc_itf_p, payload_p, size, crc_buf);
 
-            // Process received byte, process received frame, pass payload to application
-            pkttransfer_process_byte(inst_p, received_byte);
+    return (2 + size + crc_size + pkttransfer_count_special(payload_p, size) + pkttransfer_count_special(crc_buf, crc_size));
+}
 
-        #elif (defined(PKTTRANSFER_OVER_CAN))
+//-----------------------------------------------------------------------------
+// Encode frame into buffer
+//-----------------------------------------------------------------------------
+size_t pkttransfer_encode_frame(const pkttransfer_crc_itf_t* crc_itf_p, const uint8_t* payload_p, size_t size, uint8_t* out_p, size_t out_cap)
+{
+    assert((payload_p != NULL) || (size == 0));
+    assert((out_p != NULL) || (out_cap == 0));
 
-            // Receive bytes from low level driver
-            uint8_t received_buf[PKTTRANSFER_CAN_MGS_SIZE];
-            size_t received_buf_size = hw_itf_p->rx_cb(hw_itf_p->hw_p, received_buf, inst_p->state.can_id_rx);
+    uint8_t crc_buf[PKTTRANSFER_FRAME_CRC_SIZE_MAX];
+    size_t crc_size = pkttransfer_crc_trailer(crc_itf_p, payload_p, size, crc_buf);
 
-            // Process received bytes, process received frame, pass payload to application
-            for (size_t i = 0; i < received_buf_size; i++) {
-                pkttransfer_process_byte(inst_p, received_buf[i]);
-            }
+    // | 0x7E |  PAYLOAD  |  CRC  | 0x7E |
+    size_t out_cnt = 0;
+    if (out_cap < 2) {
+        return 0;
+    }
+    out_p[out_cnt++] = PKTTRANSFER_FRAME_DELIMITER_BYTE;
 
-        #endif
+    if ((pkttransfer_encode_bytes(payload_p, size, out_p, out_cap - 1, &out_cnt) == false) ||
+        (pkttransfer_encode_bytes(crc_buf, crc_size, out_p, out_cap - 1, &out_cnt) == false)) {
+        return 0;
     }
+
+    out_p[out_cnt++] = PKTTRANSFER_FRAME_DELIMITER_BYTE;
+    return out_cnt;
 }
 
 //-----------------------------------------------------------------------------
@@ -386,34 +3289,17 @@ void pkttransfer_task(pkttransfer_t* inst_p)
 //-----------------------------------------------------------------------------
 uint16_t pkttransfer_crc16(const uint8_t* data_p, size_t size)
 {
-    uint16_t poly_reversed = 0x8408; // reversed poly (LSB-first) for 0x1021
-    uint16_t crc = 0xFFFF;
-    uint16_t xorout = 0xFFFF;
-    size_t byte_cnt = 0;
-    uint8_t out[2];
-
-    while(byte_cnt < size) {
-        // RefIn = true (LSB-first)
-        crc ^= ((uint16_t)(data_p[byte_cnt])) & 0x00FF;
-        for (size_t i = 0; i < 8; ++i) {
-            crc = (crc & 0x0001) ? ((crc >> 1) ^ poly_reversed) : (crc >> 1);
-        }
-        byte_cnt++;
-    }
-
-    // RefOut = true
-    out[0] = ((crc & 0xFF00) >> 8);
-    out[1] = (crc & 0x00FF);
+    // RefIn = true, RefOut = true - register is kept reflected by all kernels
+    uint16_t crc = pkttransfer_crc16_update(PKTTRANSFER_CRC16_INIT, data_p, size);
 
     // Xor before output
-    out[0] ^= (xorout & 0x00FF);
-    out[1] ^= ((xorout & 0xFF00) >> 8);
-
-    uint8_t tmp = out[0];
-    out[0] = out[1];
-    out[1] = tmp;
+    return (crc ^ PKTTRANSFER_CRC16_XOROUT);
+}
 
-    // Return as uint16
-    crc = ((out[1] & 0x00FF) << 8) | (out[0]);
-    return crc;
+//-----------------------------------------------------------------------------
+// Calculate CRC-32C (aka CRC-32-Castagnoli or CRC-32-iSCSI) for entire buffer
+//-----------------------------------------------------------------------------
+uint32_t pkttransfer_crc32c(const uint8_t* data_p, size_t size)
+{
+    return (pkttransfer_crc32c_update(PKTTRANSFER_CRC32C_INIT, data_p, size) ^ PKTTRANSFER_CRC32C_XOROUT);
 }
@@ -0,0 +1,454 @@
+//**************************************************************************************************
+// POSIX file descriptor backend of packets transfer driver
+//**************************************************************************************************
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "drv_pkttransfer_posix.h"
+
+#if (defined(PKTTRANSFER_OVER_UART))
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+//==================================================================================================
+//=========================================== MACROS ===============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Non-blocking call would block ('EWOULDBLOCK' can differ from 'EAGAIN' on some systems)
+//-----------------------------------------------------------------------------
+#if (EAGAIN == EWOULDBLOCK)
+    #define PKTTRANSFER_POSIX_IS_AGAIN(err) ((err) == EAGAIN)
+#else
+    #define PKTTRANSFER_POSIX_IS_AGAIN(err) (((err) == EAGAIN) || ((err) == EWOULDBLOCK))
+#endif
+
+//==================================================================================================
+//================================ PRIVATE FUNCTIONS DECLARATIONS ==================================
+//==================================================================================================
+
+static void pkttransfer_posix_tx_dma_start_cb(const void * hw_p, const uint8_t* data_p, size_t size);
+static void pkttransfer_posix_port_close(pkttransfer_posix_port_t* port_p, int err);
+static bool pkttransfer_posix_port_is_open(const pkttransfer_posix_port_t* port_p);
+static void pkttransfer_posix_stat_add(PKTTRANSFER_ATOMIC(size_t)* cnt_p, size_t value);
+static void pkttransfer_posix_port_read(pkttransfer_posix_port_t* port_p);
+static bool pkttransfer_posix_port_write(pkttransfer_posix_port_t* port_p);
+static void pkttransfer_posix_gw_dispatch(pkttransfer_posix_port_t* port_p);
+static void* pkttransfer_posix_gw_thread(void* arg_p);
+
+//==================================================================================================
+//=============================== PRIVATE FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//------------------------------------------------------------------------------
+// Start sending of DMA chunk - chunk is written by service of the port
+//------------------------------------------------------------------------------
+static void pkttransfer_posix_tx_dma_start_cb(const void * hw_p, const uint8_t* data_p, size_t size)
+{
+    pkttransfer_posix_port_t* port_p = (pkttransfer_posix_port_t*)hw_p;
+
+    assert(port_p->tx_chunk_p == NULL);
+
+    port_p->tx_chunk_p = data_p;
+    port_p->tx_chunk_size = size;
+    port_p->tx_chunk_done = 0;
+}
+
+//------------------------------------------------------------------------------
+// Mark port as closed, it isn't serviced anymore
+//------------------------------------------------------------------------------
+static void pkttransfer_posix_port_close(pkttransfer_posix_port_t* port_p, int err)
+{
+    atomic_store_explicit(&port_p->err, err, memory_order_relaxed);
+    atomic_store_explicit(&port_p->is_closed, true, memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+// Check if port is still serviced (servicing thread is the only writer of 'is_closed')
+//------------------------------------------------------------------------------
+static bool pkttransfer_posix_port_is_open(const pkttransfer_posix_port_t* port_p)
+{
+    return (atomic_load_explicit(&port_p->is_closed, memory_order_relaxed) == false);
+}
+
+//------------------------------------------------------------------------------
+// Add value to statistics counter (only servicing thread writes it, so there is no read-modify-write race)
+//------------------------------------------------------------------------------
+static void pkttransfer_posix_stat_add(PKTTRANSFER_ATOMIC(size_t)* cnt_p, size_t value)
+{
+    atomic_store_explicit(cnt_p, atomic_load_explicit(cnt_p, memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Read all available bytes into circular RX buffer and decode them after each call
+//
+// Decoded bytes are released at once, so each call can fill the whole buffer except one byte
+// (head equal to tail means empty buffer)
+//------------------------------------------------------------------------------
+static void pkttransfer_posix_port_read(pkttransfer_posix_port_t* port_p)
+{
+    while (pkttransfer_posix_port_is_open(port_p)) {
+        size_t head = port_p->rx_head;
+        size_t span = PKTTRANSFER_POSIX_RX_BUF_SIZE - head - ((head == 0) ? 1 : 0);
+
+        ssize_t res = read(port_p->fd, &port_p->rx_buf[head], span);
+        if (res > 0) {
+            port_p->rx_head = (head + (size_t)res) % PKTTRANSFER_POSIX_RX_BUF_SIZE;
+            pkttransfer_posix_stat_add(&port_p->read_calls_cnt, 1);
+            pkttransfer_posix_stat_add(&port_p->rx_bytes_cnt, (size_t)res);
+
+            pkttransfer_rx_dma_notify(port_p->inst_p, port_p->rx_head);
+            pkttransfer_task_rx(port_p->inst_p);
+        }
+        else if (res == 0) {
+            pkttransfer_posix_port_close(port_p, 0);
+        }
+        else if (errno == EINTR) {
+            continue;
+        }
+        else if (PKTTRANSFER_POSIX_IS_AGAIN(errno)) {
+            return;
+        }
+        else {
+            pkttransfer_posix_port_close(port_p, errno);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Encode queued packets into TX chunks and write them until fd is full
+//
+// Free chunk is filled while another one is written, so the next chunk is started as soon as the previous one is done
+//
+// Returns - true if there are unwritten bytes
+//------------------------------------------------------------------------------
+static bool pkttransfer_posix_port_write(pkttransfer_posix_port_t* port_p)
+{
+    while (pkttransfer_posix_port_is_open(port_p)) {
+        pkttransfer_task_tx(port_p->inst_p);
+        if (port_p->tx_chunk_p == NULL) {
+            return false;
+        }
+
+        ssize_t res = write(port_p->fd, &port_p->tx_chunk_p[port_p->tx_chunk_done], port_p->tx_chunk_size - port_p->tx_chunk_done);
+        if (res >= 0) {
+            port_p->tx_chunk_done += (size_t)res;
+            pkttransfer_posix_stat_add(&port_p->write_calls_cnt, 1);
+            pkttransfer_posix_stat_add(&port_p->tx_bytes_cnt, (size_t)res);
+
+            if (port_p->tx_chunk_done == port_p->tx_chunk_size) {
+                port_p->tx_chunk_p = NULL;
+                pkttransfer_tx_dma_complete(port_p->inst_p);
+            }
+        }
+        else if (errno == EINTR) {
+            continue;
+        }
+        else if (PKTTRANSFER_POSIX_IS_AGAIN(errno)) {
+            return true;
+        }
+        else {
+            pkttransfer_posix_port_close(port_p, errno);
+        }
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// Service port from gateway thread
+//
+// Port is serviced by the thread which got the first request, requests got by another threads meanwhile are
+// only counted and are serviced by the same thread in the next pass, so port is never serviced concurrently
+// and no readiness edge is lost
+//------------------------------------------------------------------------------
+static void pkttransfer_posix_gw_dispatch(pkttransfer_posix_port_t* port_p)
+{
+    if (atomic_fetch_add(&port_p->sched_cnt, 1) != 0) {
+        return;
+    }
+
+    uint32_t cnt;
+    do {
+        cnt = atomic_load(&port_p->sched_cnt);
+        (void)pkttransfer_posix_port_service(port_p);
+    } while (atomic_fetch_sub(&port_p->sched_cnt, cnt) != cnt);
+}
+
+//------------------------------------------------------------------------------
+// Gateway thread - wait for events of ports and service them until stop event
+//------------------------------------------------------------------------------
+static void* pkttransfer_posix_gw_thread(void* arg_p)
+{
+    pkttransfer_posix_gw_t* gw_p = (pkttransfer_posix_gw_t*)arg_p;
+    struct epoll_event events[PKTTRANSFER_POSIX_GW_EVENTS_MAX];
+
+    for (;;) {
+        int cnt = epoll_wait(gw_p->epoll_fd, events, PKTTRANSFER_POSIX_GW_EVENTS_MAX, -1);
+        if ((cnt < 0) && (errno != EINTR)) {
+            return NULL;
+        }
+
+        for (int i = 0; i < cnt; i++) {
+            pkttransfer_posix_port_t* port_p = (pkttransfer_posix_port_t*)events[i].data.ptr;
+            if (port_p == NULL) {
+                // Stop event isn't consumed, so it's got by all threads
+                return NULL;
+            }
+            pkttransfer_posix_gw_dispatch(port_p);
+        }
+    }
+}
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Initialize port
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_posix_port_init(pkttransfer_posix_port_t* port_p, pkttransfer_t* inst_p, int fd,
+                                              const pkttransfer_app_itf_t* app_itf_p, const pkttransfer_config_t* config_p)
+{
+    assert((port_p != NULL) && (inst_p != NULL) && (fd >= 0));
+    assert((app_itf_p != NULL) && (config_p != NULL));
+
+    int flags = fcntl(fd, F_GETFL);
+    if ((flags < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    port_p->inst_p = inst_p;
+    port_p->fd = fd;
+    port_p->kick_fd = -1;
+    port_p->gw_p = NULL;
+    port_p->tx_chunk_p = NULL;
+    port_p->tx_chunk_size = 0;
+    port_p->tx_chunk_done = 0;
+    port_p->rx_head = 0;
+    atomic_init(&port_p->sched_cnt, 0);
+    atomic_init(&port_p->is_closed, false);
+    atomic_init(&port_p->err, 0);
+    atomic_init(&port_p->read_calls_cnt, 0);
+    atomic_init(&port_p->write_calls_cnt, 0);
+    atomic_init(&port_p->rx_bytes_cnt, 0);
+    atomic_init(&port_p->tx_bytes_cnt, 0);
+
+    pkttransfer_hw_itf_t hw_itf = {
+        .hw_p = port_p,
+        .tx_dma_start_cb = pkttransfer_posix_tx_dma_start_cb,
+    };
+
+    pkttransfer_config_t config = *config_p;
+    config.tx_dma_buf_p = port_p->tx_buf;
+    config.tx_dma_chunk_size = PKTTRANSFER_POSIX_TX_CHUNK_SIZE;
+    config.rx_dma_buf_p = port_p->rx_buf;
+    config.rx_dma_buf_size = PKTTRANSFER_POSIX_RX_BUF_SIZE;
+    config.isr_rx_ring_p = NULL;
+    config.isr_rx_ring_size = 0;
+    config.isr_tx_ring_p = NULL;
+    config.isr_tx_ring_size = 0;
+
+    pkttransfer_init(inst_p, &hw_itf, app_itf_p, &config);
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Deinitialize port
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_port_deinit(pkttransfer_posix_port_t* port_p)
+{
+    assert((port_p != NULL) && (port_p->gw_p == NULL));
+
+    pkttransfer_deinit(port_p->inst_p);
+    port_p->fd = -1;
+}
+
+//-----------------------------------------------------------------------------
+// Service port
+//-----------------------------------------------------------------------------
+bool pkttransfer_posix_port_service(pkttransfer_posix_port_t* port_p)
+{
+    assert((port_p != NULL) && (pkttransfer_is_init(port_p->inst_p)));
+
+    // Reset wake counter before sending, so kick after this point isn't lost
+    if (port_p->kick_fd >= 0) {
+        uint64_t val;
+        ssize_t res = read(port_p->kick_fd, &val, sizeof(val));
+        (void)res;
+    }
+
+    pkttransfer_posix_port_read(port_p);
+    return pkttransfer_posix_port_write(port_p);
+}
+
+//-----------------------------------------------------------------------------
+// Check if port is closed
+//-----------------------------------------------------------------------------
+bool pkttransfer_posix_port_is_closed(const pkttransfer_posix_port_t* port_p)
+{
+    assert(port_p != NULL);
+
+    return atomic_load_explicit(&port_p->is_closed, memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+// Wake gateway to send queued packets
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_port_kick(pkttransfer_posix_port_t* port_p)
+{
+    assert((port_p != NULL) && (port_p->kick_fd >= 0));
+
+    // Overflow of counter (EAGAIN) means that port is already woken
+    uint64_t val = 1;
+    ssize_t res = write(port_p->kick_fd, &val, sizeof(val));
+    (void)res;
+}
+
+//-----------------------------------------------------------------------------
+// Initialize gateway
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_posix_gw_init(pkttransfer_posix_gw_t* gw_p)
+{
+    assert(gw_p != NULL);
+
+    gw_p->threads_cnt = 0;
+    gw_p->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (gw_p->epoll_fd < 0) {
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    // Level-triggered stop event, so it's got by all threads
+    gw_p->stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event event = { .events = EPOLLIN, .data.ptr = NULL };
+    if ((gw_p->stop_fd < 0) || (epoll_ctl(gw_p->epoll_fd, EPOLL_CTL_ADD, gw_p->stop_fd, &event) < 0)) {
+        int err = errno;
+        if (gw_p->stop_fd >= 0) {
+            close(gw_p->stop_fd);
+        }
+        close(gw_p->epoll_fd);
+        errno = err;
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Deinitialize gateway
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_gw_deinit(pkttransfer_posix_gw_t* gw_p)
+{
+    assert((gw_p != NULL) && (gw_p->threads_cnt == 0));
+
+    close(gw_p->stop_fd);
+    close(gw_p->epoll_fd);
+    gw_p->stop_fd = -1;
+    gw_p->epoll_fd = -1;
+}
+
+//-----------------------------------------------------------------------------
+// Add port into gateway
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_posix_gw_add(pkttransfer_posix_gw_t* gw_p, pkttransfer_posix_port_t* port_p)
+{
+    assert((gw_p != NULL) && (port_p != NULL) && (port_p->gw_p == NULL));
+
+    port_p->kick_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (port_p->kick_fd < 0) {
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    // Edge-triggered events: service reads and writes until EAGAIN
+    struct epoll_event event_fd = { .events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, .data.ptr = port_p };
+    struct epoll_event event_kick = { .events = EPOLLIN | EPOLLET, .data.ptr = port_p };
+
+    if (epoll_ctl(gw_p->epoll_fd, EPOLL_CTL_ADD, port_p->kick_fd, &event_kick) < 0) {
+        int err = errno;
+        close(port_p->kick_fd);
+        port_p->kick_fd = -1;
+        errno = err;
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    port_p->gw_p = gw_p;
+
+    if (epoll_ctl(gw_p->epoll_fd, EPOLL_CTL_ADD, port_p->fd, &event_fd) < 0) {
+        int err = errno;
+        (void)epoll_ctl(gw_p->epoll_fd, EPOLL_CTL_DEL, port_p->kick_fd, NULL);
+        close(port_p->kick_fd);
+        port_p->kick_fd = -1;
+        port_p->gw_p = NULL;
+        errno = err;
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Remove port from gateway
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_gw_remove(pkttransfer_posix_gw_t* gw_p, pkttransfer_posix_port_t* port_p)
+{
+    assert((gw_p != NULL) && (port_p != NULL) && (port_p->gw_p == gw_p) && (gw_p->threads_cnt == 0));
+
+    (void)epoll_ctl(gw_p->epoll_fd, EPOLL_CTL_DEL, port_p->fd, NULL);
+    (void)epoll_ctl(gw_p->epoll_fd, EPOLL_CTL_DEL, port_p->kick_fd, NULL);
+    close(port_p->kick_fd);
+    port_p->kick_fd = -1;
+    port_p->gw_p = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Start pool of gateway threads
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_posix_gw_start(pkttransfer_posix_gw_t* gw_p, size_t threads_cnt)
+{
+    assert((gw_p != NULL) && (gw_p->threads_cnt == 0));
+    assert((threads_cnt != 0) && (threads_cnt <= PKTTRANSFER_POSIX_GW_THREADS_MAX));
+
+    for (size_t i = 0; i < threads_cnt; i++) {
+        int err = pthread_create(&gw_p->threads[i], NULL, pkttransfer_posix_gw_thread, gw_p);
+        if (err != 0) {
+            pkttransfer_posix_gw_stop(gw_p);
+            errno = err;
+            return PKTTRANSFER_ERR_IO;
+        }
+        gw_p->threads_cnt++;
+    }
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Stop pool of gateway threads
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_gw_stop(pkttransfer_posix_gw_t* gw_p)
+{
+    assert(gw_p != NULL);
+
+    uint64_t val = 1;
+    ssize_t res = write(gw_p->stop_fd, &val, sizeof(val));
+    (void)res;
+
+    for (size_t i = 0; i < gw_p->threads_cnt; i++) {
+        (void)pthread_join(gw_p->threads[i], NULL);
+    }
+    gw_p->threads_cnt = 0;
+
+    // Reset stop event for the next start
+    res = read(gw_p->stop_fd, &val, sizeof(val));
+    (void)res;
+}
+
+#endif // PKTTRANSFER_OVER_UART
@@ -0,0 +1,361 @@
+//**************************************************************************************************
+// TESTS of POSIX file descriptor backend to be run on the host
+//**************************************************************************************************
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "drv_pkttransfer_posix.h"
+
+#if (defined(PKTTRANSFER_USE_TESTS)) && (defined(PKTTRANSFER_OVER_UART))
+
+#include <stdlib.h>
+#include <termios.h>
+#include <sys/socket.h>
+
+//==================================================================================================
+//=========================================== MACROS ===============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Payload and buffer sizes
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_TEST_POSIX_PAYLOAD_MAX  (256)
+#define RKTTRANSFER_TEST_POSIX_RX_BUF_SIZE  (RKTTRANSFER_TEST_POSIX_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE_MAX)
+#define RKTTRANSFER_TEST_POSIX_TX_SLOTS_CNT (8)
+
+//-----------------------------------------------------------------------------
+// Number of ports (pairs of connected ports), packets sent by each port and gateway threads
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_TEST_POSIX_PORTS_CNT    (32)
+#define RKTTRANSFER_TEST_POSIX_PKTS_CNT     (200)
+#define RKTTRANSFER_TEST_POSIX_THREADS_CNT  (4)
+
+//-----------------------------------------------------------------------------
+// Limit of waiting for packets (milliseconds)
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_TEST_POSIX_TIMEOUT_MS   (20000)
+
+//==================================================================================================
+//========================================== TYPEDEFS ==============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Test port - driver instance, its buffers and receiving state
+//-----------------------------------------------------------------------------
+typedef struct pkttransfer_test_posix_port_s {
+    pkttransfer_posix_port_t port;
+    pkttransfer_t   inst;
+    uint8_t         buf_rx[RKTTRANSFER_TEST_POSIX_RX_BUF_SIZE];
+    pkttransfer_tx_slot_t tx_slots[RKTTRANSFER_TEST_POSIX_TX_SLOTS_CNT];
+    uint8_t         tx_pool[RKTTRANSFER_TEST_POSIX_TX_SLOTS_CNT * RKTTRANSFER_TEST_POSIX_PAYLOAD_MAX];
+    size_t          sent_cnt;           // number of sent packets
+    size_t          received_cnt;       // number of received packets
+    pkttransfer_atomic_t* total_cnt_p;  // number of packets received by all ports (can be NULL)
+} pkttransfer_test_posix_port_t;
+
+//==================================================================================================
+//================================ PRIVATE FUNCTIONS DECLARATIONS ==================================
+//==================================================================================================
+
+static size_t pkttransfer_test_posix_payload(size_t idx, uint8_t* payload_p);
+static void pkttransfer_test_posix_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size);
+static void pkttransfer_test_posix_port_init(pkttransfer_test_posix_port_t* test_port_p, int fd, pkttransfer_atomic_t* total_cnt_p);
+static bool pkttransfer_test_posix_send_next(pkttransfer_test_posix_port_t* test_port_p);
+static void pkttransfer_test_posix_exchange(pkttransfer_test_posix_port_t* a_p, pkttransfer_test_posix_port_t* b_p);
+static void pkttransfer_test_posix_sleep_ms(long ms);
+
+static void pkttransfer_test_posix_socketpair(void);
+static void pkttransfer_test_posix_pty(void);
+static void pkttransfer_test_posix_gateway(void);
+
+//==================================================================================================
+//==================================== PRIVATE STATIC DATA =========================================
+//==================================================================================================
+
+static pkttransfer_test_posix_port_t test_ports[RKTTRANSFER_TEST_POSIX_PORTS_CNT];
+static pkttransfer_posix_gw_t test_gw;
+
+//==================================================================================================
+//=============================== PRIVATE FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Make payload of packet with index, payloads have different sizes and many delimiters and escape bytes
+//
+// Returns - size of payload
+//-----------------------------------------------------------------------------
+static size_t pkttransfer_test_posix_payload(size_t idx, uint8_t* payload_p)
+{
+    size_t size = 1 + ((idx * 37) % RKTTRANSFER_TEST_POSIX_PAYLOAD_MAX);
+
+    for (size_t i = 0; i < size; i++) {
+        size_t val = (idx + i) % 5;
+        payload_p[i] = (val == 0) ? 0x7E : (val == 1) ? 0x7D : (uint8_t)(idx ^ i);
+    }
+
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// Check received packet - packets are received in order of sending
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_posix_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size)
+{
+    pkttransfer_test_posix_port_t* test_port_p = (pkttransfer_test_posix_port_t*)app_p;
+    uint8_t expected[RKTTRANSFER_TEST_POSIX_PAYLOAD_MAX];
+
+    size_t expected_size = pkttransfer_test_posix_payload(test_port_p->received_cnt, expected);
+    assert(size == expected_size);
+    assert(memcmp(payload_p, expected, size) == 0);
+
+    test_port_p->received_cnt++;
+    if (test_port_p->total_cnt_p != NULL) {
+        atomic_fetch_add(test_port_p->total_cnt_p, 1);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Initialize test port with TX queue over file descriptor
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_posix_port_init(pkttransfer_test_posix_port_t* test_port_p, int fd, pkttransfer_atomic_t* total_cnt_p)
+{
+    pkttransfer_app_itf_t app_itf = {
+        .app_p = test_port_p,
+        .app_pkt_cb = pkttransfer_test_posix_app_pkt_cb,
+    };
+    pkttransfer_config_t config = {
+        .payload_size_max = RKTTRANSFER_TEST_POSIX_PAYLOAD_MAX,
+        .buf_rx_p = test_port_p->buf_rx,
+        .tx_slots_p = test_port_p->tx_slots,
+        .tx_pool_p = test_port_p->tx_pool,
+        .tx_slots_cnt = RKTTRANSFER_TEST_POSIX_TX_SLOTS_CNT,
+    };
+
+    test_port_p->sent_cnt = 0;
+    test_port_p->received_cnt = 0;
+    test_port_p->total_cnt_p = total_cnt_p;
+
+    pkttransfer_err_t res = pkttransfer_posix_port_init(&test_port_p->port, &test_port_p->inst, fd, &app_itf, &config);
+    assert(res == PKTTRANSFER_ERR_OK);
+    assert((fcntl(fd, F_GETFL) & O_NONBLOCK) != 0);
+}
+
+//-----------------------------------------------------------------------------
+// Queue the next test packet if there is free slot
+//
+// Returns - true if packet is queued
+//-----------------------------------------------------------------------------
+static bool pkttransfer_test_posix_send_next(pkttransfer_test_posix_port_t* test_port_p)
+{
+    uint8_t payload[RKTTRANSFER_TEST_POSIX_PAYLOAD_MAX];
+
+    if (test_port_p->sent_cnt == RKTTRANSFER_TEST_POSIX_PKTS_CNT) {
+        return false;
+    }
+
+    size_t size = pkttransfer_test_posix_payload(test_port_p->sent_cnt, payload);
+    if (pkttransfer_send(&test_port_p->inst, payload, size) != PKTTRANSFER_ERR_OK) {
+        return false;
+    }
+
+    test_port_p->sent_cnt++;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Exchange all test packets in both directions between two connected ports without gateway
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_posix_exchange(pkttransfer_test_posix_port_t* a_p, pkttransfer_test_posix_port_t* b_p)
+{
+    for (size_t i = 0; i < 100000; i++) {
+        while (pkttransfer_test_posix_send_next(a_p) == true) {
+        }
+        while (pkttransfer_test_posix_send_next(b_p) == true) {
+        }
+
+        (void)pkttransfer_posix_port_service(&a_p->port);
+        (void)pkttransfer_posix_port_service(&b_p->port);
+
+        if ((a_p->received_cnt == RKTTRANSFER_TEST_POSIX_PKTS_CNT) && (b_p->received_cnt == RKTTRANSFER_TEST_POSIX_PKTS_CNT)) {
+            break;
+        }
+    }
+
+    assert(a_p->received_cnt == RKTTRANSFER_TEST_POSIX_PKTS_CNT);
+    assert(b_p->received_cnt == RKTTRANSFER_TEST_POSIX_PKTS_CNT);
+    assert(atomic_load(&a_p->port.tx_bytes_cnt) == atomic_load(&b_p->port.rx_bytes_cnt));
+    assert(atomic_load(&b_p->port.tx_bytes_cnt) == atomic_load(&a_p->port.rx_bytes_cnt));
+    assert(a_p->inst.state.received_packets_cnt == RKTTRANSFER_TEST_POSIX_PKTS_CNT);
+    assert(b_p->inst.state.received_packets_cnt == RKTTRANSFER_TEST_POSIX_PKTS_CNT);
+
+    // Frames are written and read in batches, not one-by-one
+    assert(atomic_load(&a_p->port.write_calls_cnt) < RKTTRANSFER_TEST_POSIX_PKTS_CNT);
+    assert(atomic_load(&b_p->port.read_calls_cnt) < RKTTRANSFER_TEST_POSIX_PKTS_CNT);
+}
+
+//-----------------------------------------------------------------------------
+// Sleep for milliseconds
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_posix_sleep_ms(long ms)
+{
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000L };
+    (void)nanosleep(&ts, NULL);
+}
+
+//==================================================================================================
+//==================================== TEST FUNCTIONS DEFINITIONS ==================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Test of ports connected over socketpair, port is closed at end of file
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_posix_socketpair(void)
+{
+    int fds[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(res == 0);
+
+    pkttransfer_test_posix_port_t* a_p = &test_ports[0];
+    pkttransfer_test_posix_port_t* b_p = &test_ports[1];
+    pkttransfer_test_posix_port_init(a_p, fds[0], NULL);
+    pkttransfer_test_posix_port_init(b_p, fds[1], NULL);
+
+    pkttransfer_test_posix_exchange(a_p, b_p);
+
+    // Nothing to be written
+    assert(pkttransfer_posix_port_service(&a_p->port) == false);
+    assert(pkttransfer_posix_port_is_closed(&a_p->port) == false);
+
+    // End of file
+    close(fds[0]);
+    (void)pkttransfer_posix_port_service(&b_p->port);
+    assert(pkttransfer_posix_port_is_closed(&b_p->port) == true);
+    assert(atomic_load(&b_p->port.err) == 0);
+
+    pkttransfer_posix_port_deinit(&a_p->port);
+    pkttransfer_posix_port_deinit(&b_p->port);
+    close(fds[1]);
+}
+
+//-----------------------------------------------------------------------------
+// Test of ports connected over pseudo-terminal in raw mode (skipped if host has no pseudo-terminals)
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_posix_pty(void)
+{
+    int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master_fd < 0) {
+        return;
+    }
+
+    int res = grantpt(master_fd);
+    assert(res == 0);
+    res = unlockpt(master_fd);
+    assert(res == 0);
+
+    int slave_fd = open(ptsname(master_fd), O_RDWR | O_NOCTTY);
+    assert(slave_fd >= 0);
+
+    // No echo and no translation of bytes
+    struct termios tio;
+    res = tcgetattr(slave_fd, &tio);
+    assert(res == 0);
+    cfmakeraw(&tio);
+    res = tcsetattr(slave_fd, TCSANOW, &tio);
+    assert(res == 0);
+
+    pkttransfer_test_posix_port_t* a_p = &test_ports[0];
+    pkttransfer_test_posix_port_t* b_p = &test_ports[1];
+    pkttransfer_test_posix_port_init(a_p, master_fd, NULL);
+    pkttransfer_test_posix_port_init(b_p, slave_fd, NULL);
+
+    pkttransfer_test_posix_exchange(a_p, b_p);
+
+    pkttransfer_posix_port_deinit(&a_p->port);
+    pkttransfer_posix_port_deinit(&b_p->port);
+    close(slave_fd);
+    close(master_fd);
+}
+
+//-----------------------------------------------------------------------------
+// Test of gateway: pairs of ports connected over socketpairs exchange packets in both directions,
+// all ports are serviced by pool of threads
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_posix_gateway(void)
+{
+    pkttransfer_atomic_t total_cnt;
+    atomic_init(&total_cnt, 0);
+
+    pkttransfer_err_t err = pkttransfer_posix_gw_init(&test_gw);
+    assert(err == PKTTRANSFER_ERR_OK);
+
+    for (size_t i = 0; i < RKTTRANSFER_TEST_POSIX_PORTS_CNT; i += 2) {
+        int fds[2];
+        int res = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        assert(res == 0);
+
+        pkttransfer_test_posix_port_init(&test_ports[i], fds[0], &total_cnt);
+        pkttransfer_test_posix_port_init(&test_ports[i + 1], fds[1], &total_cnt);
+    }
+
+    for (size_t i = 0; i < RKTTRANSFER_TEST_POSIX_PORTS_CNT; i++) {
+        err = pkttransfer_posix_gw_add(&test_gw, &test_ports[i].port);
+        assert(err == PKTTRANSFER_ERR_OK);
+    }
+
+    err = pkttransfer_posix_gw_start(&test_gw, RKTTRANSFER_TEST_POSIX_THREADS_CNT);
+    assert(err == PKTTRANSFER_ERR_OK);
+
+    // Packets are queued from this thread while gateway threads send and receive them
+    uint32_t total_expected = RKTTRANSFER_TEST_POSIX_PORTS_CNT * RKTTRANSFER_TEST_POSIX_PKTS_CNT;
+    for (long ms = 0; (atomic_load(&total_cnt) != total_expected) && (ms < RKTTRANSFER_TEST_POSIX_TIMEOUT_MS); ms++) {
+        for (size_t i = 0; i < RKTTRANSFER_TEST_POSIX_PORTS_CNT; i++) {
+            bool is_sent = false;
+            while (pkttransfer_test_posix_send_next(&test_ports[i]) == true) {
+                is_sent = true;
+            }
+            if (is_sent == true) {
+                pkttransfer_posix_port_kick(&test_ports[i].port);
+            }
+        }
+        pkttransfer_test_posix_sleep_ms(1);
+    }
+
+    pkttransfer_posix_gw_stop(&test_gw);
+
+    assert(atomic_load(&total_cnt) == total_expected);
+    for (size_t i = 0; i < RKTTRANSFER_TEST_POSIX_PORTS_CNT; i++) {
+        assert(test_ports[i].received_cnt == RKTTRANSFER_TEST_POSIX_PKTS_CNT);
+        assert(pkttransfer_posix_port_is_closed(&test_ports[i].port) == false);
+    }
+
+    for (size_t i = 0; i < RKTTRANSFER_TEST_POSIX_PORTS_CNT; i++) {
+        int fd = test_ports[i].port.fd;
+        pkttransfer_posix_gw_remove(&test_gw, &test_ports[i].port);
+        pkttransfer_posix_port_deinit(&test_ports[i].port);
+        close(fd);
+    }
+
+    pkttransfer_posix_gw_deinit(&test_gw);
+}
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Run tests of POSIX backend
+//-----------------------------------------------------------------------------
+void pkttransfer_posix_run_tests(void)
+{
+    pkttransfer_test_posix_socketpair();
+    pkttransfer_test_posix_pty();
+    pkttransfer_test_posix_gateway();
+}
+
+#endif // PKTTRANSFER_USE_TESTS && PKTTRANSFER_OVER_UART
@@ -0,0 +1,381 @@
+//**************************************************************************************************
+// Shared memory rings of packets transfer driver
+//**************************************************************************************************
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "drv_pkttransfer_shm.h"
+
+//==================================================================================================
+//=========================================== MACROS ===============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Atomics in shared memory are used by several processes, so they must be lock-free
+//-----------------------------------------------------------------------------
+#if (ATOMIC_INT_LOCK_FREE != 2) || (ATOMIC_LLONG_LOCK_FREE != 2)
+    #error "Shared memory rings require lock-free 32-bit and 64-bit atomics"
+#endif
+
+//==================================================================================================
+//================================ PRIVATE FUNCTIONS DECLARATIONS ==================================
+//==================================================================================================
+
+static pkttransfer_shm_slot_t* pkttransfer_shm_slot(const pkttransfer_shm_t* shm_p, uint64_t pos);
+static size_t pkttransfer_shm_slot_stride(size_t payload_size_max);
+static void pkttransfer_shm_attach(pkttransfer_shm_t* shm_p, void* map_p, size_t map_size);
+
+//==================================================================================================
+//=============================== PRIVATE FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//------------------------------------------------------------------------------
+// Get slot of position in ring
+//------------------------------------------------------------------------------
+static pkttransfer_shm_slot_t* pkttransfer_shm_slot(const pkttransfer_shm_t* shm_p, uint64_t pos)
+{
+    const pkttransfer_shm_hdr_t* hdr_p = shm_p->hdr_p;
+
+    return (pkttransfer_shm_slot_t*)&shm_p->slots_p[(size_t)(pos % hdr_p->slots_cnt) * hdr_p->slot_stride];
+}
+
+//------------------------------------------------------------------------------
+// Get distance between slots - each slot starts on its own cache line,
+// so writer of one slot doesn't disturb readers of neighbouring slots
+//------------------------------------------------------------------------------
+static size_t pkttransfer_shm_slot_stride(size_t payload_size_max)
+{
+    size_t size = offsetof(pkttransfer_shm_slot_t, data) + payload_size_max;
+
+    return (size + PKTTRANSFER_CACHELINE_SIZE - 1) / PKTTRANSFER_CACHELINE_SIZE * PKTTRANSFER_CACHELINE_SIZE;
+}
+
+//------------------------------------------------------------------------------
+// Set mapping of ring
+//------------------------------------------------------------------------------
+static void pkttransfer_shm_attach(pkttransfer_shm_t* shm_p, void* map_p, size_t map_size)
+{
+    shm_p->hdr_p = (pkttransfer_shm_hdr_t*)map_p;
+    shm_p->slots_p = (uint8_t*)map_p + sizeof(pkttransfer_shm_hdr_t);
+    shm_p->map_size = map_size;
+    shm_p->read_pos = atomic_load_explicit(&shm_p->hdr_p->head, memory_order_acquire);
+    shm_p->is_reading = false;
+    shm_p->lost_cnt = 0;
+}
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Create ring in shared memory and map it
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_shm_create(pkttransfer_shm_t* shm_p, const char* name, uint32_t kind, size_t slots_cnt, size_t payload_size_max)
+{
+    assert((shm_p != NULL) && (name != NULL));
+    assert((kind == PKTTRANSFER_SHM_KIND_DELIVERY) || (kind == PKTTRANSFER_SHM_KIND_SUBMIT));
+    assert((slots_cnt != 0) && (slots_cnt <= UINT32_MAX));
+    assert((payload_size_max != 0) && (payload_size_max <= UINT32_MAX / 2));
+
+    size_t slot_stride = pkttransfer_shm_slot_stride(payload_size_max);
+    size_t map_size = sizeof(pkttransfer_shm_hdr_t) + (slots_cnt * slot_stride);
+
+    shm_p->hdr_p = NULL;
+
+    // Processes which have mapped the old ring keep it, new processes open the new one
+    shm_unlink(name);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    void* map_p = MAP_FAILED;
+    if (ftruncate(fd, (off_t)map_size) == 0) {
+        map_p = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    int err = errno;
+    close(fd);
+
+    if (map_p == MAP_FAILED) {
+        shm_unlink(name);
+        errno = err;
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    pkttransfer_shm_hdr_t* hdr_p = (pkttransfer_shm_hdr_t*)map_p;
+    hdr_p->version = PKTTRANSFER_SHM_VERSION;
+    hdr_p->kind = kind;
+    hdr_p->slots_cnt = (uint32_t)slots_cnt;
+    hdr_p->payload_size_max = (uint32_t)payload_size_max;
+    hdr_p->slot_stride = (uint32_t)slot_stride;
+    atomic_init(&hdr_p->drop_cnt, 0);
+    atomic_init(&hdr_p->head, 0);
+    atomic_init(&hdr_p->tail, 0);
+
+    pkttransfer_shm_attach(shm_p, map_p, map_size);
+
+    // Slot of submit ring is free for its first position, slot of delivery ring isn't written
+    for (size_t i = 0; i < slots_cnt; i++) {
+        pkttransfer_shm_slot_t* slot_p = pkttransfer_shm_slot(shm_p, i);
+        atomic_init(&slot_p->seq, (kind == PKTTRANSFER_SHM_KIND_SUBMIT) ? i : 0);
+        slot_p->size = 0;
+    }
+
+    // Ring is valid for another processes since this point
+    atomic_store_explicit(&hdr_p->magic, PKTTRANSFER_SHM_MAGIC, memory_order_release);
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Map existing ring
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_shm_open(pkttransfer_shm_t* shm_p, const char* name)
+{
+    assert((shm_p != NULL) && (name != NULL));
+
+    shm_p->hdr_p = NULL;
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    struct stat st;
+    void* map_p = MAP_FAILED;
+    if (fstat(fd, &st) == 0) {
+        if ((size_t)st.st_size >= sizeof(pkttransfer_shm_hdr_t)) {
+            map_p = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        else {
+            errno = EINVAL;
+        }
+    }
+    int err = errno;
+    close(fd);
+
+    if (map_p == MAP_FAILED) {
+        errno = err;
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    // Check that ring is initialized and matches size of object
+    size_t map_size = (size_t)st.st_size;
+    pkttransfer_shm_hdr_t* hdr_p = (pkttransfer_shm_hdr_t*)map_p;
+    if ((atomic_load_explicit(&hdr_p->magic, memory_order_acquire) != PKTTRANSFER_SHM_MAGIC) ||
+        (hdr_p->version != PKTTRANSFER_SHM_VERSION) ||
+        ((hdr_p->kind != PKTTRANSFER_SHM_KIND_DELIVERY) && (hdr_p->kind != PKTTRANSFER_SHM_KIND_SUBMIT)) ||
+        (hdr_p->slots_cnt == 0) || (hdr_p->payload_size_max == 0) ||
+        (hdr_p->slot_stride != pkttransfer_shm_slot_stride(hdr_p->payload_size_max)) ||
+        (map_size < sizeof(pkttransfer_shm_hdr_t) + ((size_t)hdr_p->slots_cnt * hdr_p->slot_stride))) {
+        munmap(map_p, map_size);
+        errno = EINVAL;
+        return PKTTRANSFER_ERR_IO;
+    }
+
+    pkttransfer_shm_attach(shm_p, map_p, map_size);
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Unmap ring
+//-----------------------------------------------------------------------------
+void pkttransfer_shm_close(pkttransfer_shm_t* shm_p)
+{
+    assert((shm_p != NULL) && (shm_p->hdr_p != NULL));
+
+    munmap(shm_p->hdr_p, shm_p->map_size);
+    shm_p->hdr_p = NULL;
+    shm_p->slots_p = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Remove name of shared memory object
+//-----------------------------------------------------------------------------
+void pkttransfer_shm_unlink(const char* name)
+{
+    assert(name != NULL);
+
+    shm_unlink(name);
+}
+
+//-----------------------------------------------------------------------------
+// Write received packet into delivery ring
+//-----------------------------------------------------------------------------
+void pkttransfer_shm_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size)
+{
+    const pkttransfer_shm_t* shm_p = (const pkttransfer_shm_t*)app_p;
+
+    assert((shm_p != NULL) && (shm_p->hdr_p != NULL) && (shm_p->hdr_p->kind == PKTTRANSFER_SHM_KIND_DELIVERY));
+
+    pkttransfer_shm_hdr_t* hdr_p = shm_p->hdr_p;
+    if (size > hdr_p->payload_size_max) {
+        atomic_fetch_add(&hdr_p->drop_cnt, 1);
+        return;
+    }
+
+    // Odd sequence number marks slot as being written, so readers of its previous packet detect overwriting
+    uint64_t pos = atomic_load_explicit(&hdr_p->head, memory_order_relaxed);
+    pkttransfer_shm_slot_t* slot_p = pkttransfer_shm_slot(shm_p, pos);
+
+    atomic_store_explicit(&slot_p->seq, (2 * pos) + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    slot_p->size = (uint32_t)size;
+    memcpy(slot_p->data, payload_p, size);
+
+    atomic_store_explicit(&slot_p->seq, (2 * pos) + 2, memory_order_release);
+    atomic_store_explicit(&hdr_p->head, pos + 1, memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Get the next packet of delivery ring in place
+//-----------------------------------------------------------------------------
+bool pkttransfer_shm_read(pkttransfer_shm_t* shm_p, const uint8_t** payload_pp, size_t* size_p)
+{
+    assert((shm_p != NULL) && (shm_p->hdr_p != NULL) && (shm_p->hdr_p->kind == PKTTRANSFER_SHM_KIND_DELIVERY));
+    assert((payload_pp != NULL) && (size_p != NULL) && (shm_p->is_reading == false));
+
+    pkttransfer_shm_hdr_t* hdr_p = shm_p->hdr_p;
+
+    for (;;) {
+        uint64_t head = atomic_load_explicit(&hdr_p->head, memory_order_acquire);
+        if (shm_p->read_pos == head) {
+            return false;
+        }
+
+        // Skip packets which are already overwritten
+        if ((head - shm_p->read_pos) > hdr_p->slots_cnt) {
+            shm_p->lost_cnt += (head - hdr_p->slots_cnt) - shm_p->read_pos;
+            shm_p->read_pos = head - hdr_p->slots_cnt;
+        }
+
+        // Slot is being overwritten by writer
+        pkttransfer_shm_slot_t* slot_p = pkttransfer_shm_slot(shm_p, shm_p->read_pos);
+        if (atomic_load_explicit(&slot_p->seq, memory_order_acquire) != ((2 * shm_p->read_pos) + 2)) {
+            shm_p->lost_cnt++;
+            shm_p->read_pos++;
+            continue;
+        }
+
+        // Size can be changed by overwriting, it's checked in 'pkttransfer_shm_read_done()'
+        size_t size = slot_p->size;
+        *payload_pp = slot_p->data;
+        *size_p = (size <= hdr_p->payload_size_max) ? size : hdr_p->payload_size_max;
+        shm_p->is_reading = true;
+        return true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Finish packet got with 'pkttransfer_shm_read()'
+//-----------------------------------------------------------------------------
+bool pkttransfer_shm_read_done(pkttransfer_shm_t* shm_p)
+{
+    assert((shm_p != NULL) && (shm_p->hdr_p != NULL) && (shm_p->is_reading == true));
+
+    // Reading of payload is completed before sequence number is checked again
+    atomic_thread_fence(memory_order_acquire);
+    pkttransfer_shm_slot_t* slot_p = pkttransfer_shm_slot(shm_p, shm_p->read_pos);
+    bool is_valid = (atomic_load_explicit(&slot_p->seq, memory_order_relaxed) == ((2 * shm_p->read_pos) + 2));
+
+    if (is_valid == false) {
+        shm_p->lost_cnt++;
+    }
+    shm_p->read_pos++;
+    shm_p->is_reading = false;
+
+    return is_valid;
+}
+
+//-----------------------------------------------------------------------------
+// Put packet into submit ring
+//-----------------------------------------------------------------------------
+pkttransfer_err_t pkttransfer_shm_submit(pkttransfer_shm_t* shm_p, const uint8_t* payload_p, size_t size)
+{
+    assert((shm_p != NULL) && (shm_p->hdr_p != NULL) && (shm_p->hdr_p->kind == PKTTRANSFER_SHM_KIND_SUBMIT));
+    assert((payload_p != NULL) && (size != 0) && (size <= shm_p->hdr_p->payload_size_max));
+
+    pkttransfer_shm_hdr_t* hdr_p = shm_p->hdr_p;
+    uint64_t pos = atomic_load_explicit(&hdr_p->head, memory_order_relaxed);
+    pkttransfer_shm_slot_t* slot_p;
+
+    // Reserve slot: it's free if its sequence number equals to position, it's still busy if it's behind
+    for (;;) {
+        slot_p = pkttransfer_shm_slot(shm_p, pos);
+        uint64_t seq = atomic_load_explicit(&slot_p->seq, memory_order_acquire);
+        if (seq == pos) {
+            if (atomic_compare_exchange_weak_explicit(&hdr_p->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (seq < pos) {
+            return PKTTRANSFER_ERR_TX_OVF;
+        }
+        else {
+            pos = atomic_load_explicit(&hdr_p->head, memory_order_relaxed);
+        }
+    }
+
+    slot_p->size = (uint32_t)size;
+    memcpy(slot_p->data, payload_p, size);
+    atomic_store_explicit(&slot_p->seq, pos + 1, memory_order_release);
+
+    return PKTTRANSFER_ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Pass packets of submit ring to driver
+//-----------------------------------------------------------------------------
+#if (defined(PKTTRANSFER_OVER_UART))
+size_t pkttransfer_shm_forward(pkttransfer_shm_t* shm_p, pkttransfer_t* inst_p)
+#elif (defined(PKTTRANSFER_OVER_CAN))
+size_t pkttransfer_shm_forward(pkttransfer_shm_t* shm_p, pkttransfer_t* inst_p, uint32_t can_id_tx)
+#endif
+{
+    assert((shm_p != NULL) && (shm_p->hdr_p != NULL) && (shm_p->hdr_p->kind == PKTTRANSFER_SHM_KIND_SUBMIT));
+    assert(pkttransfer_is_init(inst_p));
+
+    pkttransfer_shm_hdr_t* hdr_p = shm_p->hdr_p;
+    uint64_t pos = atomic_load_explicit(&hdr_p->tail, memory_order_relaxed);
+    size_t cnt = 0;
+
+    for (;;) {
+        // Slot isn't filled by producer yet
+        pkttransfer_shm_slot_t* slot_p = pkttransfer_shm_slot(shm_p, pos);
+        if (atomic_load_explicit(&slot_p->seq, memory_order_acquire) != (pos + 1)) {
+            break;
+        }
+
+        // Packet of wrong size written by broken producer is dropped, packet stays in ring if driver's queue is full
+        size_t size = slot_p->size;
+        if ((size != 0) && (size <= hdr_p->payload_size_max) && (size <= inst_p->config.payload_size_max)) {
+#if (defined(PKTTRANSFER_OVER_UART))
+            pkttransfer_err_t err = pkttransfer_send(inst_p, slot_p->data, size);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+            pkttransfer_err_t err = pkttransfer_send(inst_p, slot_p->data, size, can_id_tx);
+#endif
+            if (err != PKTTRANSFER_ERR_OK) {
+                break;
+            }
+            cnt++;
+        }
+
+        // Slot is free for the next lap
+        atomic_store_explicit(&slot_p->seq, pos + hdr_p->slots_cnt, memory_order_release);
+        pos++;
+        atomic_store_explicit(&hdr_p->tail, pos, memory_order_relaxed);
+    }
+
+    return cnt;
+}
@@ -0,0 +1,578 @@
+//**************************************************************************************************
+// TESTS of shared memory rings to be run on the host
+//**************************************************************************************************
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "drv_pkttransfer_shm.h"
+
+#if (defined(PKTTRANSFER_USE_TESTS))
+
+//==================================================================================================
+//=========================================== MACROS ===============================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Payload and buffer sizes
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_TEST_SHM_PAYLOAD_MAX    (64)
+#define RKTTRANSFER_TEST_SHM_RX_BUF_SIZE    (RKTTRANSFER_TEST_SHM_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE_MAX)
+#define RKTTRANSFER_TEST_SHM_FRAME_MAX      (2 * (RKTTRANSFER_TEST_SHM_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE_MAX) + 2)
+#define RKTTRANSFER_TEST_SHM_SLOTS_CNT      (4)
+#define RKTTRANSFER_TEST_SHM_TX_SLOTS_CNT   (8)
+#define RKTTRANSFER_TEST_SHM_NAME_SIZE      (64)
+#define RKTTRANSFER_TEST_SHM_RACE_PKTS_CNT  (200000)
+
+//==================================================================================================
+//================================ PRIVATE FUNCTIONS DECLARATIONS ==================================
+//==================================================================================================
+
+static size_t pkttransfer_test_shm_payload(size_t idx, uint8_t* payload_p);
+static void pkttransfer_test_shm_name(char* name_p, const char* suffix_p);
+static void pkttransfer_test_shm_inst_init(const pkttransfer_app_itf_t* app_itf_p);
+static void pkttransfer_test_shm_receive(size_t idx);
+static void pkttransfer_test_shm_check_read(pkttransfer_shm_t* shm_p, size_t idx);
+static size_t pkttransfer_test_shm_forward(pkttransfer_shm_t* shm_p);
+static void pkttransfer_test_shm_check_sent(size_t slot_idx, size_t idx);
+
+static void pkttransfer_test_shm_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size);
+static bool pkttransfer_test_shm_hw_tx_is_avail_cb(const void * hw_p);
+static bool pkttransfer_test_shm_hw_rx_is_ready_cb(const void * hw_p);
+#if (defined(PKTTRANSFER_OVER_UART))
+static void pkttransfer_test_shm_hw_uart_tx_cb(const void * hw_p, uint8_t byte);
+static uint8_t pkttransfer_test_shm_hw_uart_rx_cb(const void * hw_p);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+static void pkttransfer_test_shm_hw_can_tx_cb(const void * hw_p, const uint8_t* data_p, size_t size, uint32_t can_id_tx);
+static size_t pkttransfer_test_shm_hw_can_rx_cb(const void * hw_p, uint8_t* data_out_p, uint32_t can_id_rx);
+#endif
+
+static void pkttransfer_test_shm_delivery(void);
+static void pkttransfer_test_shm_delivery_lapped(void);
+static void pkttransfer_test_shm_delivery_race(void);
+static void pkttransfer_test_shm_submit(void);
+static void pkttransfer_test_shm_submit_process(void);
+
+//==================================================================================================
+//==================================== PRIVATE STATIC DATA =========================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Driver instance without hardware - packets are received with 'pkttransfer_receive_bytes()',
+// sent packets stay in TX queue (task isn't called)
+//-----------------------------------------------------------------------------
+static pkttransfer_t test_shm_inst;
+static uint8_t test_shm_rx_buf[RKTTRANSFER_TEST_SHM_RX_BUF_SIZE];
+static pkttransfer_tx_slot_t test_shm_tx_slots[RKTTRANSFER_TEST_SHM_TX_SLOTS_CNT];
+static uint8_t test_shm_tx_pool[RKTTRANSFER_TEST_SHM_TX_SLOTS_CNT * RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+
+static const pkttransfer_hw_itf_t test_shm_hw_itf = {
+    .hw_p = NULL,
+    .tx_is_avail_cb = pkttransfer_test_shm_hw_tx_is_avail_cb,
+    .rx_is_ready_cb = pkttransfer_test_shm_hw_rx_is_ready_cb,
+#if (defined(PKTTRANSFER_OVER_UART))
+    .tx_cb = pkttransfer_test_shm_hw_uart_tx_cb,
+    .rx_cb = pkttransfer_test_shm_hw_uart_rx_cb,
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    .tx_cb = pkttransfer_test_shm_hw_can_tx_cb,
+    .rx_cb = pkttransfer_test_shm_hw_can_rx_cb,
+#endif
+};
+
+static const pkttransfer_config_t test_shm_config = {
+    .payload_size_max = RKTTRANSFER_TEST_SHM_PAYLOAD_MAX,
+    .buf_rx_p = test_shm_rx_buf,
+    .tx_slots_p = test_shm_tx_slots,
+    .tx_pool_p = test_shm_tx_pool,
+    .tx_slots_cnt = RKTTRANSFER_TEST_SHM_TX_SLOTS_CNT,
+};
+
+//==================================================================================================
+//=============================== PRIVATE FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Make payload of packet with index, payloads have different sizes and delimiters
+//
+// Returns - size of payload
+//-----------------------------------------------------------------------------
+static size_t pkttransfer_test_shm_payload(size_t idx, uint8_t* payload_p)
+{
+    size_t size = 1 + ((idx * 13) % RKTTRANSFER_TEST_SHM_PAYLOAD_MAX);
+
+    for (size_t i = 0; i < size; i++) {
+        payload_p[i] = ((i % 7) == 0) ? 0x7E : (uint8_t)(idx + i);
+    }
+
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// Make name of shared memory object unique for test process
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_name(char* name_p, const char* suffix_p)
+{
+    int len = snprintf(name_p, RKTTRANSFER_TEST_SHM_NAME_SIZE, "/pkttransfer_test_%ld_%s", (long)getpid(), suffix_p);
+    assert((len > 0) && (len < RKTTRANSFER_TEST_SHM_NAME_SIZE));
+}
+
+//-----------------------------------------------------------------------------
+// Initialize driver instance without hardware
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_inst_init(const pkttransfer_app_itf_t* app_itf_p)
+{
+    pkttransfer_init(&test_shm_inst, &test_shm_hw_itf, app_itf_p, &test_shm_config);
+}
+
+//-----------------------------------------------------------------------------
+// Receive frame of packet with index by driver instance
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_receive(size_t idx)
+{
+    uint8_t payload[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+    uint8_t frame[RKTTRANSFER_TEST_SHM_FRAME_MAX];
+
+    size_t size = pkttransfer_test_shm_payload(idx, payload);
+    size_t frame_size = pkttransfer_encode_frame(NULL, payload, size, frame, sizeof(frame));
+    assert(frame_size != 0);
+
+    pkttransfer_receive_bytes(&test_shm_inst, frame, frame_size);
+}
+
+//-----------------------------------------------------------------------------
+// Read packet with index from delivery ring in place
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_check_read(pkttransfer_shm_t* shm_p, size_t idx)
+{
+    uint8_t expected[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+    const uint8_t* payload_p = NULL;
+    size_t size = 0;
+
+    size_t expected_size = pkttransfer_test_shm_payload(idx, expected);
+    assert(pkttransfer_shm_read(shm_p, &payload_p, &size) == true);
+    assert(size == expected_size);
+    assert(memcmp(payload_p, expected, size) == 0);
+    assert(pkttransfer_shm_read_done(shm_p) == true);
+}
+
+//-----------------------------------------------------------------------------
+// Pass packets of submit ring to driver instance
+//-----------------------------------------------------------------------------
+static size_t pkttransfer_test_shm_forward(pkttransfer_shm_t* shm_p)
+{
+#if (defined(PKTTRANSFER_OVER_UART))
+    return pkttransfer_shm_forward(shm_p, &test_shm_inst);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    return pkttransfer_shm_forward(shm_p, &test_shm_inst, 0x123);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Check packet with index in TX queue slot of driver instance
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_check_sent(size_t slot_idx, size_t idx)
+{
+    uint8_t expected[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+
+    size_t expected_size = pkttransfer_test_shm_payload(idx, expected);
+    assert(test_shm_tx_slots[slot_idx].seg.size == expected_size);
+    assert(memcmp(test_shm_tx_slots[slot_idx].seg.data_p, expected, expected_size) == 0);
+#if (defined(PKTTRANSFER_OVER_CAN))
+    assert(test_shm_tx_slots[slot_idx].can_id_tx == 0x123);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Application stub - packets aren't received by instance which only sends
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size)
+{
+    (void)app_p;
+    (void)payload_p;
+    (void)size;
+    assert(false);
+}
+
+//-----------------------------------------------------------------------------
+// Hardware stubs - hardware is never available
+//-----------------------------------------------------------------------------
+static bool pkttransfer_test_shm_hw_tx_is_avail_cb(const void * hw_p)
+{
+    (void)hw_p;
+    return false;
+}
+
+static bool pkttransfer_test_shm_hw_rx_is_ready_cb(const void * hw_p)
+{
+    (void)hw_p;
+    return false;
+}
+
+#if (defined(PKTTRANSFER_OVER_UART))
+static void pkttransfer_test_shm_hw_uart_tx_cb(const void * hw_p, uint8_t byte)
+{
+    (void)hw_p;
+    (void)byte;
+    assert(false);
+}
+
+static uint8_t pkttransfer_test_shm_hw_uart_rx_cb(const void * hw_p)
+{
+    (void)hw_p;
+    assert(false);
+    return 0;
+}
+#elif (defined(PKTTRANSFER_OVER_CAN))
+static void pkttransfer_test_shm_hw_can_tx_cb(const void * hw_p, const uint8_t* data_p, size_t size, uint32_t can_id_tx)
+{
+    (void)hw_p;
+    (void)data_p;
+    (void)size;
+    (void)can_id_tx;
+    assert(false);
+}
+
+static size_t pkttransfer_test_shm_hw_can_rx_cb(const void * hw_p, uint8_t* data_out_p, uint32_t can_id_rx)
+{
+    (void)hw_p;
+    (void)data_out_p;
+    (void)can_id_rx;
+    assert(false);
+    return 0;
+}
+#endif
+
+//==================================================================================================
+//==================================== TEST FUNCTIONS DEFINITIONS ==================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Test of delivery ring: packets received by driver are read in place by readers of another mapping
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_delivery(void)
+{
+    char name[RKTTRANSFER_TEST_SHM_NAME_SIZE];
+    pkttransfer_test_shm_name(name, "delivery");
+
+    pkttransfer_shm_t writer;
+    pkttransfer_shm_t reader_1;
+    pkttransfer_shm_t reader_2;
+    pkttransfer_err_t err = pkttransfer_shm_create(&writer, name, PKTTRANSFER_SHM_KIND_DELIVERY,
+                                                   RKTTRANSFER_TEST_SHM_SLOTS_CNT, RKTTRANSFER_TEST_SHM_PAYLOAD_MAX);
+    assert(err == PKTTRANSFER_ERR_OK);
+    err = pkttransfer_shm_open(&reader_1, name);
+    assert(err == PKTTRANSFER_ERR_OK);
+    assert((void*)reader_1.hdr_p != (void*)writer.hdr_p);
+
+    pkttransfer_app_itf_t app_itf = {
+        .app_p = &writer,
+        .app_pkt_cb = pkttransfer_shm_app_pkt_cb,
+    };
+    pkttransfer_test_shm_inst_init(&app_itf);
+
+    // Packets are read by reader in order
+    const uint8_t* payload_p = NULL;
+    size_t size = 0;
+    assert(pkttransfer_shm_read(&reader_1, &payload_p, &size) == false);
+    for (size_t i = 0; i < 3; i++) {
+        pkttransfer_test_shm_receive(i);
+    }
+    for (size_t i = 0; i < 3; i++) {
+        pkttransfer_test_shm_check_read(&reader_1, i);
+    }
+    assert(pkttransfer_shm_read(&reader_1, &payload_p, &size) == false);
+
+    // New reader starts with the next packet, readers have own positions
+    err = pkttransfer_shm_open(&reader_2, name);
+    assert(err == PKTTRANSFER_ERR_OK);
+    pkttransfer_test_shm_receive(3);
+    pkttransfer_test_shm_check_read(&reader_1, 3);
+    pkttransfer_test_shm_check_read(&reader_2, 3);
+    assert((reader_1.lost_cnt == 0) && (reader_2.lost_cnt == 0));
+
+    // Packet larger than slot is dropped
+    uint8_t big[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX + 1] = { 0 };
+    pkttransfer_shm_app_pkt_cb(&writer, big, sizeof(big));
+    assert(atomic_load(&writer.hdr_p->drop_cnt) == 1);
+    assert(pkttransfer_shm_read(&reader_1, &payload_p, &size) == false);
+
+    pkttransfer_deinit(&test_shm_inst);
+    pkttransfer_shm_close(&reader_2);
+    pkttransfer_shm_close(&reader_1);
+    pkttransfer_shm_close(&writer);
+
+    // Ring can't be opened after unlink
+    pkttransfer_shm_unlink(name);
+    assert(pkttransfer_shm_open(&reader_1, name) == PKTTRANSFER_ERR_IO);
+}
+
+//-----------------------------------------------------------------------------
+// Test of delivery ring overwritten by writer: late reader skips lost packets,
+// packet overwritten while it's read is detected
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_delivery_lapped(void)
+{
+    char name[RKTTRANSFER_TEST_SHM_NAME_SIZE];
+    pkttransfer_test_shm_name(name, "lapped");
+
+    pkttransfer_shm_t writer;
+    pkttransfer_shm_t reader;
+    pkttransfer_err_t err = pkttransfer_shm_create(&writer, name, PKTTRANSFER_SHM_KIND_DELIVERY,
+                                                   RKTTRANSFER_TEST_SHM_SLOTS_CNT, RKTTRANSFER_TEST_SHM_PAYLOAD_MAX);
+    assert(err == PKTTRANSFER_ERR_OK);
+    err = pkttransfer_shm_open(&reader, name);
+    assert(err == PKTTRANSFER_ERR_OK);
+
+    uint8_t payload[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+    size_t idx = 0;
+
+    // Writer is ahead of reader by more than ring
+    for (size_t i = 0; i < RKTTRANSFER_TEST_SHM_SLOTS_CNT + 2; i++) {
+        size_t size = pkttransfer_test_shm_payload(idx++, payload);
+        pkttransfer_shm_app_pkt_cb(&writer, payload, size);
+    }
+    for (size_t i = 2; i < RKTTRANSFER_TEST_SHM_SLOTS_CNT + 2; i++) {
+        pkttransfer_test_shm_check_read(&reader, i);
+    }
+    assert(reader.lost_cnt == 2);
+
+    // Packet is overwritten while it's read in place
+    size_t size = pkttransfer_test_shm_payload(idx++, payload);
+    pkttransfer_shm_app_pkt_cb(&writer, payload, size);
+
+    const uint8_t* payload_p = NULL;
+    assert(pkttransfer_shm_read(&reader, &payload_p, &size) == true);
+    for (size_t i = 0; i < RKTTRANSFER_TEST_SHM_SLOTS_CNT; i++) {
+        size = pkttransfer_test_shm_payload(idx++, payload);
+        pkttransfer_shm_app_pkt_cb(&writer, payload, size);
+    }
+    assert(pkttransfer_shm_read_done(&reader) == false);
+    assert(reader.lost_cnt == 3);
+
+    // The rest of packets are valid
+    for (size_t i = idx - RKTTRANSFER_TEST_SHM_SLOTS_CNT; i < idx; i++) {
+        pkttransfer_test_shm_check_read(&reader, i);
+    }
+    assert(pkttransfer_shm_read(&reader, &payload_p, &size) == false);
+    assert(reader.lost_cnt == 3);
+
+    pkttransfer_shm_close(&reader);
+    pkttransfer_shm_close(&writer);
+    pkttransfer_shm_unlink(name);
+}
+
+//-----------------------------------------------------------------------------
+// Test of delivery ring overwritten by writer process while reader copies packets:
+// each copy which is confirmed by 'pkttransfer_shm_read_done()' is intact, torn copies are rejected and counted
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_delivery_race(void)
+{
+    char name[RKTTRANSFER_TEST_SHM_NAME_SIZE];
+    pkttransfer_test_shm_name(name, "race");
+
+    pkttransfer_shm_t writer;
+    pkttransfer_shm_t reader;
+    pkttransfer_err_t err = pkttransfer_shm_create(&writer, name, PKTTRANSFER_SHM_KIND_DELIVERY,
+                                                   RKTTRANSFER_TEST_SHM_SLOTS_CNT, RKTTRANSFER_TEST_SHM_PAYLOAD_MAX);
+    assert(err == PKTTRANSFER_ERR_OK);
+    err = pkttransfer_shm_open(&reader, name);
+    assert(err == PKTTRANSFER_ERR_OK);
+
+    // Writer process laps ring many times, it yields sometimes to let reader run on single CPU too
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        uint8_t payload[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+        for (size_t i = 0; i < RKTTRANSFER_TEST_SHM_RACE_PKTS_CNT; i++) {
+            size_t size = pkttransfer_test_shm_payload(i, payload);
+            pkttransfer_shm_app_pkt_cb(&writer, payload, size);
+            if ((i % 7) == 0) {
+                sched_yield();
+            }
+        }
+        _exit(0);
+    }
+
+    // Reader copies each packet out of ring (sometimes yielding in the middle) and trusts copy only after check
+    size_t valid_cnt = 0;
+    size_t torn_cnt = 0;
+    bool is_writer_done = false;
+    int status = 0;
+    while (valid_cnt + reader.lost_cnt < RKTTRANSFER_TEST_SHM_RACE_PKTS_CNT) {
+        const uint8_t* payload_p = NULL;
+        size_t size = 0;
+        if (pkttransfer_shm_read(&reader, &payload_p, &size) == false) {
+            if (is_writer_done) {
+                break;
+            }
+            is_writer_done = (waitpid(pid, &status, WNOHANG) == pid);
+            continue;
+        }
+
+        size_t idx = (size_t)reader.read_pos;
+        uint8_t copy[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+        assert(size <= sizeof(copy));
+        for (size_t i = 0; i < size; i++) {
+            copy[i] = ((volatile const uint8_t*)payload_p)[i];
+            if (((idx % 3) == 0) && (i == size / 2)) {
+                sched_yield();
+            }
+        }
+
+        uint8_t expected[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+        size_t expected_size = pkttransfer_test_shm_payload(idx, expected);
+        bool is_intact = (size == expected_size) && (memcmp(copy, expected, size) == 0);
+        if (pkttransfer_shm_read_done(&reader)) {
+            assert(is_intact);
+            valid_cnt++;
+        }
+        else if (is_intact == false) {
+            torn_cnt++;
+        }
+    }
+    if (is_writer_done == false) {
+        is_writer_done = (waitpid(pid, &status, 0) == pid);
+    }
+    assert((is_writer_done) && (WIFEXITED(status)) && (WEXITSTATUS(status) == 0));
+
+    // Every packet is either read intact or counted as lost
+    assert(valid_cnt + reader.lost_cnt == RKTTRANSFER_TEST_SHM_RACE_PKTS_CNT);
+    assert(torn_cnt <= reader.lost_cnt);
+
+    pkttransfer_shm_close(&reader);
+    pkttransfer_shm_close(&writer);
+    pkttransfer_shm_unlink(name);
+}
+
+//-----------------------------------------------------------------------------
+// Test of submit ring: packets are passed to driver in order, ring is full until they are forwarded,
+// packets stay in ring while TX queue of driver is full
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_submit(void)
+{
+    char name[RKTTRANSFER_TEST_SHM_NAME_SIZE];
+    pkttransfer_test_shm_name(name, "submit");
+
+    pkttransfer_shm_t ring;
+    pkttransfer_shm_t producer;
+    pkttransfer_err_t err = pkttransfer_shm_create(&ring, name, PKTTRANSFER_SHM_KIND_SUBMIT,
+                                                   RKTTRANSFER_TEST_SHM_SLOTS_CNT, RKTTRANSFER_TEST_SHM_PAYLOAD_MAX);
+    assert(err == PKTTRANSFER_ERR_OK);
+    err = pkttransfer_shm_open(&producer, name);
+    assert(err == PKTTRANSFER_ERR_OK);
+
+    pkttransfer_app_itf_t app_itf = {
+        .app_pkt_cb = pkttransfer_test_shm_app_pkt_cb,
+    };
+    pkttransfer_test_shm_inst_init(&app_itf);
+
+    uint8_t payload[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+    size_t idx = 0;
+
+    // Two laps of ring fill TX queue of driver
+    for (size_t lap = 0; lap < 2; lap++) {
+        for (size_t i = 0; i < RKTTRANSFER_TEST_SHM_SLOTS_CNT; i++) {
+            size_t size = pkttransfer_test_shm_payload(idx++, payload);
+            assert(pkttransfer_shm_submit(&producer, payload, size) == PKTTRANSFER_ERR_OK);
+        }
+        assert(pkttransfer_shm_submit(&producer, payload, 1) == PKTTRANSFER_ERR_TX_OVF);
+        assert(pkttransfer_test_shm_forward(&ring) == RKTTRANSFER_TEST_SHM_SLOTS_CNT);
+        assert(pkttransfer_test_shm_forward(&ring) == 0);
+    }
+    assert(pkttransfer_get_tx_free_slots(&test_shm_inst) == 0);
+    for (size_t i = 0; i < RKTTRANSFER_TEST_SHM_TX_SLOTS_CNT; i++) {
+        pkttransfer_test_shm_check_sent(i, i);
+    }
+
+    // Packet waits in ring for free TX slot
+    size_t size = pkttransfer_test_shm_payload(idx, payload);
+    assert(pkttransfer_shm_submit(&producer, payload, size) == PKTTRANSFER_ERR_OK);
+    assert(pkttransfer_test_shm_forward(&ring) == 0);
+    assert(atomic_load(&ring.hdr_p->tail) == (2 * RKTTRANSFER_TEST_SHM_SLOTS_CNT));
+
+    pkttransfer_deinit(&test_shm_inst);
+    pkttransfer_test_shm_inst_init(&app_itf);
+    assert(pkttransfer_test_shm_forward(&ring) == 1);
+    pkttransfer_test_shm_check_sent(0, idx);
+
+    pkttransfer_deinit(&test_shm_inst);
+    pkttransfer_shm_close(&producer);
+    pkttransfer_shm_close(&ring);
+    pkttransfer_shm_unlink(name);
+}
+
+//-----------------------------------------------------------------------------
+// Test of submit ring shared with another process
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_shm_submit_process(void)
+{
+    char name[RKTTRANSFER_TEST_SHM_NAME_SIZE];
+    pkttransfer_test_shm_name(name, "process");
+
+    pkttransfer_shm_t ring;
+    pkttransfer_err_t err = pkttransfer_shm_create(&ring, name, PKTTRANSFER_SHM_KIND_SUBMIT,
+                                                   RKTTRANSFER_TEST_SHM_SLOTS_CNT, RKTTRANSFER_TEST_SHM_PAYLOAD_MAX);
+    assert(err == PKTTRANSFER_ERR_OK);
+
+    // Producer process maps ring by name
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        pkttransfer_shm_t producer;
+        uint8_t payload[RKTTRANSFER_TEST_SHM_PAYLOAD_MAX];
+        int res = 0;
+
+        if (pkttransfer_shm_open(&producer, name) != PKTTRANSFER_ERR_OK) {
+            _exit(1);
+        }
+        for (size_t i = 0; i < RKTTRANSFER_TEST_SHM_SLOTS_CNT; i++) {
+            size_t size = pkttransfer_test_shm_payload(i, payload);
+            if (pkttransfer_shm_submit(&producer, payload, size) != PKTTRANSFER_ERR_OK) {
+                res = 1;
+            }
+        }
+        pkttransfer_shm_close(&producer);
+        _exit(res);
+    }
+
+    int status = 0;
+    pid_t res = waitpid(pid, &status, 0);
+    assert((res == pid) && (WIFEXITED(status)) && (WEXITSTATUS(status) == 0));
+
+    pkttransfer_app_itf_t app_itf = {
+        .app_pkt_cb = pkttransfer_test_shm_app_pkt_cb,
+    };
+    pkttransfer_test_shm_inst_init(&app_itf);
+    assert(pkttransfer_test_shm_forward(&ring) == RKTTRANSFER_TEST_SHM_SLOTS_CNT);
+    for (size_t i = 0; i < RKTTRANSFER_TEST_SHM_SLOTS_CNT; i++) {
+        pkttransfer_test_shm_check_sent(i, i);
+    }
+
+    pkttransfer_deinit(&test_shm_inst);
+    pkttransfer_shm_close(&ring);
+    pkttransfer_shm_unlink(name);
+}
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Run tests of shared memory rings
+//-----------------------------------------------------------------------------
+void pkttransfer_shm_run_tests(void)
+{
+    pkttransfer_test_shm_delivery();
+    pkttransfer_test_shm_delivery_lapped();
+    pkttransfer_test_shm_delivery_race();
+    pkttransfer_test_shm_submit();
+    pkttransfer_test_shm_submit_process();
+}
+
+#endif // PKTTRANSFER_USE_TESTS
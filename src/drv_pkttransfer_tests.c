@@ -16,8 +16,9 @@
 // Payload and buffer sizes
 //-----------------------------------------------------------------------------
 #define RKTTRANSFER_TEST_PAYLOAD_MAX (512)
-#define RKTTRANSFER_TEST_TX_BUF_SIZE (RKTTRANSFER_TEST_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE)
-#define RKTTRANSFER_TEST_RX_BUF_SIZE (RKTTRANSFER_TEST_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE)
+#define RKTTRANSFER_TEST_TX_BUF_SIZE (RKTTRANSFER_TEST_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE_MAX)
+#define RKTTRANSFER_TEST_RX_BUF_SIZE (RKTTRANSFER_TEST_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE_MAX)
+#define RKTTRANSFER_TEST_FRAME_MAX   (2 * (RKTTRANSFER_TEST_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE_MAX) + 2)
 
 //==================================================================================================
 //========================================== TYPEDEFS ==============================================
@@ -41,6 +42,9 @@ typedef struct pkttransfer_test_packets_table_s {
 // Test callbacks
 //-----------------------------------------------------------------------------
 static void pkttransfer_test_app_pkt_cb(const void * app_p, const uint8_t* payload_p, size_t size);
+static void pkttransfer_test_app_tx_done_cb(const void * app_p, const uint8_t* payload_p, size_t size);
+static void pkttransfer_test_app_txv_done_cb(const void * app_p, const pkttransfer_seg_t* segs_p, size_t segs_cnt);
+static uint8_t* pkttransfer_test_app_rx_buf_get_cb(const void * app_p);
 
 static bool pkttransfer_test_hw_tx_is_avail_cb(const void * hw_p);
 static bool pkttransfer_test_hw_rx_is_ready_cb(const void * hw_p);
@@ -49,21 +53,56 @@ static bool pkttransfer_test_hw_rx_is_ready_cb(const void * hw_p);
 
 static void pkttransfer_test_hw_uart_tx_cb(const void * hw_p, uint8_t byte);
 static uint8_t pkttransfer_test_hw_uart_rx_cb(const void * hw_p);
+static void pkttransfer_test_hw_uart_tx_dma_start_cb(const void * hw_p, const uint8_t* data_p, size_t size);
+static bool pkttransfer_test_hw_port_tx_is_avail_cb(const void * hw_p);
+static bool pkttransfer_test_hw_port_rx_is_ready_cb(const void * hw_p);
+static void pkttransfer_test_hw_port_tx_cb(const void * hw_p, uint8_t byte);
+static uint8_t pkttransfer_test_hw_port_rx_cb(const void * hw_p);
+static void pkttransfer_test_hw_uart_tx_kick_cb(const void * hw_p);
 
 #elif (defined(PKTTRANSFER_OVER_CAN))
 
 static void pkttransfer_test_hw_can_tx_cb(const void * hw_p, const uint8_t* data_p, size_t size, uint32_t can_id);
 static size_t pkttransfer_test_hw_can_rx_cb(const void * hw_p, uint8_t* data_out_p, uint32_t can_id);
+static size_t pkttransfer_test_hw_can_rx_any_cb(const void * hw_p, uint8_t* data_out_p, uint32_t* can_id_out_p);
+static void pkttransfer_test_hw_can_tx_loop_cb(const void * hw_p, const uint8_t* data_p, size_t size, uint32_t can_id_tx);
+static size_t pkttransfer_test_hw_can_rx_loop_cb(const void * hw_p, uint8_t* data_out_p, uint32_t can_id_rx);
+static void pkttransfer_test_app_channel_pkt_cb(const void * app_p, uint32_t can_id_rx, const uint8_t* payload_p, size_t size);
 
 #endif
 
 //-----------------------------------------------------------------------------
 // Test functions
 //-----------------------------------------------------------------------------
+static uint16_t pkttransfer_test_crc16_reference(const uint8_t* data_p, size_t size);
+static size_t pkttransfer_test_prepare_long_packet(uint32_t* seed_p, uint32_t density, uint8_t* payload_p, size_t payload_size, uint8_t* frame_p);
+static void pkttransfer_test_prepare_queue_config(pkttransfer_config_t* config_p);
 static void pkttransfer_test_crc(void);
 static void pkttransfer_test_init(void);
 static void pkttransfer_test_send(void);
 static void pkttransfer_test_receive(void);
+static void pkttransfer_test_send_receive_long(void);
+static void pkttransfer_test_task_halves(void);
+static void pkttransfer_test_crc_engine(void);
+static void pkttransfer_test_send_queue(void);
+static void pkttransfer_test_send_queue_wrap(void);
+static void pkttransfer_test_send_ref(void);
+static void pkttransfer_test_sendv(void);
+static void pkttransfer_test_receive_loan(void);
+static void pkttransfer_test_rx_delivery(void);
+static void pkttransfer_test_encode_frame(void);
+static void pkttransfer_test_decode_stream(void);
+#if (defined(PKTTRANSFER_OVER_UART))
+static void pkttransfer_test_send_dma(void);
+static void pkttransfer_test_receive_dma(void);
+static void pkttransfer_test_group(void);
+static void pkttransfer_test_isr_rings(void);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+static void pkttransfer_test_can_fd(void);
+static void pkttransfer_test_can_msgs_per_task(void);
+static void pkttransfer_test_can_rx_channels(void);
+static void pkttransfer_test_can_isotp(void);
+#endif
 
 //==================================================================================================
 //==================================== PRIVATE STATIC DATA =========================================
@@ -76,9 +115,24 @@ static void pkttransfer_test_receive(void);
 #define RKTTRANSFER_TEST_CRC_DATA_SIZE (9)
 static const uint8_t pkttransfer_test_crc_data[RKTTRANSFER_TEST_CRC_DATA_SIZE] = {0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39};
 
+// CRC-32C test value
+#define RKTTRANSFER_TEST_CRC32C_CHECK (0xE3069283UL)
+
+// CRC kernels cross-check data (sizes and misalignments)
+#define RKTTRANSFER_TEST_CRC_CHECK_SIZE_MAX (300)
+#define RKTTRANSFER_TEST_CRC_CHECK_OFFSET_MAX (4)
+static uint8_t pkttransfer_test_crc_check_data[RKTTRANSFER_TEST_CRC_CHECK_SIZE_MAX + RKTTRANSFER_TEST_CRC_CHECK_OFFSET_MAX];
+
+// Long packets test sizes (around word and vector sizes) and escape densities (one of N bytes)
+#define RKTTRANSFER_TEST_LONG_SIZES_NUM (9)
+static const size_t pkttransfer_test_long_sizes[RKTTRANSFER_TEST_LONG_SIZES_NUM] = {7, 8, 15, 16, 17, 33, 64, 300, RKTTRANSFER_TEST_PAYLOAD_MAX};
+#define RKTTRANSFER_TEST_LONG_DENSITIES_NUM (4)
+static const uint32_t pkttransfer_test_long_densities[RKTTRANSFER_TEST_LONG_DENSITIES_NUM] = {1, 3, 29, 1000};
+
 // CAN ID test values
 #define RKTTRANSFER_TEST_CAN_ID_TX (1)
 #define RKTTRANSFER_TEST_CAN_ID_RX (2)
+#define RKTTRANSFER_TEST_CAN_ID_FC (3)
 
 // Test packets table
 #define RKTTRANSFER_TEST_TABLE_SIZE (4)
@@ -142,6 +196,8 @@ static pkttransfer_hw_itf_t hw_itf = {
 static pkttransfer_app_itf_t app_itf = {
     .app_p = NULL,
     .app_pkt_cb = pkttransfer_test_app_pkt_cb,
+    .app_tx_done_cb = pkttransfer_test_app_tx_done_cb,
+    .app_txv_done_cb = pkttransfer_test_app_txv_done_cb,
 };
 
 // Driver configuration
@@ -151,21 +207,106 @@ static pkttransfer_config_t config = {
     .buf_rx_p = rx_buf,
 };
 
+//-----------------------------------------------------------------------------
+// TX queue
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_TEST_TX_SLOTS_CNT (RKTTRANSFER_TEST_TABLE_SIZE - 1)
+static pkttransfer_tx_slot_t tx_slots[RKTTRANSFER_TEST_TX_SLOTS_CNT];
+static uint8_t tx_pool[RKTTRANSFER_TEST_TX_SLOTS_CNT * RKTTRANSFER_TEST_PAYLOAD_MAX];
+
 //-----------------------------------------------------------------------------
 // Hardware emulation
 //-----------------------------------------------------------------------------
-static uint8_t hardware_rx_buffer[2*RKTTRANSFER_TEST_PAYLOAD_MAX];
+static uint8_t hardware_rx_buffer[RKTTRANSFER_TEST_FRAME_MAX];
 static size_t hardware_rx_buffer_idx = 0;
 static size_t hardware_rx_buffer_size = 0;
 
-static uint8_t hardware_tx_buffer[2*RKTTRANSFER_TEST_PAYLOAD_MAX];
+static uint8_t hardware_tx_buffer[RKTTRANSFER_TEST_FRAME_MAX];
 static size_t hardware_tx_buffer_idx = 0;
 
+#if (defined(PKTTRANSFER_OVER_UART))
+#define RKTTRANSFER_TEST_DMA_CHUNK_SIZE (16)
+static uint8_t dma_buf[2 * RKTTRANSFER_TEST_DMA_CHUNK_SIZE];
+static const uint8_t* hardware_dma_chunk_p = NULL;
+static size_t hardware_dma_chunk_size = 0;
+
+#define RKTTRANSFER_TEST_DMA_RX_BUF_SIZE (48)
+#define RKTTRANSFER_TEST_DMA_RX_PART_MAX (20)
+static uint8_t hardware_dma_rx_buf[RKTTRANSFER_TEST_DMA_RX_BUF_SIZE];
+
+// UART ports of instances in group
+#define RKTTRANSFER_TEST_GROUP_INST_CNT (3)
+typedef struct {
+    size_t      calls_cnt;          // number of 'tx_is_avail_cb' and 'rx_is_ready_cb' calls
+    size_t      tx_calls_cnt;       // number of 'tx_is_avail_cb' calls
+    bool        tx_is_busy;         // TX FIFO is full, 'tx_is_avail_cb' returns false
+    uint8_t     tx_buf[RKTTRANSFER_TEST_FRAME_MAX];
+    size_t      tx_idx;
+    uint8_t     rx_buf[RKTTRANSFER_TEST_FRAME_MAX];
+    size_t      rx_idx;
+    size_t      rx_size;
+} pkttransfer_test_port_t;
+static pkttransfer_test_port_t hardware_ports[RKTTRANSFER_TEST_GROUP_INST_CNT];
+
+// Rings between interrupts and task
+#define RKTTRANSFER_TEST_ISR_RING_SIZE (16)
+static uint8_t isr_rx_ring[RKTTRANSFER_TEST_ISR_RING_SIZE];
+static uint8_t isr_tx_ring[RKTTRANSFER_TEST_ISR_RING_SIZE];
+static size_t hardware_tx_kick_cnt = 0;
+#elif (defined(PKTTRANSFER_OVER_CAN))
+static size_t hardware_can_msg_size = PKTTRANSFER_CAN_MGS_SIZE;
+static size_t hardware_can_msg_cnt = 0;
+static size_t hardware_can_tx_mailboxes = SIZE_MAX;     // number of free TX mailboxes, SIZE_MAX - unlimited
+
+// Received CAN messages of different IDs
+#define RKTTRANSFER_TEST_CAN_RX_MSGS_MAX (256)
+typedef struct {
+    uint32_t    can_id;
+    size_t      size;
+    uint8_t     data[PKTTRANSFER_CAN_FD_MGS_SIZE_MAX];
+} pkttransfer_test_can_msg_t;
+static pkttransfer_test_can_msg_t hardware_can_rx_msgs[RKTTRANSFER_TEST_CAN_RX_MSGS_MAX];
+static size_t hardware_can_rx_msgs_cnt = 0;
+static size_t hardware_can_rx_msgs_idx = 0;
+
+// Loopback of sent CAN messages into received ones
+static bool hardware_can_loopback = true;
+static size_t hardware_can_fc_cnt = 0;
+static uint8_t hardware_can_fc_status = 0;
+
+// Packets received over RX channels
+#define RKTTRANSFER_TEST_RX_CHANNELS_CNT (3)
+#define RKTTRANSFER_TEST_CAN_ID_UNKNOWN (15)
+static const uint32_t pkttransfer_test_rx_channel_ids[RKTTRANSFER_TEST_RX_CHANNELS_CNT] = {30, 10, 20};
+static uint8_t app_channel_buffers[RKTTRANSFER_TEST_RX_CHANNELS_CNT][RKTTRANSFER_TEST_PAYLOAD_MAX];
+static size_t app_channel_sizes[RKTTRANSFER_TEST_RX_CHANNELS_CNT];
+#endif
+
 //-----------------------------------------------------------------------------
 // Application emulation
 //-----------------------------------------------------------------------------
 static uint8_t app_buffer[RKTTRANSFER_TEST_PAYLOAD_MAX];
 static size_t app_buffer_idx = 0;
+static const uint8_t* app_tx_done_payload_p = NULL;
+static size_t app_tx_done_cnt = 0;
+static const pkttransfer_seg_t* app_txv_done_segs_p = NULL;
+static size_t app_txv_done_cnt = 0;
+static const uint8_t* app_rx_payload_p = NULL;
+static uint8_t* app_rx_loan_buf_p = NULL;
+
+//-----------------------------------------------------------------------------
+// Loaned RX buffers
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_TEST_RX_POOL_CNT (2)
+#define RKTTRANSFER_TEST_RX_POOL_BUF_SIZE (RKTTRANSFER_TEST_PAYLOAD_MAX + PKTTRANSFER_FRAME_CRC_SIZE)
+static uint8_t rx_pool[RKTTRANSFER_TEST_RX_POOL_CNT * RKTTRANSFER_TEST_RX_POOL_BUF_SIZE];
+
+//-----------------------------------------------------------------------------
+// Deferred delivery ring
+//-----------------------------------------------------------------------------
+#define RKTTRANSFER_TEST_RX_SLOTS_CNT (4)
+static pkttransfer_rx_slot_t rx_slots[RKTTRANSFER_TEST_RX_SLOTS_CNT];
+static uint8_t rx_slots_pool[RKTTRANSFER_TEST_RX_SLOTS_CNT * RKTTRANSFER_TEST_RX_POOL_BUF_SIZE];
 
 //==================================================================================================
 //======================================== PUBLIC DATA =============================================
@@ -187,6 +328,45 @@ static void pkttransfer_test_app_pkt_cb(const void * app_p, const uint8_t* paylo
     for (size_t i = 0; i < size; i++) {
         app_buffer[app_buffer_idx++] = payload_p[i];
     }
+    app_rx_payload_p = payload_p;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static uint8_t* pkttransfer_test_app_rx_buf_get_cb(const void * app_p)
+{
+    assert(app_p == NULL);
+
+    uint8_t* buf_p = app_rx_loan_buf_p;
+    app_rx_loan_buf_p = NULL;
+    return buf_p;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_app_tx_done_cb(const void * app_p, const uint8_t* payload_p, size_t size)
+{
+    assert(app_p == NULL);
+    assert(payload_p != NULL);
+    assert(size != 0);
+
+    app_tx_done_payload_p = payload_p;
+    app_tx_done_cnt++;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_app_txv_done_cb(const void * app_p, const pkttransfer_seg_t* segs_p, size_t segs_cnt)
+{
+    assert(app_p == NULL);
+    assert(segs_p != NULL);
+    assert(segs_cnt != 0);
+
+    app_txv_done_segs_p = segs_p;
+    app_txv_done_cnt++;
 }
 
 //-----------------------------------------------------------------------------
@@ -195,7 +375,11 @@ static void pkttransfer_test_app_pkt_cb(const void * app_p, const uint8_t* paylo
 static bool pkttransfer_test_hw_tx_is_avail_cb(const void * hw_p)
 {
     assert(hw_p == NULL);
+#if (defined(PKTTRANSFER_OVER_CAN))
+    return (hardware_can_tx_mailboxes != 0);
+#else
     return true;
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -209,6 +393,12 @@ static bool pkttransfer_test_hw_rx_is_ready_cb(const void * hw_p)
         return true;
     }
 
+#if (defined(PKTTRANSFER_OVER_CAN))
+    if (hardware_can_rx_msgs_idx < hardware_can_rx_msgs_cnt) {
+        return true;
+    }
+#endif
+
     return false;
 }
 
@@ -240,6 +430,70 @@ static uint8_t pkttransfer_test_hw_uart_rx_cb(const void * hw_p)
     return byte;
 }
 
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_hw_uart_tx_dma_start_cb(const void * hw_p, const uint8_t* data_p, size_t size)
+{
+    assert(hw_p == NULL);
+    assert(hardware_dma_chunk_p == NULL);
+    assert((size != 0) && (size <= RKTTRANSFER_TEST_DMA_CHUNK_SIZE));
+    assert((data_p == &dma_buf[0]) || (data_p == &dma_buf[RKTTRANSFER_TEST_DMA_CHUNK_SIZE]));
+
+    hardware_dma_chunk_p = data_p;
+    hardware_dma_chunk_size = size;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_hw_uart_tx_kick_cb(const void * hw_p)
+{
+    assert(hw_p == NULL);
+    hardware_tx_kick_cnt++;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static bool pkttransfer_test_hw_port_tx_is_avail_cb(const void * hw_p)
+{
+    pkttransfer_test_port_t* port_p = &hardware_ports[(const pkttransfer_test_port_t*)hw_p - hardware_ports];
+    port_p->calls_cnt++;
+    port_p->tx_calls_cnt++;
+    return (port_p->tx_is_busy == false);
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static bool pkttransfer_test_hw_port_rx_is_ready_cb(const void * hw_p)
+{
+    pkttransfer_test_port_t* port_p = &hardware_ports[(const pkttransfer_test_port_t*)hw_p - hardware_ports];
+    port_p->calls_cnt++;
+    return (port_p->rx_idx < port_p->rx_size);
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_hw_port_tx_cb(const void * hw_p, uint8_t byte)
+{
+    pkttransfer_test_port_t* port_p = &hardware_ports[(const pkttransfer_test_port_t*)hw_p - hardware_ports];
+    assert(port_p->tx_idx < RKTTRANSFER_TEST_FRAME_MAX);
+    port_p->tx_buf[port_p->tx_idx++] = byte;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static uint8_t pkttransfer_test_hw_port_rx_cb(const void * hw_p)
+{
+    pkttransfer_test_port_t* port_p = &hardware_ports[(const pkttransfer_test_port_t*)hw_p - hardware_ports];
+    assert(port_p->rx_idx < port_p->rx_size);
+    return port_p->rx_buf[port_p->rx_idx++];
+}
+
 #elif (defined(PKTTRANSFER_OVER_CAN))
 
 //-----------------------------------------------------------------------------
@@ -251,7 +505,15 @@ static void pkttransfer_test_hw_can_tx_cb(const void * hw_p, const uint8_t* data
     assert(data_p != NULL);
     assert(size != 0);
     assert(can_id_tx == RKTTRANSFER_TEST_CAN_ID_TX);
-    assert(size <= PKTTRANSFER_CAN_MGS_SIZE);
+    assert(size <= hardware_can_msg_size);
+    assert((size <= PKTTRANSFER_CAN_MGS_SIZE) || (size == 12) || (size == 16) || (size == 20) ||
+           (size == 24) || (size == 32) || (size == 48) || (size == 64));
+
+    hardware_can_msg_cnt++;
+    if (hardware_can_tx_mailboxes != SIZE_MAX) {
+        assert(hardware_can_tx_mailboxes != 0);
+        hardware_can_tx_mailboxes--;
+    }
 
     for (size_t i = 0; i < size; i++) {
         hardware_tx_buffer[hardware_tx_buffer_idx++] = data_p[i];
@@ -269,17 +531,162 @@ static size_t pkttransfer_test_hw_can_rx_cb(const void * hw_p, uint8_t* data_out
     assert(hardware_rx_buffer_size != 0);
     assert(hardware_rx_buffer_idx < hardware_rx_buffer_size);
 
-    *data_out_p = hardware_rx_buffer[hardware_rx_buffer_idx++];
+    // Full CAN messages, the last one can be shorter
+    size_t size = hardware_rx_buffer_size - hardware_rx_buffer_idx;
+    if (size > hardware_can_msg_size) {
+        size = hardware_can_msg_size;
+    }
+
+    memcpy(data_out_p, &hardware_rx_buffer[hardware_rx_buffer_idx], size);
+    hardware_rx_buffer_idx += size;
 
     if (hardware_rx_buffer_idx == hardware_rx_buffer_size) {
         hardware_rx_buffer_size = 0;
     }
 
-    return 1;
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static size_t pkttransfer_test_hw_can_rx_any_cb(const void * hw_p, uint8_t* data_out_p, uint32_t* can_id_out_p)
+{
+    assert(hw_p == NULL);
+    assert((data_out_p != NULL) && (can_id_out_p != NULL));
+    assert(hardware_can_rx_msgs_idx < hardware_can_rx_msgs_cnt);
+
+    const pkttransfer_test_can_msg_t* msg_p = &hardware_can_rx_msgs[hardware_can_rx_msgs_idx++];
+    memcpy(data_out_p, msg_p->data, msg_p->size);
+    *can_id_out_p = msg_p->can_id;
+
+    return msg_p->size;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_hw_can_tx_loop_cb(const void * hw_p, const uint8_t* data_p, size_t size, uint32_t can_id_tx)
+{
+    assert(hw_p == NULL);
+    assert((data_p != NULL) && (size != 0) && (size <= hardware_can_msg_size));
+
+    // ISO-TP flow control frames and data frames
+    if ((data_p[0] >> 4) == 0x3) {
+        assert(can_id_tx == RKTTRANSFER_TEST_CAN_ID_FC);
+        hardware_can_fc_cnt++;
+        hardware_can_fc_status = data_p[0] & 0x0FU;
+    }
+    else {
+        assert(can_id_tx == RKTTRANSFER_TEST_CAN_ID_TX);
+        hardware_can_msg_cnt++;
+    }
+
+    if (hardware_can_loopback) {
+        assert(hardware_can_rx_msgs_cnt < RKTTRANSFER_TEST_CAN_RX_MSGS_MAX);
+        pkttransfer_test_can_msg_t* msg_p = &hardware_can_rx_msgs[hardware_can_rx_msgs_cnt++];
+        msg_p->can_id = can_id_tx;
+        msg_p->size = size;
+        memcpy(msg_p->data, data_p, size);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static size_t pkttransfer_test_hw_can_rx_loop_cb(const void * hw_p, uint8_t* data_out_p, uint32_t can_id_rx)
+{
+    assert(hw_p == NULL);
+    assert(data_out_p != NULL);
+    assert(can_id_rx == RKTTRANSFER_TEST_CAN_ID_RX);
+    assert(hardware_can_rx_msgs_idx < hardware_can_rx_msgs_cnt);
+
+    // Loopback - messages of all IDs are received
+    const pkttransfer_test_can_msg_t* msg_p = &hardware_can_rx_msgs[hardware_can_rx_msgs_idx++];
+    memcpy(data_out_p, msg_p->data, msg_p->size);
+    size_t size = msg_p->size;
+
+    if (hardware_can_rx_msgs_idx == hardware_can_rx_msgs_cnt) {
+        hardware_can_rx_msgs_idx = 0;
+        hardware_can_rx_msgs_cnt = 0;
+    }
+
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// Test callback
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_app_channel_pkt_cb(const void * app_p, uint32_t can_id_rx, const uint8_t* payload_p, size_t size)
+{
+    assert(app_p == NULL);
+    assert((payload_p != NULL) && (size != 0));
+
+    for (size_t i = 0; i < RKTTRANSFER_TEST_RX_CHANNELS_CNT; i++) {
+        if (pkttransfer_test_rx_channel_ids[i] == can_id_rx) {
+            assert(app_channel_sizes[i] == 0);
+            memcpy(app_channel_buffers[i], payload_p, size);
+            app_channel_sizes[i] = size;
+            return;
+        }
+    }
+
+    assert(false);
 }
 
 #endif
 
+//-----------------------------------------------------------------------------
+// Reference bit-by-bit CRC-16-CCITT to cross-check driver's CRC kernel
+//-----------------------------------------------------------------------------
+static uint16_t pkttransfer_test_crc16_reference(const uint8_t* data_p, size_t size)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (size_t byte_cnt = 0; byte_cnt < size; byte_cnt++) {
+        crc ^= data_p[byte_cnt];
+        for (size_t i = 0; i < 8; ++i) {
+            crc = (crc & 0x0001) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+        }
+    }
+
+    return (crc ^ 0xFFFF);
+}
+
+//-----------------------------------------------------------------------------
+// Prepare pseudo-random payload with delimiters and escape symbols (one of 'density' bytes)
+// and expected frame with default CRC16
+//
+// Returns - size of frame
+//-----------------------------------------------------------------------------
+static size_t pkttransfer_test_prepare_long_packet(uint32_t* seed_p, uint32_t density, uint8_t* payload_p, size_t payload_size, uint8_t* frame_p)
+{
+    for (size_t i = 0; i < payload_size; i++) {
+        *seed_p = *seed_p * 1103515245 + 12345;
+        payload_p[i] = (uint8_t)(*seed_p >> 16);
+        if ((*seed_p >> 8) % density == 0) {
+            payload_p[i] = (*seed_p & 0x100) ? 0x7E : 0x7D;
+        }
+    }
+
+    size_t frame_size = 0;
+    uint16_t crc = pkttransfer_crc16(payload_p, payload_size);
+    frame_p[frame_size++] = 0x7E;
+    for (size_t i = 0; i < payload_size + 2; i++) {
+        uint8_t byte = (i < payload_size) ? payload_p[i] : (i == payload_size) ? (uint8_t)(crc & 0xFF) : (uint8_t)(crc >> 8);
+        if ((byte == 0x7E) || (byte == 0x7D)) {
+            frame_p[frame_size++] = 0x7D;
+            frame_p[frame_size++] = byte ^ 0x20;
+        }
+        else {
+            frame_p[frame_size++] = byte;
+        }
+    }
+    frame_p[frame_size++] = 0x7E;
+
+    return frame_size;
+}
+
 //==================================================================================================
 //==================================== TEST FUNCTIONS DEFINITIONS ==================================
 //==================================================================================================
@@ -289,6 +696,22 @@ static size_t pkttransfer_test_hw_can_rx_cb(const void * hw_p, uint8_t* data_out
 static void pkttransfer_test_crc(void)
 {
     assert(0x906E == pkttransfer_crc16(pkttransfer_test_crc_data, RKTTRANSFER_TEST_CRC_DATA_SIZE));
+
+    // Cross-check kernel with reference for all sizes and misalignments
+    uint32_t seed = 1;
+    for (size_t i = 0; i < sizeof(pkttransfer_test_crc_check_data); i++) {
+        seed = seed * 1103515245 + 12345;
+        pkttransfer_test_crc_check_data[i] = (uint8_t)(seed >> 16);
+    }
+
+    for (size_t offset = 0; offset < RKTTRANSFER_TEST_CRC_CHECK_OFFSET_MAX; offset++) {
+        for (size_t size = 0; size <= RKTTRANSFER_TEST_CRC_CHECK_SIZE_MAX; size++) {
+            const uint8_t* data_p = &pkttransfer_test_crc_check_data[offset];
+            assert(pkttransfer_test_crc16_reference(data_p, size) == pkttransfer_crc16(data_p, size));
+        }
+    }
+
+    assert(RKTTRANSFER_TEST_CRC32C_CHECK == pkttransfer_crc32c(pkttransfer_test_crc_data, RKTTRANSFER_TEST_CRC_DATA_SIZE));
 }
 
 //-----------------------------------------------------------------------------
@@ -374,8 +797,14 @@ static void pkttransfer_test_send(void)
     #endif
         assert(res == PKTTRANSFER_ERR_OK);
 
-        // Get state
-        assert(pkttransfer_test_inst_p->state.tx_size == payload_size + PKTTRANSFER_FRAME_CRC_SIZE);
+        // Get state - packet is queued, sending is started by task
+        assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == 0);
+    #if (defined(PKTTRANSFER_OVER_UART))
+        assert(pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size) == PKTTRANSFER_ERR_TX_OVF);
+    #elif (defined(PKTTRANSFER_OVER_CAN))
+        assert(pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX) == PKTTRANSFER_ERR_TX_OVF);
+    #endif
+        assert(pkttransfer_test_inst_p->state.tx_size == 0);
         assert(pkttransfer_test_inst_p->state.sent_size == 0);
         assert(pkttransfer_test_inst_p->state.tx_state == PKTTRANSFER_STATE_DELIMITER);
 
@@ -444,22 +873,1497 @@ static void pkttransfer_test_receive(void)
         assert(pkttransfer_test_inst_p->state.rx_state == PKTTRANSFER_STATE_DELIMITER);
     }
 
+    // Receive all test packets with corrupted CRC
+    for (size_t pkt_number = 0; pkt_number < RKTTRANSFER_TEST_TABLE_SIZE; pkt_number++) {
+
+        uint8_t* frame = pkttransfer_test_packets_table[pkt_number].frame;
+        size_t frame_size = pkttransfer_test_packets_table[pkt_number].frame_size;
+
+        // Emulate packet receiving with the last CRC byte changed
+        memcpy(hardware_rx_buffer, frame, frame_size);
+        hardware_rx_buffer[frame_size - 2] ^= 0x01;
+        hardware_rx_buffer_idx = 0;
+        hardware_rx_buffer_size = frame_size;
+        app_buffer_idx = 0;
+
+        // Process packet
+        for (size_t i = 0; i < 2 * frame_size; i++) {
+            pkttransfer_task(pkttransfer_test_inst_p);
+        }
+        assert(app_buffer_idx == 0);
+        assert(pkttransfer_test_inst_p->state.received_packets_cnt == RKTTRANSFER_TEST_TABLE_SIZE);
+        assert(pkttransfer_test_inst_p->state.rx_state == PKTTRANSFER_STATE_DELIMITER);
+    }
+
     // Deinit instance
     pkttransfer_deinit(pkttransfer_test_inst_p);
     assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
 }
 
-//==================================================================================================
-//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
-//==================================================================================================
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_task_halves(void)
+{
+    // Transmitting and receiving halves of state start on their own cache lines
+    assert(_Alignof(pkttransfer_t) >= PKTTRANSFER_CACHELINE_SIZE);
+    assert(offsetof(pkttransfer_state_t, tx_state) % PKTTRANSFER_CACHELINE_SIZE == 0);
+    assert(offsetof(pkttransfer_state_t, rx_state) % PKTTRANSFER_CACHELINE_SIZE == 0);
+    assert(offsetof(pkttransfer_state_t, crc_size) % PKTTRANSFER_CACHELINE_SIZE == 0);
+    assert(offsetof(pkttransfer_state_t, sent_packets_cnt) < offsetof(pkttransfer_state_t, rx_state));
+
+    // Fields changed by application on poll and release don't share cache lines with receiving half
+    assert(offsetof(pkttransfer_state_t, rx_pool_free) % PKTTRANSFER_CACHELINE_SIZE == 0);
+    assert(offsetof(pkttransfer_state_t, rx_no_buf_cnt) < offsetof(pkttransfer_state_t, rx_pool_free));
+    assert(offsetof(pkttransfer_state_t, rx_slots_tail) > offsetof(pkttransfer_state_t, rx_pool_free));
+    assert(offsetof(pkttransfer_state_t, rx_slots_poll) > offsetof(pkttransfer_state_t, rx_pool_free));
+    assert(offsetof(pkttransfer_state_t, rx_slots_poll) < offsetof(pkttransfer_state_t, crc_size));
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+#if (defined(PKTTRANSFER_OVER_CAN))
+    pkttransfer_set_can_id_rx(pkttransfer_test_inst_p, RKTTRANSFER_TEST_CAN_ID_RX);
+#endif
+    pkttransfer_err_t res;
+
+    // One packet to be sent and another one to be received at the same time
+    const pkttransfer_test_packets_table_t* tx_pkt_p = &pkttransfer_test_packets_table[1];
+    const pkttransfer_test_packets_table_t* rx_pkt_p = &pkttransfer_test_packets_table[2];
+
+#if (defined(PKTTRANSFER_OVER_UART))
+    res = pkttransfer_send(pkttransfer_test_inst_p, tx_pkt_p->payload, tx_pkt_p->payload_size);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    res = pkttransfer_send(pkttransfer_test_inst_p, tx_pkt_p->payload, tx_pkt_p->payload_size, RKTTRANSFER_TEST_CAN_ID_TX);
+#endif
+    assert(res == PKTTRANSFER_ERR_OK);
+
+    memcpy(hardware_rx_buffer, rx_pkt_p->frame, rx_pkt_p->frame_size);
+    hardware_rx_buffer_idx = 0;
+    hardware_rx_buffer_size = rx_pkt_p->frame_size;
+    hardware_tx_buffer_idx = 0;
+    app_buffer_idx = 0;
+
+    // Transmitting half doesn't receive
+    for (size_t i = 0; i < 2 * tx_pkt_p->frame_size; i++) {
+        pkttransfer_task_tx(pkttransfer_test_inst_p);
+    }
+    assert(hardware_tx_buffer_idx == tx_pkt_p->frame_size);
+    assert(memcmp(hardware_tx_buffer, tx_pkt_p->frame, tx_pkt_p->frame_size) == 0);
+    assert(pkttransfer_test_inst_p->state.sent_packets_cnt == 1);
+    assert(hardware_rx_buffer_idx == 0);
+    assert(app_buffer_idx == 0);
+
+    // Receiving half doesn't send
+#if (defined(PKTTRANSFER_OVER_UART))
+    res = pkttransfer_send(pkttransfer_test_inst_p, tx_pkt_p->payload, tx_pkt_p->payload_size);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    res = pkttransfer_send(pkttransfer_test_inst_p, tx_pkt_p->payload, tx_pkt_p->payload_size, RKTTRANSFER_TEST_CAN_ID_TX);
+#endif
+    assert(res == PKTTRANSFER_ERR_OK);
+    hardware_tx_buffer_idx = 0;
+    for (size_t i = 0; i < 2 * rx_pkt_p->frame_size; i++) {
+        pkttransfer_task_rx(pkttransfer_test_inst_p);
+    }
+    assert(app_buffer_idx == rx_pkt_p->payload_size);
+    assert(memcmp(app_buffer, rx_pkt_p->payload, rx_pkt_p->payload_size) == 0);
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == 1);
+    assert(hardware_tx_buffer_idx == 0);
+    assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == 0);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
 
 //-----------------------------------------------------------------------------
-// Run all tests on the target platform
 //-----------------------------------------------------------------------------
-void pkttransfer_run_tests(void)
+static void pkttransfer_test_crc_engine(void)
 {
-    pkttransfer_test_crc();
-    pkttransfer_test_init();
-    pkttransfer_test_send();
-    pkttransfer_test_receive();
+    pkttransfer_config_t config_crc32c = config;
+    config_crc32c.crc_itf_p = &pkttransfer_crc32c_itf;
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_crc32c);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+#if (defined(PKTTRANSFER_OVER_CAN))
+    pkttransfer_set_can_id_rx(pkttransfer_test_inst_p, RKTTRANSFER_TEST_CAN_ID_RX);
+#endif
+    pkttransfer_err_t res;
+
+    // Send and receive back all test packets
+    for (size_t pkt_number = 0; pkt_number < RKTTRANSFER_TEST_TABLE_SIZE; pkt_number++) {
+
+        // Test packet from table
+        uint8_t* payload = pkttransfer_test_packets_table[pkt_number].payload;
+        size_t payload_size = pkttransfer_test_packets_table[pkt_number].payload_size;
+        size_t frame_size = pkttransfer_test_packets_table[pkt_number].frame_size;
+
+        // Send packet to driver
+    #if (defined(PKTTRANSFER_OVER_UART))
+        res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size);
+    #elif (defined(PKTTRANSFER_OVER_CAN))
+        res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX);
+    #endif
+        assert(res == PKTTRANSFER_ERR_OK);
+
+        assert(pkttransfer_test_inst_p->state.crc_size == sizeof(uint32_t));
+
+        // Process packet
+        hardware_tx_buffer_idx = 0;
+        for (size_t i = 0; i < 4 * frame_size; i++) {
+            pkttransfer_task(pkttransfer_test_inst_p);
+        }
+        assert(pkttransfer_test_inst_p->state.tx_size == 0);
+
+        // Frame is longer by 2 bytes of CRC at least
+        size_t crc32c_frame_size = hardware_tx_buffer_idx;
+        assert(crc32c_frame_size >= frame_size + 2);
+
+        // Receive sent frame back
+        memcpy(hardware_rx_buffer, hardware_tx_buffer, crc32c_frame_size);
+        hardware_rx_buffer_idx = 0;
+        hardware_rx_buffer_size = crc32c_frame_size;
+        app_buffer_idx = 0;
+
+        for (size_t i = 0; i < 2 * crc32c_frame_size; i++) {
+            pkttransfer_task(pkttransfer_test_inst_p);
+        }
+        assert(app_buffer_idx == payload_size);
+        assert(memcmp(app_buffer, payload, payload_size) == 0);
+        assert(pkttransfer_test_inst_p->state.received_packets_cnt == pkt_number + 1);
+    }
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_send_receive_long(void)
+{
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+#if (defined(PKTTRANSFER_OVER_CAN))
+    pkttransfer_set_can_id_rx(pkttransfer_test_inst_p, RKTTRANSFER_TEST_CAN_ID_RX);
+#endif
+    pkttransfer_err_t res;
+    uint32_t seed = 1;
+    uint32_t received_packets_cnt = 0;
+
+    for (size_t density_idx = 0; density_idx < RKTTRANSFER_TEST_LONG_DENSITIES_NUM; density_idx++) {
+        for (size_t size_idx = 0; size_idx < RKTTRANSFER_TEST_LONG_SIZES_NUM; size_idx++) {
+
+            // Prepare payload with delimiters and escape symbols, prepare expected frame
+            uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+            size_t payload_size = pkttransfer_test_long_sizes[size_idx];
+            uint8_t frame[RKTTRANSFER_TEST_FRAME_MAX];
+            size_t frame_size = pkttransfer_test_prepare_long_packet(&seed, pkttransfer_test_long_densities[density_idx], payload, payload_size, frame);
+
+            // Send packet to driver
+        #if (defined(PKTTRANSFER_OVER_UART))
+            res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size);
+        #elif (defined(PKTTRANSFER_OVER_CAN))
+            res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX);
+        #endif
+            assert(res == PKTTRANSFER_ERR_OK);
+
+            // Process packet
+            hardware_tx_buffer_idx = 0;
+            for (size_t i = 0; i < 2 * frame_size; i++) {
+                pkttransfer_task(pkttransfer_test_inst_p);
+            }
+            assert(hardware_tx_buffer_idx == frame_size);
+            assert(memcmp(hardware_tx_buffer, frame, frame_size) == 0);
+            assert(pkttransfer_test_inst_p->state.tx_size == 0);
+
+            // Receive sent frame back after some bytes between frames
+            hardware_rx_buffer[0] = 0x7D;
+            hardware_rx_buffer[1] = 0x00;
+            hardware_rx_buffer[2] = (uint8_t)seed;
+            memcpy(&hardware_rx_buffer[3], frame, frame_size);
+            hardware_rx_buffer_idx = 0;
+            hardware_rx_buffer_size = 3 + frame_size;
+            app_buffer_idx = 0;
+
+            for (size_t i = 0; i < 2 * frame_size; i++) {
+                pkttransfer_task(pkttransfer_test_inst_p);
+            }
+            assert(app_buffer_idx == payload_size);
+            assert(memcmp(app_buffer, payload, payload_size) == 0);
+            assert(pkttransfer_test_inst_p->state.received_packets_cnt == ++received_packets_cnt);
+
+            // Receive sent frame back in a bulk, split into parts of different sizes
+            app_buffer_idx = 0;
+            for (size_t offset = 0, part_size = 1; offset < frame_size; offset += part_size, part_size = 2 * part_size + 1) {
+                if (part_size > frame_size - offset) {
+                    part_size = frame_size - offset;
+                }
+                pkttransfer_receive_bytes(pkttransfer_test_inst_p, &frame[offset], part_size);
+            }
+            assert(app_buffer_idx == payload_size);
+            assert(memcmp(app_buffer, payload, payload_size) == 0);
+            assert(pkttransfer_test_inst_p->state.received_packets_cnt == ++received_packets_cnt);
+        }
+    }
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+#if (defined(PKTTRANSFER_OVER_UART))
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_send_dma(void)
+{
+    pkttransfer_hw_itf_t hw_itf_dma = hw_itf;
+    hw_itf_dma.tx_dma_start_cb = pkttransfer_test_hw_uart_tx_dma_start_cb;
+    pkttransfer_config_t config_dma = config;
+    config_dma.tx_dma_buf_p = dma_buf;
+    config_dma.tx_dma_chunk_size = RKTTRANSFER_TEST_DMA_CHUNK_SIZE;
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf_dma, &app_itf, &config_dma);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    pkttransfer_err_t res;
+    uint32_t seed = 1;
+
+    for (size_t size_idx = 0; size_idx < RKTTRANSFER_TEST_LONG_SIZES_NUM; size_idx++) {
+
+        // Prepare payload with delimiters and escape symbols, prepare expected frame
+        uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+        size_t payload_size = pkttransfer_test_long_sizes[size_idx];
+        uint8_t frame[RKTTRANSFER_TEST_FRAME_MAX];
+        size_t frame_size = pkttransfer_test_prepare_long_packet(&seed, 7, payload, payload_size, frame);
+
+        res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size);
+        assert(res == PKTTRANSFER_ERR_OK);
+
+        // Process packet, DMA completes every second task call, so the next chunk is filled while the previous one is sent
+        hardware_tx_buffer_idx = 0;
+        for (size_t i = 0; i < 2 * frame_size; i++) {
+            pkttransfer_task(pkttransfer_test_inst_p);
+
+            if (((i & 1) != 0) && (hardware_dma_chunk_p != NULL)) {
+                memcpy(&hardware_tx_buffer[hardware_tx_buffer_idx], hardware_dma_chunk_p, hardware_dma_chunk_size);
+                hardware_tx_buffer_idx += hardware_dma_chunk_size;
+                hardware_dma_chunk_p = NULL;
+                pkttransfer_tx_dma_complete(pkttransfer_test_inst_p);
+            }
+        }
+        assert(hardware_dma_chunk_p == NULL);
+        assert(hardware_tx_buffer_idx == frame_size);
+        assert(memcmp(hardware_tx_buffer, frame, frame_size) == 0);
+        assert(pkttransfer_test_inst_p->state.sent_packets_cnt == size_idx + 1);
+    }
+
+    // Group - instance with both DMA chunks busy isn't visited until DMA completes
+    pkttransfer_t* const group_insts_p[1] = {pkttransfer_test_inst_p};
+    pkttransfer_group_t group;
+    pkttransfer_group_init(&group, group_insts_p, 1, 0);
+    uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+    uint8_t frame[RKTTRANSFER_TEST_FRAME_MAX];
+    size_t frame_size = pkttransfer_test_prepare_long_packet(&seed, 7, payload, RKTTRANSFER_TEST_PAYLOAD_MAX, frame);
+    res = pkttransfer_send(pkttransfer_test_inst_p, payload, RKTTRANSFER_TEST_PAYLOAD_MAX);
+    assert(res == PKTTRANSFER_ERR_OK);
+    hardware_tx_buffer_idx = 0;
+    size_t group_tasks_cnt = 0;
+    for (;;) {
+        while (pkttransfer_group_task(&group) != 0) {
+            group_tasks_cnt++;
+            assert(group_tasks_cnt <= 2 * frame_size);
+        }
+        if (hardware_dma_chunk_p == NULL) {
+            break;
+        }
+        memcpy(&hardware_tx_buffer[hardware_tx_buffer_idx], hardware_dma_chunk_p, hardware_dma_chunk_size);
+        hardware_tx_buffer_idx += hardware_dma_chunk_size;
+        hardware_dma_chunk_p = NULL;
+        pkttransfer_tx_dma_complete(pkttransfer_test_inst_p);
+    }
+    assert(hardware_tx_buffer_idx == frame_size);
+    assert(memcmp(hardware_tx_buffer, frame, frame_size) == 0);
+    assert(group_tasks_cnt <= 2 * ((frame_size + RKTTRANSFER_TEST_DMA_CHUNK_SIZE - 1) / RKTTRANSFER_TEST_DMA_CHUNK_SIZE) + 2);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_receive_dma(void)
+{
+    pkttransfer_config_t config_dma = config;
+    config_dma.rx_dma_buf_p = hardware_dma_rx_buf;
+    config_dma.rx_dma_buf_size = RKTTRANSFER_TEST_DMA_RX_BUF_SIZE;
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_dma);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    uint32_t seed = 1;
+    size_t dma_head = 0;
+
+    for (size_t size_idx = 0; size_idx < RKTTRANSFER_TEST_LONG_SIZES_NUM; size_idx++) {
+
+        // Prepare payload with delimiters and escape symbols, prepare expected frame
+        uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+        size_t payload_size = pkttransfer_test_long_sizes[size_idx];
+        uint8_t frame[RKTTRANSFER_TEST_FRAME_MAX];
+        size_t frame_size = pkttransfer_test_prepare_long_packet(&seed, 7, payload, payload_size, frame);
+
+        // Emulate DMA - write parts of frame into circular buffer, notify driver and call task
+        app_buffer_idx = 0;
+        for (size_t offset = 0, part_size = 1; offset < frame_size; offset += part_size, part_size = (part_size * 3) % RKTTRANSFER_TEST_DMA_RX_PART_MAX + 1) {
+            if (part_size > frame_size - offset) {
+                part_size = frame_size - offset;
+            }
+            for (size_t i = 0; i < part_size; i++) {
+                hardware_dma_rx_buf[dma_head] = frame[offset + i];
+                dma_head = (dma_head + 1) % RKTTRANSFER_TEST_DMA_RX_BUF_SIZE;
+            }
+            pkttransfer_rx_dma_notify(pkttransfer_test_inst_p, (dma_head == 0) ? RKTTRANSFER_TEST_DMA_RX_BUF_SIZE : dma_head);
+            pkttransfer_task(pkttransfer_test_inst_p);
+        }
+
+        assert(app_buffer_idx == payload_size);
+        assert(memcmp(app_buffer, payload, payload_size) == 0);
+        assert(pkttransfer_test_inst_p->state.received_packets_cnt == size_idx + 1);
+    }
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_group(void)
+{
+    static pkttransfer_t insts[RKTTRANSFER_TEST_GROUP_INST_CNT];
+    static uint8_t tx_bufs[RKTTRANSFER_TEST_GROUP_INST_CNT][RKTTRANSFER_TEST_TX_BUF_SIZE];
+    static uint8_t rx_bufs[RKTTRANSFER_TEST_GROUP_INST_CNT][RKTTRANSFER_TEST_RX_BUF_SIZE];
+    pkttransfer_t* const insts_p[RKTTRANSFER_TEST_GROUP_INST_CNT] = {&insts[0], &insts[1], &insts[2]};
+    pkttransfer_group_t group;
+
+    pkttransfer_hw_itf_t hw_itf_port = {
+        .tx_is_avail_cb = pkttransfer_test_hw_port_tx_is_avail_cb,
+        .rx_is_ready_cb = pkttransfer_test_hw_port_rx_is_ready_cb,
+        .tx_cb = pkttransfer_test_hw_port_tx_cb,
+        .rx_cb = pkttransfer_test_hw_port_rx_cb,
+    };
+
+    // Init instances and group (up to two instance tasks per group task)
+    for (size_t i = 0; i < RKTTRANSFER_TEST_GROUP_INST_CNT; i++) {
+        memset(&hardware_ports[i], 0x00, sizeof(pkttransfer_test_port_t));
+        hw_itf_port.hw_p = &hardware_ports[i];
+        pkttransfer_config_t config_port = config;
+        config_port.buf_tx_p = tx_bufs[i];
+        config_port.buf_rx_p = rx_bufs[i];
+        pkttransfer_init(insts_p[i], &hw_itf_port, &app_itf, &config_port);
+        assert(pkttransfer_is_init(insts_p[i]) == true);
+    }
+    pkttransfer_group_init(&group, insts_p, RKTTRANSFER_TEST_GROUP_INST_CNT, 2);
+
+    // All instances are visited once within budget, then idle instances are not visited at all
+    assert(pkttransfer_group_task(&group) == 2);
+    assert(pkttransfer_group_task(&group) == 1);
+    assert(pkttransfer_group_task(&group) == 0);
+    size_t calls_cnt[RKTTRANSFER_TEST_GROUP_INST_CNT];
+    for (size_t i = 0; i < RKTTRANSFER_TEST_GROUP_INST_CNT; i++) {
+        calls_cnt[i] = hardware_ports[i].calls_cnt;
+    }
+    assert(pkttransfer_group_task(&group) == 0);
+    for (size_t i = 0; i < RKTTRANSFER_TEST_GROUP_INST_CNT; i++) {
+        assert(hardware_ports[i].calls_cnt == calls_cnt[i]);
+    }
+
+    // Sent packet - only its instance is visited until the whole frame is sent
+    const pkttransfer_test_packets_table_t* pkt_p = &pkttransfer_test_packets_table[2];
+    assert(pkttransfer_send(insts_p[1], pkt_p->payload, pkt_p->payload_size) == PKTTRANSFER_ERR_OK);
+    while (pkttransfer_group_task(&group) != 0) {
+    }
+    assert((hardware_ports[0].calls_cnt == calls_cnt[0]) && (hardware_ports[2].calls_cnt == calls_cnt[2]));
+    assert(hardware_ports[1].tx_idx == pkt_p->frame_size);
+    assert(memcmp(hardware_ports[1].tx_buf, pkt_p->frame, pkt_p->frame_size) == 0);
+
+    // Received bytes - instance is visited after notification until all bytes are processed
+    memcpy(hardware_ports[2].rx_buf, pkt_p->frame, pkt_p->frame_size);
+    hardware_ports[2].rx_size = pkt_p->frame_size;
+    assert(pkttransfer_group_task(&group) == 0);
+    app_buffer_idx = 0;
+    pkttransfer_rx_notify(insts_p[2]);
+    while (pkttransfer_group_task(&group) != 0) {
+    }
+    assert(hardware_ports[2].rx_idx == pkt_p->frame_size);
+    assert(app_buffer_idx == pkt_p->payload_size);
+    assert(memcmp(app_buffer, pkt_p->payload, pkt_p->payload_size) == 0);
+
+    // Busy hardware - instance isn't visited until it's notified that bytes can be sent
+    hardware_ports[0].tx_idx = 0;
+    hardware_ports[0].tx_is_busy = true;
+    assert(pkttransfer_send(insts_p[0], pkt_p->payload, pkt_p->payload_size) == PKTTRANSFER_ERR_OK);
+    assert(pkttransfer_group_task(&group) == 1);
+    calls_cnt[0] = hardware_ports[0].calls_cnt;
+    assert(pkttransfer_group_task(&group) == 0);
+    assert(hardware_ports[0].calls_cnt == calls_cnt[0]);
+    assert(hardware_ports[0].tx_idx == 0);
+
+    // RX notification of stalled instance runs only its RX half
+    size_t tx_calls_cnt = hardware_ports[0].tx_calls_cnt;
+    pkttransfer_rx_notify(insts_p[0]);
+    assert(pkttransfer_group_task(&group) == 1);
+    assert(pkttransfer_group_task(&group) == 0);
+    assert(hardware_ports[0].tx_calls_cnt == tx_calls_cnt);
+    assert(hardware_ports[0].tx_idx == 0);
+    hardware_ports[0].tx_is_busy = false;
+    pkttransfer_tx_notify(insts_p[0]);
+    while (pkttransfer_group_task(&group) != 0) {
+    }
+    assert(hardware_ports[0].tx_idx == pkt_p->frame_size);
+    assert(memcmp(hardware_ports[0].tx_buf, pkt_p->frame, pkt_p->frame_size) == 0);
+
+    // Packets of all instances - instances are served in turn within budget
+    for (size_t i = 0; i < RKTTRANSFER_TEST_GROUP_INST_CNT; i++) {
+        hardware_ports[i].tx_idx = 0;
+        assert(pkttransfer_send(insts_p[i], pkt_p->payload, pkt_p->payload_size) == PKTTRANSFER_ERR_OK);
+    }
+    size_t visited_cnt;
+    while ((visited_cnt = pkttransfer_group_task(&group)) != 0) {
+        assert(visited_cnt <= 2);
+        size_t tx_idx_min = SIZE_MAX;
+        size_t tx_idx_max = 0;
+        for (size_t i = 0; i < RKTTRANSFER_TEST_GROUP_INST_CNT; i++) {
+            tx_idx_min = (hardware_ports[i].tx_idx < tx_idx_min) ? hardware_ports[i].tx_idx : tx_idx_min;
+            tx_idx_max = (hardware_ports[i].tx_idx > tx_idx_max) ? hardware_ports[i].tx_idx : tx_idx_max;
+        }
+        assert(tx_idx_max - tx_idx_min <= 1);
+    }
+    for (size_t i = 0; i < RKTTRANSFER_TEST_GROUP_INST_CNT; i++) {
+        assert(hardware_ports[i].tx_idx == pkt_p->frame_size);
+        assert(memcmp(hardware_ports[i].tx_buf, pkt_p->frame, pkt_p->frame_size) == 0);
+    }
+
+    // Deinit instances
+    for (size_t i = 0; i < RKTTRANSFER_TEST_GROUP_INST_CNT; i++) {
+        pkttransfer_deinit(insts_p[i]);
+        assert(pkttransfer_is_init(insts_p[i]) == false);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_isr_rings(void)
+{
+    pkttransfer_hw_itf_t hw_itf_isr = hw_itf;
+    hw_itf_isr.tx_kick_cb = pkttransfer_test_hw_uart_tx_kick_cb;
+
+    pkttransfer_config_t config_isr = config;
+    config_isr.isr_rx_ring_p = isr_rx_ring;
+    config_isr.isr_rx_ring_size = RKTTRANSFER_TEST_ISR_RING_SIZE;
+    config_isr.isr_tx_ring_p = isr_tx_ring;
+    config_isr.isr_tx_ring_size = RKTTRANSFER_TEST_ISR_RING_SIZE;
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf_isr, &app_itf, &config_isr);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    uint32_t seed = 1;
+
+    for (size_t size_idx = 0; size_idx < RKTTRANSFER_TEST_LONG_SIZES_NUM; size_idx++) {
+
+        uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+        size_t payload_size = pkttransfer_test_long_sizes[size_idx];
+        uint8_t frame[RKTTRANSFER_TEST_FRAME_MAX];
+        size_t frame_size = pkttransfer_test_prepare_long_packet(&seed, 7, payload, payload_size, frame);
+
+        // Send packet - task fills TX ring, interrupt pulls bytes into FIFO of 5 bytes
+        hardware_tx_buffer_idx = 0;
+        hardware_tx_kick_cnt = 0;
+        assert(pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size) == PKTTRANSFER_ERR_OK);
+        while (hardware_tx_buffer_idx < frame_size) {
+            pkttransfer_task(pkttransfer_test_inst_p);
+            size_t pulled_size;
+            while ((pulled_size = pkttransfer_isr_tx_pull(pkttransfer_test_inst_p, &hardware_tx_buffer[hardware_tx_buffer_idx], 5)) != 0) {
+                hardware_tx_buffer_idx += pulled_size;
+            }
+        }
+        assert(hardware_tx_buffer_idx == frame_size);
+        assert(memcmp(hardware_tx_buffer, frame, frame_size) == 0);
+        assert(hardware_tx_kick_cnt == (frame_size + RKTTRANSFER_TEST_ISR_RING_SIZE - 1) / RKTTRANSFER_TEST_ISR_RING_SIZE);
+
+        // Receive frame - interrupt pushes bytes from FIFO of 7 bytes, task is called after every two interrupts
+        app_buffer_idx = 0;
+        for (size_t offset = 0, isr_cnt = 0; offset < frame_size; isr_cnt++) {
+            size_t part_size = (frame_size - offset < 7) ? (frame_size - offset) : 7;
+            assert(pkttransfer_isr_rx_push(pkttransfer_test_inst_p, &frame[offset], part_size) == part_size);
+            offset += part_size;
+            if ((isr_cnt & 1) || (offset == frame_size)) {
+                pkttransfer_task(pkttransfer_test_inst_p);
+            }
+        }
+        assert(app_buffer_idx == payload_size);
+        assert(memcmp(app_buffer, payload, payload_size) == 0);
+    }
+    assert(atomic_load(&pkttransfer_test_inst_p->state.isr_rx_ovf_cnt) == 0);
+
+    // Overflow of RX ring - bytes which don't fit are dropped and counted
+    uint8_t burst[RKTTRANSFER_TEST_ISR_RING_SIZE + 4] = {0};
+    assert(pkttransfer_isr_rx_push(pkttransfer_test_inst_p, burst, sizeof(burst)) == RKTTRANSFER_TEST_ISR_RING_SIZE);
+    assert(pkttransfer_isr_rx_push(pkttransfer_test_inst_p, burst, 1) == 0);
+    assert(atomic_load(&pkttransfer_test_inst_p->state.isr_rx_ovf_cnt) == 5);
+    pkttransfer_task(pkttransfer_test_inst_p);
+    assert(pkttransfer_isr_rx_push(pkttransfer_test_inst_p, burst, 1) == 1);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+#endif
+
+#if (defined(PKTTRANSFER_OVER_CAN))
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_can_fd(void)
+{
+    static const size_t msg_sizes[] = {12, 20, 64};
+
+    for (size_t msg_size_idx = 0; msg_size_idx < sizeof(msg_sizes) / sizeof(msg_sizes[0]); msg_size_idx++) {
+
+        size_t msg_size = msg_sizes[msg_size_idx];
+        pkttransfer_config_t config_fd = config;
+        config_fd.can_msg_size = msg_size;
+        hardware_can_msg_size = msg_size;
+
+        // Init instance
+        pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_fd);
+        assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+        pkttransfer_set_can_id_rx(pkttransfer_test_inst_p, RKTTRANSFER_TEST_CAN_ID_RX);
+        uint32_t seed = 1;
+
+        for (size_t pkt_number = 0; pkt_number <= RKTTRANSFER_TEST_TABLE_SIZE; pkt_number++) {
+
+            // Test packet from table or long packet
+            uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+            size_t payload_size;
+            uint8_t frame[RKTTRANSFER_TEST_FRAME_MAX];
+            size_t frame_size;
+            if (pkt_number < RKTTRANSFER_TEST_TABLE_SIZE) {
+                payload_size = pkttransfer_test_packets_table[pkt_number].payload_size;
+                memcpy(payload, pkttransfer_test_packets_table[pkt_number].payload, payload_size);
+                frame_size = pkttransfer_test_packets_table[pkt_number].frame_size;
+                memcpy(frame, pkttransfer_test_packets_table[pkt_number].frame, frame_size);
+            }
+            else {
+                payload_size = 300;
+                frame_size = pkttransfer_test_prepare_long_packet(&seed, 1000, payload, payload_size, frame);
+            }
+
+            // Send packet - full messages, the last one is padded up to valid DLC length
+            hardware_tx_buffer_idx = 0;
+            hardware_can_msg_cnt = 0;
+            assert(pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX) == PKTTRANSFER_ERR_OK);
+            for (size_t i = 0; i < frame_size; i++) {
+                pkttransfer_task(pkttransfer_test_inst_p);
+            }
+
+            size_t tail_size = frame_size % msg_size;
+            size_t padded_tail_size = (tail_size <= 8) ? tail_size : (tail_size <= 12) ? 12 : (tail_size <= 16) ? 16 : (tail_size <= 20) ? 20 :
+                                      (tail_size <= 24) ? 24 : (tail_size <= 32) ? 32 : (tail_size <= 48) ? 48 : 64;
+            assert(hardware_can_msg_cnt == (frame_size + msg_size - 1) / msg_size);
+            assert(hardware_tx_buffer_idx == frame_size - tail_size + padded_tail_size);
+            assert(memcmp(hardware_tx_buffer, frame, frame_size) == 0);
+            for (size_t i = frame_size; i < hardware_tx_buffer_idx; i++) {
+                assert(hardware_tx_buffer[i] == PKTTRANSFER_CAN_FD_PADDING_BYTE);
+            }
+
+            // Receive sent messages back - padding is skipped
+            memcpy(hardware_rx_buffer, hardware_tx_buffer, hardware_tx_buffer_idx);
+            hardware_rx_buffer_idx = 0;
+            hardware_rx_buffer_size = hardware_tx_buffer_idx;
+            app_buffer_idx = 0;
+            while (hardware_rx_buffer_size != 0) {
+                pkttransfer_task(pkttransfer_test_inst_p);
+            }
+            assert(app_buffer_idx == payload_size);
+            assert(memcmp(app_buffer, payload, payload_size) == 0);
+        }
+
+        // Deinit instance
+        pkttransfer_deinit(pkttransfer_test_inst_p);
+        assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+    }
+
+    hardware_can_msg_size = PKTTRANSFER_CAN_MGS_SIZE;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_can_msgs_per_task(void)
+{
+    pkttransfer_config_t config_msgs = config;
+    config_msgs.can_tx_msgs_per_task = 3;
+    config_msgs.can_rx_msgs_per_task = 4;
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_msgs);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    pkttransfer_set_can_id_rx(pkttransfer_test_inst_p, RKTTRANSFER_TEST_CAN_ID_RX);
+
+    uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+    uint8_t frame[RKTTRANSFER_TEST_FRAME_MAX];
+    uint32_t seed = 1;
+    size_t frame_size = pkttransfer_test_prepare_long_packet(&seed, 29, payload, RKTTRANSFER_TEST_PAYLOAD_MAX, frame);
+    size_t msgs_num = (frame_size + PKTTRANSFER_CAN_MGS_SIZE - 1) / PKTTRANSFER_CAN_MGS_SIZE;
+
+    // Send - up to 3 messages per call while there are free mailboxes
+    hardware_tx_buffer_idx = 0;
+    hardware_can_msg_cnt = 0;
+    hardware_can_tx_mailboxes = 2;
+    assert(pkttransfer_send(pkttransfer_test_inst_p, payload, RKTTRANSFER_TEST_PAYLOAD_MAX, RKTTRANSFER_TEST_CAN_ID_TX) == PKTTRANSFER_ERR_OK);
+    pkttransfer_task(pkttransfer_test_inst_p);
+    assert(hardware_can_msg_cnt == 2);
+
+    size_t task_cnt = 0;
+    while (hardware_can_msg_cnt < msgs_num) {
+        size_t msg_cnt = hardware_can_msg_cnt;
+        hardware_can_tx_mailboxes = 3;
+        pkttransfer_task(pkttransfer_test_inst_p);
+        assert((hardware_can_msg_cnt - msg_cnt == 3) || (hardware_can_msg_cnt == msgs_num));
+        task_cnt++;
+    }
+    assert(task_cnt == (msgs_num - 2 + 2) / 3);
+    assert(hardware_tx_buffer_idx == frame_size);
+    assert(memcmp(hardware_tx_buffer, frame, frame_size) == 0);
+    hardware_can_tx_mailboxes = SIZE_MAX;
+
+    // Receive - up to 4 messages per call
+    memcpy(hardware_rx_buffer, frame, frame_size);
+    hardware_rx_buffer_idx = 0;
+    hardware_rx_buffer_size = frame_size;
+    app_buffer_idx = 0;
+    pkttransfer_task(pkttransfer_test_inst_p);
+    assert(hardware_rx_buffer_idx == 4 * PKTTRANSFER_CAN_MGS_SIZE);
+    while (hardware_rx_buffer_size != 0) {
+        pkttransfer_task(pkttransfer_test_inst_p);
+    }
+    assert(app_buffer_idx == RKTTRANSFER_TEST_PAYLOAD_MAX);
+    assert(memcmp(app_buffer, payload, RKTTRANSFER_TEST_PAYLOAD_MAX) == 0);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_can_rx_channels(void)
+{
+    pkttransfer_rx_channel_t channels[RKTTRANSFER_TEST_RX_CHANNELS_CNT];
+    static uint8_t channel_bufs[RKTTRANSFER_TEST_RX_CHANNELS_CNT][RKTTRANSFER_TEST_RX_BUF_SIZE];
+    for (size_t i = 0; i < RKTTRANSFER_TEST_RX_CHANNELS_CNT; i++) {
+        channels[i] = (pkttransfer_rx_channel_t){ .can_id = pkttransfer_test_rx_channel_ids[i], .buf_p = channel_bufs[i] };
+    }
+
+    pkttransfer_hw_itf_t hw_itf_channels = hw_itf;
+    hw_itf_channels.rx_cb = NULL;
+    hw_itf_channels.rx_any_cb = pkttransfer_test_hw_can_rx_any_cb;
+
+    pkttransfer_app_itf_t app_itf_channels = app_itf;
+    app_itf_channels.app_channel_pkt_cb = pkttransfer_test_app_channel_pkt_cb;
+
+    pkttransfer_config_t config_channels = config;
+    config_channels.buf_rx_p = NULL;
+    config_channels.rx_channels_p = channels;
+    config_channels.rx_channels_cnt = RKTTRANSFER_TEST_RX_CHANNELS_CNT;
+    config_channels.can_rx_msgs_per_task = RKTTRANSFER_TEST_CAN_RX_MSGS_MAX;
+
+    // Init instance - channels are sorted by ID
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf_channels, &app_itf_channels, &config_channels);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    assert((channels[0].can_id == 10) && (channels[1].can_id == 20) && (channels[2].can_id == 30));
+
+    // Interleave messages of long packets of all channels and messages of unknown ID
+    static uint8_t payloads[RKTTRANSFER_TEST_RX_CHANNELS_CNT][RKTTRANSFER_TEST_PAYLOAD_MAX];
+    static uint8_t frames[RKTTRANSFER_TEST_RX_CHANNELS_CNT][RKTTRANSFER_TEST_FRAME_MAX];
+    const size_t payload_sizes[RKTTRANSFER_TEST_RX_CHANNELS_CNT] = {300, 17, 64};
+    size_t frame_sizes[RKTTRANSFER_TEST_RX_CHANNELS_CNT];
+    size_t frame_offsets[RKTTRANSFER_TEST_RX_CHANNELS_CNT] = {0};
+    uint32_t seed = 1;
+    for (size_t i = 0; i < RKTTRANSFER_TEST_RX_CHANNELS_CNT; i++) {
+        frame_sizes[i] = pkttransfer_test_prepare_long_packet(&seed, 29, payloads[i], payload_sizes[i], frames[i]);
+        app_channel_sizes[i] = 0;
+    }
+
+    hardware_can_rx_msgs_cnt = 0;
+    hardware_can_rx_msgs_idx = 0;
+    size_t unknown_msgs_cnt = 0;
+    bool is_pending = true;
+    while (is_pending) {
+        is_pending = false;
+        for (size_t i = 0; i < RKTTRANSFER_TEST_RX_CHANNELS_CNT; i++) {
+            if (frame_offsets[i] == frame_sizes[i]) {
+                continue;
+            }
+            pkttransfer_test_can_msg_t* msg_p = &hardware_can_rx_msgs[hardware_can_rx_msgs_cnt++];
+            msg_p->can_id = pkttransfer_test_rx_channel_ids[i];
+            msg_p->size = frame_sizes[i] - frame_offsets[i];
+            if (msg_p->size > PKTTRANSFER_CAN_MGS_SIZE) {
+                msg_p->size = PKTTRANSFER_CAN_MGS_SIZE;
+            }
+            memcpy(msg_p->data, &frames[i][frame_offsets[i]], msg_p->size);
+            frame_offsets[i] += msg_p->size;
+            is_pending = true;
+        }
+        if (is_pending) {
+            hardware_can_rx_msgs[hardware_can_rx_msgs_cnt++] = (pkttransfer_test_can_msg_t){ .can_id = RKTTRANSFER_TEST_CAN_ID_UNKNOWN, .size = 1, .data = {0x7E} };
+            unknown_msgs_cnt++;
+        }
+        assert(hardware_can_rx_msgs_cnt <= RKTTRANSFER_TEST_CAN_RX_MSGS_MAX - RKTTRANSFER_TEST_RX_CHANNELS_CNT - 1);
+    }
+
+    // Receive all messages at once - each packet is reassembled in its own channel
+    pkttransfer_task(pkttransfer_test_inst_p);
+    assert(hardware_can_rx_msgs_idx == hardware_can_rx_msgs_cnt);
+    for (size_t i = 0; i < RKTTRANSFER_TEST_RX_CHANNELS_CNT; i++) {
+        assert(app_channel_sizes[i] == payload_sizes[i]);
+        assert(memcmp(app_channel_buffers[i], payloads[i], payload_sizes[i]) == 0);
+        assert(channels[i].received_packets_cnt == 1);
+    }
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == RKTTRANSFER_TEST_RX_CHANNELS_CNT);
+    assert(pkttransfer_test_inst_p->state.rx_unknown_id_cnt == unknown_msgs_cnt);
+
+    hardware_can_rx_msgs_cnt = 0;
+    hardware_can_rx_msgs_idx = 0;
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_can_isotp(void)
+{
+    static const struct {
+        size_t  msg_size;
+        bool    crc;
+        uint8_t block_size;
+    } cases[] = {
+        {PKTTRANSFER_CAN_MGS_SIZE, true, 4},
+        {PKTTRANSFER_CAN_MGS_SIZE, false, 0},
+        {PKTTRANSFER_CAN_FD_MGS_SIZE_MAX, true, 2},
+    };
+    static const size_t payload_sizes[] = {1, 5, 6, 7, 61, 62, 100, RKTTRANSFER_TEST_PAYLOAD_MAX};
+    const size_t payload_sizes_num = sizeof(payload_sizes) / sizeof(payload_sizes[0]);
+
+    pkttransfer_hw_itf_t hw_itf_loop = hw_itf;
+    hw_itf_loop.tx_cb = pkttransfer_test_hw_can_tx_loop_cb;
+    hw_itf_loop.rx_cb = pkttransfer_test_hw_can_rx_loop_cb;
+
+    for (size_t case_idx = 0; case_idx < sizeof(cases) / sizeof(cases[0]); case_idx++) {
+
+        size_t msg_size = cases[case_idx].msg_size;
+        size_t block_size = cases[case_idx].block_size;
+        pkttransfer_config_t config_isotp = config;
+        config_isotp.can_transport = PKTTRANSFER_CAN_TRANSPORT_ISOTP;
+        config_isotp.can_msg_size = msg_size;
+        config_isotp.can_isotp_crc = cases[case_idx].crc;
+        config_isotp.can_isotp_block_size = cases[case_idx].block_size;
+        config_isotp.can_isotp_id_fc = RKTTRANSFER_TEST_CAN_ID_FC;
+        hardware_can_msg_size = msg_size;
+
+        // Init instance
+        pkttransfer_init(pkttransfer_test_inst_p, &hw_itf_loop, &app_itf, &config_isotp);
+        assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+        pkttransfer_set_can_id_rx(pkttransfer_test_inst_p, RKTTRANSFER_TEST_CAN_ID_RX);
+        size_t crc_size = cases[case_idx].crc ? PKTTRANSFER_FRAME_CRC_SIZE : 0;
+
+        // Empty packet without CRC is rejected and doesn't stall TX queue
+        if (crc_size == 0) {
+            size_t free_slots = pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p);
+            const uint8_t empty_payload[1] = {0};
+            const pkttransfer_seg_t empty_seg = { .data_p = empty_payload, .size = 0 };
+            assert(pkttransfer_send(pkttransfer_test_inst_p, empty_payload, 0, RKTTRANSFER_TEST_CAN_ID_TX) == PKTTRANSFER_ERR_TX_OVF);
+            assert(pkttransfer_send_ref(pkttransfer_test_inst_p, empty_payload, 0, RKTTRANSFER_TEST_CAN_ID_TX) == PKTTRANSFER_ERR_TX_OVF);
+            assert(pkttransfer_sendv(pkttransfer_test_inst_p, &empty_seg, 1, RKTTRANSFER_TEST_CAN_ID_TX) == PKTTRANSFER_ERR_TX_OVF);
+            assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == free_slots);
+        }
+
+        for (size_t size_idx = 0; size_idx < payload_sizes_num; size_idx++) {
+
+            // Payload of delimiters and escape symbols only - the worst case for byte-stuffing
+            uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+            size_t payload_size = payload_sizes[size_idx];
+            for (size_t i = 0; i < payload_size; i++) {
+                payload[i] = (i & 1) ? 0x7D : 0x7E;
+            }
+
+            // Send packet - instance receives its own messages and answers its own flow control
+            hardware_can_msg_cnt = 0;
+            hardware_can_fc_cnt = 0;
+            app_buffer_idx = 0;
+            assert(pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX) == PKTTRANSFER_ERR_OK);
+            for (size_t i = 0; (pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == 0) || (hardware_can_rx_msgs_cnt != 0); i++) {
+                assert(i < 4 * RKTTRANSFER_TEST_PAYLOAD_MAX);
+                pkttransfer_task(pkttransfer_test_inst_p);
+            }
+            assert(app_buffer_idx == payload_size);
+            assert(memcmp(app_buffer, payload, payload_size) == 0);
+
+            // Exact number of messages - payload isn't expanded
+            size_t len = payload_size + crc_size;
+            size_t sf_len_max = (msg_size > PKTTRANSFER_CAN_MGS_SIZE) ? (msg_size - 2) : 7;
+            if (len <= sf_len_max) {
+                assert(hardware_can_msg_cnt == 1);
+                assert(hardware_can_fc_cnt == 0);
+            }
+            else {
+                size_t ff_data_size = msg_size - 2;
+                size_t cf_cnt = (len - ff_data_size + (msg_size - 1) - 1) / (msg_size - 1);
+                assert(hardware_can_msg_cnt == 1 + cf_cnt);
+                assert(hardware_can_fc_cnt == 1 + ((block_size == 0) ? 0 : (cf_cnt - 1) / block_size));
+            }
+        }
+        assert(pkttransfer_test_inst_p->state.sent_packets_cnt == payload_sizes_num);
+        assert(pkttransfer_test_inst_p->state.received_packets_cnt == payload_sizes_num);
+        assert(pkttransfer_test_inst_p->state.isotp_rx_err_cnt == 0);
+
+        // Deinit instance
+        pkttransfer_deinit(pkttransfer_test_inst_p);
+        assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+    }
+    hardware_can_msg_size = PKTTRANSFER_CAN_MGS_SIZE;
+
+    // Init instance without loopback
+    pkttransfer_config_t config_isotp = config;
+    config_isotp.can_transport = PKTTRANSFER_CAN_TRANSPORT_ISOTP;
+    config_isotp.can_isotp_id_fc = RKTTRANSFER_TEST_CAN_ID_FC;
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf_loop, &app_itf, &config_isotp);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    pkttransfer_set_can_id_rx(pkttransfer_test_inst_p, RKTTRANSFER_TEST_CAN_ID_RX);
+    hardware_can_loopback = false;
+    hardware_can_msg_cnt = 0;
+    hardware_can_fc_cnt = 0;
+    app_buffer_idx = 0;
+
+    // Sending is paused after first frame until flow control (group doesn't visit instance meanwhile), overflow status aborts packet
+    pkttransfer_t* const group_insts_p[1] = {pkttransfer_test_inst_p};
+    pkttransfer_group_t group;
+    pkttransfer_group_init(&group, group_insts_p, 1, 0);
+    uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX] = {0};
+    assert(pkttransfer_send(pkttransfer_test_inst_p, payload, 100, RKTTRANSFER_TEST_CAN_ID_TX) == PKTTRANSFER_ERR_OK);
+    while (pkttransfer_group_task(&group) != 0) {
+    }
+    assert(hardware_can_msg_cnt == 1);
+    assert(pkttransfer_group_task(&group) == 0);
+    hardware_can_rx_msgs[hardware_can_rx_msgs_cnt++] = (pkttransfer_test_can_msg_t){ .size = 3, .data = {0x32, 0x00, 0x00} };
+    pkttransfer_rx_notify(pkttransfer_test_inst_p);
+    assert(pkttransfer_group_task(&group) == 1);
+    assert(pkttransfer_test_inst_p->state.isotp_tx_abort_cnt == 0);
+
+    // Received flow control is applied by TX half, which is visited in the next call
+    assert(pkttransfer_group_task(&group) == 1);
+    assert(pkttransfer_test_inst_p->state.isotp_tx_abort_cnt == 1);
+    assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == 1);
+    assert(hardware_can_msg_cnt == 1);
+
+    // Lost consecutive frame - packet is dropped
+    hardware_can_rx_msgs[hardware_can_rx_msgs_cnt++] = (pkttransfer_test_can_msg_t){ .size = 8, .data = {0x10, 0x14, 1, 2, 3, 4, 5, 6} };
+    hardware_can_rx_msgs[hardware_can_rx_msgs_cnt++] = (pkttransfer_test_can_msg_t){ .size = 8, .data = {0x22, 7, 8, 9, 10, 11, 12, 13} };
+    pkttransfer_task(pkttransfer_test_inst_p);
+    pkttransfer_task(pkttransfer_test_inst_p);
+    assert(hardware_can_fc_cnt == 1);
+    assert(pkttransfer_test_inst_p->state.isotp_rx_err_cnt == 1);
+
+    // Too long packet - receiver answers with overflow status
+    hardware_can_rx_msgs[hardware_can_rx_msgs_cnt++] = (pkttransfer_test_can_msg_t){ .size = 8, .data = {0x1F, 0xFF, 1, 2, 3, 4, 5, 6} };
+    pkttransfer_task(pkttransfer_test_inst_p);
+    pkttransfer_task(pkttransfer_test_inst_p);
+    assert(hardware_can_fc_cnt == 2);
+    assert(hardware_can_fc_status == 0x2);
+    assert(pkttransfer_test_inst_p->state.isotp_rx_err_cnt == 2);
+    assert(app_buffer_idx == 0);
+
+    hardware_can_loopback = true;
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Prepare default config with TX queue instead of single TX buffer
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_prepare_queue_config(pkttransfer_config_t* config_p)
+{
+    *config_p = config;
+    config_p->buf_tx_p = NULL;
+    config_p->tx_slots_p = tx_slots;
+    config_p->tx_pool_p = tx_pool;
+    config_p->tx_slots_cnt = RKTTRANSFER_TEST_TX_SLOTS_CNT;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_send_queue(void)
+{
+    pkttransfer_config_t config_queue;
+    pkttransfer_test_prepare_queue_config(&config_queue);
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_queue);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+    assert(pkttransfer_get_tx_queue_hwm(pkttransfer_test_inst_p) == 0);
+    pkttransfer_err_t res;
+
+    // Send test packets until queue is full
+    uint8_t frames[RKTTRANSFER_TEST_TABLE_SIZE * RKTTRANSFER_TEST_PAYLOAD_MAX];
+    size_t frames_size = 0;
+    for (size_t pkt_number = 0; pkt_number < RKTTRANSFER_TEST_TABLE_SIZE; pkt_number++) {
+
+        uint8_t* payload = pkttransfer_test_packets_table[pkt_number].payload;
+        size_t payload_size = pkttransfer_test_packets_table[pkt_number].payload_size;
+
+    #if (defined(PKTTRANSFER_OVER_UART))
+        res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size);
+    #elif (defined(PKTTRANSFER_OVER_CAN))
+        res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX);
+    #endif
+
+        if (pkt_number < RKTTRANSFER_TEST_TX_SLOTS_CNT) {
+            assert(res == PKTTRANSFER_ERR_OK);
+            memcpy(&frames[frames_size], pkttransfer_test_packets_table[pkt_number].frame, pkttransfer_test_packets_table[pkt_number].frame_size);
+            frames_size += pkttransfer_test_packets_table[pkt_number].frame_size;
+        }
+        else {
+            assert(res == PKTTRANSFER_ERR_TX_OVF);
+        }
+    }
+    assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == 0);
+    assert(pkttransfer_get_tx_queue_hwm(pkttransfer_test_inst_p) == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+
+    // Process packets - frames are sent back-to-back
+    hardware_tx_buffer_idx = 0;
+    for (size_t i = 0; i < 2 * frames_size; i++) {
+        pkttransfer_task(pkttransfer_test_inst_p);
+    }
+    assert(hardware_tx_buffer_idx == frames_size);
+    assert(memcmp(hardware_tx_buffer, frames, frames_size) == 0);
+    assert(pkttransfer_test_inst_p->state.sent_packets_cnt == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+    assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+    assert(pkttransfer_get_tx_queue_hwm(pkttransfer_test_inst_p) == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_send_queue_wrap(void)
+{
+    pkttransfer_config_t config_queue;
+    pkttransfer_test_prepare_queue_config(&config_queue);
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_queue);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    pkttransfer_err_t res;
+
+    // Move positions of TX queue close to wrap-around, each slot is free at its own position
+    pkttransfer_state_t* state_p = &(pkttransfer_test_inst_p->state);
+    uint32_t wrap = state_p->tx_queue_wrap;
+    assert((wrap % RKTTRANSFER_TEST_TX_SLOTS_CNT) == 0);
+    uint32_t pos = wrap - RKTTRANSFER_TEST_TX_SLOTS_CNT - 1;
+    atomic_store(&state_p->tx_queue_enq, pos);
+    atomic_store(&state_p->tx_queue_deq, pos);
+    for (uint32_t i = 0; i < RKTTRANSFER_TEST_TX_SLOTS_CNT; i++) {
+        uint32_t slot_pos = (pos + i) % wrap;
+        atomic_store(&tx_slots[slot_pos % RKTTRANSFER_TEST_TX_SLOTS_CNT].seq, slot_pos);
+    }
+
+    // Several laps of full queue across wrap-around - frames are sent in the order of sending
+    uint8_t frames[RKTTRANSFER_TEST_TABLE_SIZE * RKTTRANSFER_TEST_PAYLOAD_MAX];
+    for (size_t lap = 0; lap < 3; lap++) {
+
+        size_t frames_size = 0;
+        for (size_t pkt_number = 0; pkt_number <= RKTTRANSFER_TEST_TX_SLOTS_CNT; pkt_number++) {
+
+            size_t idx = (lap + pkt_number) % RKTTRANSFER_TEST_TABLE_SIZE;
+            uint8_t* payload = pkttransfer_test_packets_table[idx].payload;
+            size_t payload_size = pkttransfer_test_packets_table[idx].payload_size;
+
+        #if (defined(PKTTRANSFER_OVER_UART))
+            res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size);
+        #elif (defined(PKTTRANSFER_OVER_CAN))
+            res = pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX);
+        #endif
+
+            if (pkt_number < RKTTRANSFER_TEST_TX_SLOTS_CNT) {
+                assert(res == PKTTRANSFER_ERR_OK);
+                memcpy(&frames[frames_size], pkttransfer_test_packets_table[idx].frame, pkttransfer_test_packets_table[idx].frame_size);
+                frames_size += pkttransfer_test_packets_table[idx].frame_size;
+            }
+            else {
+                assert(res == PKTTRANSFER_ERR_TX_OVF);
+            }
+        }
+        assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == 0);
+
+        // Process packets
+        hardware_tx_buffer_idx = 0;
+        for (size_t i = 0; i < 2 * frames_size; i++) {
+            pkttransfer_task(pkttransfer_test_inst_p);
+        }
+        assert(hardware_tx_buffer_idx == frames_size);
+        assert(memcmp(hardware_tx_buffer, frames, frames_size) == 0);
+        assert(pkttransfer_get_tx_free_slots(pkttransfer_test_inst_p) == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+    }
+    assert(atomic_load(&state_p->tx_queue_deq) < pos);
+    assert(pkttransfer_test_inst_p->state.sent_packets_cnt == 3 * RKTTRANSFER_TEST_TX_SLOTS_CNT);
+    assert(pkttransfer_get_tx_queue_hwm(pkttransfer_test_inst_p) == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_send_ref(void)
+{
+    pkttransfer_config_t config_queue;
+    pkttransfer_test_prepare_queue_config(&config_queue);
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_queue);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    pkttransfer_err_t res;
+
+    // Send test packets - by reference and by copy in turn
+    uint8_t frames[RKTTRANSFER_TEST_TABLE_SIZE * RKTTRANSFER_TEST_PAYLOAD_MAX];
+    size_t frames_size = 0;
+    app_tx_done_payload_p = NULL;
+    app_tx_done_cnt = 0;
+    for (size_t pkt_number = 0; pkt_number < RKTTRANSFER_TEST_TX_SLOTS_CNT; pkt_number++) {
+
+        uint8_t* payload = pkttransfer_test_packets_table[pkt_number].payload;
+        size_t payload_size = pkttransfer_test_packets_table[pkt_number].payload_size;
+
+    #if (defined(PKTTRANSFER_OVER_UART))
+        res = ((pkt_number % 2) == 0) ? pkttransfer_send_ref(pkttransfer_test_inst_p, payload, payload_size) :
+                                        pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size);
+    #elif (defined(PKTTRANSFER_OVER_CAN))
+        res = ((pkt_number % 2) == 0) ? pkttransfer_send_ref(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX) :
+                                        pkttransfer_send(pkttransfer_test_inst_p, payload, payload_size, RKTTRANSFER_TEST_CAN_ID_TX);
+    #endif
+        assert(res == PKTTRANSFER_ERR_OK);
+
+        memcpy(&frames[frames_size], pkttransfer_test_packets_table[pkt_number].frame, pkttransfer_test_packets_table[pkt_number].frame_size);
+        frames_size += pkttransfer_test_packets_table[pkt_number].frame_size;
+    }
+    assert(app_tx_done_cnt == 0);
+
+    // Too long packet isn't referenced
+#if (defined(PKTTRANSFER_OVER_UART))
+    res = pkttransfer_send_ref(pkttransfer_test_inst_p, tx_pool, RKTTRANSFER_TEST_PAYLOAD_MAX + 1);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    res = pkttransfer_send_ref(pkttransfer_test_inst_p, tx_pool, RKTTRANSFER_TEST_PAYLOAD_MAX + 1, RKTTRANSFER_TEST_CAN_ID_TX);
+#endif
+    assert(res == PKTTRANSFER_ERR_TX_OVF);
+
+    // Process packets - buffers are released only after the whole frame is encoded
+    hardware_tx_buffer_idx = 0;
+    for (size_t i = 0; i < 2 * frames_size; i++) {
+        pkttransfer_task(pkttransfer_test_inst_p);
+        if (hardware_tx_buffer_idx < pkttransfer_test_packets_table[0].frame_size - 1) {
+            assert(app_tx_done_cnt == 0);
+        }
+    }
+    assert(hardware_tx_buffer_idx == frames_size);
+    assert(memcmp(hardware_tx_buffer, frames, frames_size) == 0);
+    assert(pkttransfer_test_inst_p->state.sent_packets_cnt == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+    assert(app_tx_done_cnt == (RKTTRANSFER_TEST_TX_SLOTS_CNT + 1) / 2);
+    assert(app_tx_done_payload_p == pkttransfer_test_packets_table[((RKTTRANSFER_TEST_TX_SLOTS_CNT - 1) / 2) * 2].payload);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_sendv(void)
+{
+    pkttransfer_config_t config_queue;
+    pkttransfer_test_prepare_queue_config(&config_queue);
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_queue);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    pkttransfer_err_t res;
+
+    // Send test packets - header of one byte, empty segment and the rest of payload
+    pkttransfer_seg_t segs[RKTTRANSFER_TEST_TX_SLOTS_CNT][3];
+    uint8_t frames[RKTTRANSFER_TEST_TABLE_SIZE * RKTTRANSFER_TEST_PAYLOAD_MAX];
+    size_t frames_size = 0;
+    app_tx_done_cnt = 0;
+    app_txv_done_segs_p = NULL;
+    app_txv_done_cnt = 0;
+    for (size_t pkt_number = 0; pkt_number < RKTTRANSFER_TEST_TX_SLOTS_CNT; pkt_number++) {
+
+        uint8_t* payload = pkttransfer_test_packets_table[pkt_number].payload;
+        size_t payload_size = pkttransfer_test_packets_table[pkt_number].payload_size;
+
+        segs[pkt_number][0] = (pkttransfer_seg_t){ .data_p = payload, .size = 1 };
+        segs[pkt_number][1] = (pkttransfer_seg_t){ .data_p = NULL, .size = 0 };
+        segs[pkt_number][2] = (pkttransfer_seg_t){ .data_p = &payload[1], .size = payload_size - 1 };
+
+    #if (defined(PKTTRANSFER_OVER_UART))
+        res = pkttransfer_sendv(pkttransfer_test_inst_p, segs[pkt_number], 3);
+    #elif (defined(PKTTRANSFER_OVER_CAN))
+        res = pkttransfer_sendv(pkttransfer_test_inst_p, segs[pkt_number], 3, RKTTRANSFER_TEST_CAN_ID_TX);
+    #endif
+        assert(res == PKTTRANSFER_ERR_OK);
+
+        memcpy(&frames[frames_size], pkttransfer_test_packets_table[pkt_number].frame, pkttransfer_test_packets_table[pkt_number].frame_size);
+        frames_size += pkttransfer_test_packets_table[pkt_number].frame_size;
+    }
+
+    // Too long packet isn't sent
+    pkttransfer_seg_t segs_long[2] = {
+        { .data_p = tx_pool, .size = RKTTRANSFER_TEST_PAYLOAD_MAX },
+        { .data_p = tx_pool, .size = 1 },
+    };
+#if (defined(PKTTRANSFER_OVER_UART))
+    res = pkttransfer_sendv(pkttransfer_test_inst_p, segs_long, 2);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    res = pkttransfer_sendv(pkttransfer_test_inst_p, segs_long, 2, RKTTRANSFER_TEST_CAN_ID_TX);
+#endif
+    assert(res == PKTTRANSFER_ERR_TX_OVF);
+
+    // Process packets - frames are the same as for contiguous payloads
+    hardware_tx_buffer_idx = 0;
+    for (size_t i = 0; i < 2 * frames_size; i++) {
+        pkttransfer_task(pkttransfer_test_inst_p);
+    }
+    assert(hardware_tx_buffer_idx == frames_size);
+    assert(memcmp(hardware_tx_buffer, frames, frames_size) == 0);
+    assert(pkttransfer_test_inst_p->state.sent_packets_cnt == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+    assert(app_tx_done_cnt == 0);
+    assert(app_txv_done_cnt == RKTTRANSFER_TEST_TX_SLOTS_CNT);
+    assert(app_txv_done_segs_p == segs[RKTTRANSFER_TEST_TX_SLOTS_CNT - 1]);
+
+    // Packet with empty first segment is completed with its segments array
+    pkttransfer_seg_t segs_empty_first[2] = {
+        { .data_p = NULL, .size = 0 },
+        { .data_p = pkttransfer_test_packets_table[0].payload, .size = pkttransfer_test_packets_table[0].payload_size },
+    };
+#if (defined(PKTTRANSFER_OVER_UART))
+    res = pkttransfer_sendv(pkttransfer_test_inst_p, segs_empty_first, 2);
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    res = pkttransfer_sendv(pkttransfer_test_inst_p, segs_empty_first, 2, RKTTRANSFER_TEST_CAN_ID_TX);
+#endif
+    assert(res == PKTTRANSFER_ERR_OK);
+    hardware_tx_buffer_idx = 0;
+    for (size_t i = 0; i < 2 * pkttransfer_test_packets_table[0].frame_size; i++) {
+        pkttransfer_task(pkttransfer_test_inst_p);
+    }
+    assert(hardware_tx_buffer_idx == pkttransfer_test_packets_table[0].frame_size);
+    assert(memcmp(hardware_tx_buffer, pkttransfer_test_packets_table[0].frame, pkttransfer_test_packets_table[0].frame_size) == 0);
+    assert(app_txv_done_cnt == RKTTRANSFER_TEST_TX_SLOTS_CNT + 1);
+    assert(app_txv_done_segs_p == segs_empty_first);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_receive_loan(void)
+{
+    pkttransfer_config_t config_loan = config;
+    config_loan.buf_rx_p = NULL;
+    config_loan.rx_pool_p = rx_pool;
+    config_loan.rx_pool_cnt = RKTTRANSFER_TEST_RX_POOL_CNT;
+
+    // Init instance with driver's pool of RX buffers
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_loan);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+
+    // Receive packets while there are free buffers - payloads stay valid until release
+    for (size_t pkt_number = 0; pkt_number < RKTTRANSFER_TEST_RX_POOL_CNT; pkt_number++) {
+        app_buffer_idx = 0;
+        app_rx_payload_p = NULL;
+        pkttransfer_receive_bytes(pkttransfer_test_inst_p, pkttransfer_test_packets_table[pkt_number].frame, pkttransfer_test_packets_table[pkt_number].frame_size);
+        assert(app_rx_payload_p == &rx_pool[pkt_number * RKTTRANSFER_TEST_RX_POOL_BUF_SIZE]);
+    }
+    for (size_t pkt_number = 0; pkt_number < RKTTRANSFER_TEST_RX_POOL_CNT; pkt_number++) {
+        assert(memcmp(&rx_pool[pkt_number * RKTTRANSFER_TEST_RX_POOL_BUF_SIZE],
+                      pkttransfer_test_packets_table[pkt_number].payload, pkttransfer_test_packets_table[pkt_number].payload_size) == 0);
+    }
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == RKTTRANSFER_TEST_RX_POOL_CNT);
+
+    // There are no free buffers - packet is dropped
+    size_t pkt_number = RKTTRANSFER_TEST_RX_POOL_CNT;
+    pkttransfer_receive_bytes(pkttransfer_test_inst_p, pkttransfer_test_packets_table[pkt_number].frame, pkttransfer_test_packets_table[pkt_number].frame_size);
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == RKTTRANSFER_TEST_RX_POOL_CNT);
+    assert(pkttransfer_test_inst_p->state.rx_no_buf_cnt == 1);
+
+    // Released buffer is used for the next packet
+    pkttransfer_rx_release(pkttransfer_test_inst_p, &rx_pool[RKTTRANSFER_TEST_RX_POOL_BUF_SIZE]);
+    app_buffer_idx = 0;
+    pkttransfer_receive_bytes(pkttransfer_test_inst_p, pkttransfer_test_packets_table[pkt_number].frame, pkttransfer_test_packets_table[pkt_number].frame_size);
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == RKTTRANSFER_TEST_RX_POOL_CNT + 1);
+    assert(app_rx_payload_p == &rx_pool[RKTTRANSFER_TEST_RX_POOL_BUF_SIZE]);
+    assert(app_buffer_idx == pkttransfer_test_packets_table[pkt_number].payload_size);
+    assert(memcmp(app_buffer, pkttransfer_test_packets_table[pkt_number].payload, app_buffer_idx) == 0);
+    assert(memcmp(rx_pool, pkttransfer_test_packets_table[0].payload, pkttransfer_test_packets_table[0].payload_size) == 0);
+
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+
+    // Init instance with application's provider of RX buffers
+    pkttransfer_app_itf_t app_itf_loan = app_itf;
+    app_itf_loan.app_rx_buf_get_cb = pkttransfer_test_app_rx_buf_get_cb;
+    config_loan.rx_pool_p = NULL;
+    config_loan.rx_pool_cnt = 0;
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf_loan, &config_loan);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+
+    // Provider has no buffer - packet is dropped, then packet is received into provided buffer
+    app_rx_loan_buf_p = NULL;
+    pkttransfer_receive_bytes(pkttransfer_test_inst_p, pkttransfer_test_packets_table[0].frame, pkttransfer_test_packets_table[0].frame_size);
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == 0);
+    assert(pkttransfer_test_inst_p->state.rx_no_buf_cnt == 1);
+
+    app_rx_loan_buf_p = rx_pool;
+    app_buffer_idx = 0;
+    pkttransfer_receive_bytes(pkttransfer_test_inst_p, pkttransfer_test_packets_table[0].frame, pkttransfer_test_packets_table[0].frame_size);
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == 1);
+    assert(app_rx_payload_p == rx_pool);
+    assert(app_buffer_idx == pkttransfer_test_packets_table[0].payload_size);
+    assert(memcmp(app_buffer, pkttransfer_test_packets_table[0].payload, app_buffer_idx) == 0);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_rx_delivery(void)
+{
+    pkttransfer_config_t config_delivery = config;
+    config_delivery.buf_rx_p = NULL;
+    config_delivery.rx_slots_p = rx_slots;
+    config_delivery.rx_slots_pool_p = rx_slots_pool;
+    config_delivery.rx_slots_cnt = RKTTRANSFER_TEST_RX_SLOTS_CNT;
+
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config_delivery);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+    const uint8_t* payload_p;
+    size_t payload_size;
+    assert(pkttransfer_poll_packet(pkttransfer_test_inst_p, &payload_p, &payload_size) == false);
+
+    // Receive more packets than slots without polling - application callback isn't called, the last packet is dropped
+    app_buffer_idx = 0;
+    for (size_t pkt_number = 0; pkt_number <= RKTTRANSFER_TEST_RX_SLOTS_CNT; pkt_number++) {
+        const pkttransfer_test_packets_table_t* pkt_p = &pkttransfer_test_packets_table[pkt_number % RKTTRANSFER_TEST_TABLE_SIZE];
+        pkttransfer_receive_bytes(pkttransfer_test_inst_p, pkt_p->frame, pkt_p->frame_size);
+    }
+    assert(app_buffer_idx == 0);
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == RKTTRANSFER_TEST_RX_SLOTS_CNT);
+    assert(pkttransfer_test_inst_p->state.rx_no_buf_cnt == 1);
+    assert(pkttransfer_get_rx_queue_hwm(pkttransfer_test_inst_p) == RKTTRANSFER_TEST_RX_SLOTS_CNT);
+
+    // Poll two packets before release - payloads stay in slots
+    for (size_t pkt_number = 0; pkt_number < 2; pkt_number++) {
+        assert(pkttransfer_poll_packet(pkttransfer_test_inst_p, &payload_p, &payload_size) == true);
+        assert(payload_p == &rx_slots_pool[pkt_number * RKTTRANSFER_TEST_RX_POOL_BUF_SIZE]);
+        assert(payload_size == pkttransfer_test_packets_table[pkt_number].payload_size);
+        assert(memcmp(payload_p, pkttransfer_test_packets_table[pkt_number].payload, payload_size) == 0);
+    }
+    pkttransfer_rx_release(pkttransfer_test_inst_p, &rx_slots_pool[0]);
+    pkttransfer_rx_release(pkttransfer_test_inst_p, &rx_slots_pool[RKTTRANSFER_TEST_RX_POOL_BUF_SIZE]);
+
+    // Released slots are used for the next packets
+    for (size_t pkt_number = RKTTRANSFER_TEST_RX_SLOTS_CNT; pkt_number < RKTTRANSFER_TEST_RX_SLOTS_CNT + 2; pkt_number++) {
+        const pkttransfer_test_packets_table_t* pkt_p = &pkttransfer_test_packets_table[pkt_number % RKTTRANSFER_TEST_TABLE_SIZE];
+        pkttransfer_receive_bytes(pkttransfer_test_inst_p, pkt_p->frame, pkt_p->frame_size);
+    }
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == RKTTRANSFER_TEST_RX_SLOTS_CNT + 2);
+    assert(pkttransfer_test_inst_p->state.rx_no_buf_cnt == 1);
+
+    // Packets are polled in order of receiving across the end of ring
+    for (size_t pkt_number = 2; pkt_number < RKTTRANSFER_TEST_RX_SLOTS_CNT + 2; pkt_number++) {
+        const pkttransfer_test_packets_table_t* pkt_p = &pkttransfer_test_packets_table[pkt_number % RKTTRANSFER_TEST_TABLE_SIZE];
+        assert(pkttransfer_poll_packet(pkttransfer_test_inst_p, &payload_p, &payload_size) == true);
+        assert(payload_p == &rx_slots_pool[(pkt_number % RKTTRANSFER_TEST_RX_SLOTS_CNT) * RKTTRANSFER_TEST_RX_POOL_BUF_SIZE]);
+        assert(payload_size == pkt_p->payload_size);
+        assert(memcmp(payload_p, pkt_p->payload, payload_size) == 0);
+        pkttransfer_rx_release(pkttransfer_test_inst_p, payload_p);
+    }
+    assert(pkttransfer_poll_packet(pkttransfer_test_inst_p, &payload_p, &payload_size) == false);
+    assert(app_buffer_idx == 0);
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_encode_frame(void)
+{
+    uint8_t frame[RKTTRANSFER_TEST_FRAME_MAX];
+    size_t frame_size;
+
+    // Test packets - the same frames as sent by driver instance
+    for (size_t pkt_number = 0; pkt_number < RKTTRANSFER_TEST_TABLE_SIZE; pkt_number++) {
+
+        uint8_t* payload = pkttransfer_test_packets_table[pkt_number].payload;
+        size_t payload_size = pkttransfer_test_packets_table[pkt_number].payload_size;
+        size_t expected_size = pkttransfer_test_packets_table[pkt_number].frame_size;
+
+        assert(pkttransfer_encoded_size(NULL, payload, payload_size) == expected_size);
+
+        frame_size = pkttransfer_encode_frame(NULL, payload, payload_size, frame, expected_size);
+        assert(frame_size == expected_size);
+        assert(memcmp(frame, pkttransfer_test_packets_table[pkt_number].frame, frame_size) == 0);
+
+        // Too small output buffer
+        assert(pkttransfer_encode_frame(NULL, payload, payload_size, frame, expected_size - 1) == 0);
+    }
+
+    // Long packets with delimiters and escape symbols
+    uint32_t seed = 1;
+    for (size_t density_idx = 0; density_idx < RKTTRANSFER_TEST_LONG_DENSITIES_NUM; density_idx++) {
+        for (size_t size_idx = 0; size_idx < RKTTRANSFER_TEST_LONG_SIZES_NUM; size_idx++) {
+
+            uint8_t payload[RKTTRANSFER_TEST_PAYLOAD_MAX];
+            size_t payload_size = pkttransfer_test_long_sizes[size_idx];
+            uint8_t expected_frame[RKTTRANSFER_TEST_FRAME_MAX];
+            size_t expected_size = pkttransfer_test_prepare_long_packet(&seed, pkttransfer_test_long_densities[density_idx], payload, payload_size, expected_frame);
+
+            assert(pkttransfer_encoded_size(NULL, payload, payload_size) == expected_size);
+
+            frame_size = pkttransfer_encode_frame(NULL, payload, payload_size, frame, sizeof(frame));
+            assert(frame_size == expected_size);
+            assert(memcmp(frame, expected_frame, frame_size) == 0);
+
+            // CRC-32C engine
+            frame_size = pkttransfer_encode_frame(&pkttransfer_crc32c_itf, payload, payload_size, frame, sizeof(frame));
+            assert(frame_size == pkttransfer_encoded_size(&pkttransfer_crc32c_itf, payload, payload_size));
+            assert(pkttransfer_encode_frame(&pkttransfer_crc32c_itf, payload, payload_size, frame, frame_size - 1) == 0);
+        }
+    }
+
+    // Empty payload
+    assert(pkttransfer_encoded_size(NULL, NULL, 0) == 2 + PKTTRANSFER_FRAME_CRC_SIZE);
+    assert(pkttransfer_encode_frame(NULL, NULL, 0, frame, sizeof(frame)) == 2 + PKTTRANSFER_FRAME_CRC_SIZE);
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static void pkttransfer_test_decode_stream(void)
+{
+    // Init instance
+    pkttransfer_init(pkttransfer_test_inst_p, &hw_itf, &app_itf, &config);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == true);
+
+    // Prepare stream of long packets with delimiters and escape symbols
+    static uint8_t payloads[RKTTRANSFER_TEST_LONG_SIZES_NUM][RKTTRANSFER_TEST_PAYLOAD_MAX];
+    static uint8_t stream[RKTTRANSFER_TEST_LONG_SIZES_NUM * RKTTRANSFER_TEST_FRAME_MAX];
+    size_t stream_size = 0;
+    uint32_t seed = 1;
+    for (size_t size_idx = 0; size_idx < RKTTRANSFER_TEST_LONG_SIZES_NUM; size_idx++) {
+        stream_size += pkttransfer_test_prepare_long_packet(&seed, 3, payloads[size_idx], pkttransfer_test_long_sizes[size_idx], &stream[stream_size]);
+    }
+
+    // Decode stream in parts - output is full after three payloads or if one more payload of maximum size can't be stored
+    static uint8_t out[2 * RKTTRANSFER_TEST_PAYLOAD_MAX];
+    pkttransfer_frame_desc_t descs[3];
+    size_t pkt_number = 0;
+    size_t offset = 0;
+    while (offset < stream_size) {
+        size_t part_size = (stream_size - offset < 100) ? (stream_size - offset) : 100;
+        size_t descs_cnt = 0;
+        size_t processed_size = pkttransfer_decode_stream(pkttransfer_test_inst_p, &stream[offset], part_size, out, sizeof(out), descs, 3, &descs_cnt);
+        assert((processed_size != 0) && (processed_size <= part_size));
+        assert(descs_cnt <= 3);
+
+        for (size_t i = 0; i < descs_cnt; i++) {
+            assert(descs[i].size == pkttransfer_test_long_sizes[pkt_number]);
+            assert(memcmp(&out[descs[i].offset], payloads[pkt_number], descs[i].size) == 0);
+            pkt_number++;
+        }
+        offset += processed_size;
+    }
+    assert(pkt_number == RKTTRANSFER_TEST_LONG_SIZES_NUM);
+    assert(pkttransfer_test_inst_p->state.received_packets_cnt == RKTTRANSFER_TEST_LONG_SIZES_NUM);
+
+    // Decode whole stream of test packets at once - application callback isn't called
+    stream_size = 0;
+    for (pkt_number = 0; pkt_number < RKTTRANSFER_TEST_TABLE_SIZE; pkt_number++) {
+        memcpy(&stream[stream_size], pkttransfer_test_packets_table[pkt_number].frame, pkttransfer_test_packets_table[pkt_number].frame_size);
+        stream_size += pkttransfer_test_packets_table[pkt_number].frame_size;
+    }
+    pkttransfer_frame_desc_t descs_table[RKTTRANSFER_TEST_TABLE_SIZE];
+    size_t descs_cnt = 0;
+    app_buffer_idx = 0;
+    assert(pkttransfer_decode_stream(pkttransfer_test_inst_p, stream, stream_size, stream + stream_size, sizeof(stream) - stream_size,
+                                     descs_table, RKTTRANSFER_TEST_TABLE_SIZE, &descs_cnt) == stream_size);
+    assert(descs_cnt == RKTTRANSFER_TEST_TABLE_SIZE);
+    assert(app_buffer_idx == 0);
+    for (pkt_number = 0; pkt_number < RKTTRANSFER_TEST_TABLE_SIZE; pkt_number++) {
+        assert(descs_table[pkt_number].size == pkttransfer_test_packets_table[pkt_number].payload_size);
+        assert(memcmp(&stream[stream_size + descs_table[pkt_number].offset], pkttransfer_test_packets_table[pkt_number].payload, descs_table[pkt_number].size) == 0);
+    }
+
+    // Deinit instance
+    pkttransfer_deinit(pkttransfer_test_inst_p);
+    assert(pkttransfer_is_init(pkttransfer_test_inst_p) == false);
+}
+
+//==================================================================================================
+//================================ PUBLIC FUNCTIONS DEFINITIONS ====================================
+//==================================================================================================
+
+//-----------------------------------------------------------------------------
+// Run all tests on the target platform
+//-----------------------------------------------------------------------------
+void pkttransfer_run_tests(void)
+{
+    pkttransfer_test_crc();
+    pkttransfer_test_init();
+    pkttransfer_test_send();
+    pkttransfer_test_receive();
+    pkttransfer_test_send_receive_long();
+    pkttransfer_test_task_halves();
+    pkttransfer_test_crc_engine();
+    pkttransfer_test_send_queue();
+    pkttransfer_test_send_queue_wrap();
+    pkttransfer_test_send_ref();
+    pkttransfer_test_sendv();
+    pkttransfer_test_receive_loan();
+    pkttransfer_test_rx_delivery();
+    pkttransfer_test_encode_frame();
+    pkttransfer_test_decode_stream();
+#if (defined(PKTTRANSFER_OVER_UART))
+    pkttransfer_test_send_dma();
+    pkttransfer_test_receive_dma();
+    pkttransfer_test_group();
+    pkttransfer_test_isr_rings();
+#elif (defined(PKTTRANSFER_OVER_CAN))
+    pkttransfer_test_can_fd();
+    pkttransfer_test_can_msgs_per_task();
+    pkttransfer_test_can_rx_channels();
+    pkttransfer_test_can_isotp();
+#endif
 }